@@ -0,0 +1,69 @@
+let bytes = require("bytes");
+let tests = require("tests");
+
+let digits = Uint8Array([0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39]); // "123456789"
+
+// fill
+let buf = Uint8Array(8);
+bytes.fill(buf, 0xAA);
+tests.assert_eq(0xAA, buf[0]);
+tests.assert_eq(0xAA, buf[7]);
+bytes.fill(buf.buffer, 0x11, 2, 3);
+tests.assert_eq(0xAA, buf[1]);
+tests.assert_eq(0x11, buf[2]);
+tests.assert_eq(0x11, buf[4]);
+tests.assert_eq(0xAA, buf[5]);
+
+// copy
+tests.assert_eq(4, bytes.copy(buf, digits, 4, 0, 4));
+tests.assert_eq(0x11, buf[3]);
+tests.assert_eq(0x31, buf[4]);
+tests.assert_eq(0x34, buf[7]);
+tests.assert_eq(3, bytes.copy(buf, buf, 0, 4, 3));
+tests.assert_eq(0x33, buf[2]);
+
+// compare
+tests.assert_eq(0, bytes.compare(digits, Uint8Array([0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39])));
+tests.assert_eq(0, bytes.compare(digits, Uint8Array([0x31, 0x32, 0x33, 0x00]), 3));
+tests.assert_eq(1, bytes.compare(digits, Uint8Array([0x31, 0x32, 0x33, 0x00])));
+tests.assert_eq(-1, bytes.compare(Uint8Array([0x31, 0x32]), digits));
+
+// xor
+let data = Uint8Array([0x00, 0xFF, 0x0F, 0xF0, 0x55]);
+bytes.xor(data, Uint8Array([0xFF, 0x0F]));
+tests.assert_eq(0xFF, data[0]);
+tests.assert_eq(0xF0, data[1]);
+tests.assert_eq(0xF0, data[2]);
+tests.assert_eq(0xFF, data[3]);
+tests.assert_eq(0xAA, data[4]);
+bytes.xor(data, Uint8Array([0xFF]), 4);
+tests.assert_eq(0x55, data[4]);
+
+// checksums, standard digits values of "123456789"
+tests.assert_eq(0xF4, bytes.crc8(digits));
+tests.assert_eq(0x29B1, bytes.crc16(digits));
+tests.assert_eq(0xBB3D, bytes.crc16(digits, { poly: 0x8005, init: 0, refIn: true, refOut: true }));
+tests.assert_eq(0xCBF43926, bytes.crc32(digits));
+tests.assert_eq(0xCBF43926, bytes.crc32(digits, bytes.crc32(digits, 0, 0, 4), 4));
+
+// bits
+let bits = Uint8Array([0xB2, 0x78]); // 1011 0010 0111 1000
+tests.assert_eq(1, bytes.getBits(bits, 0, 1));
+tests.assert_eq(0x6, bytes.getBits(bits, 1, 4));
+tests.assert_eq(0x13, bytes.getBits(bits, 4, 7));
+tests.assert_eq(0xB278, bytes.getBits(bits, 0, 16));
+let dst = Uint8Array(2);
+bytes.copyBits(dst, 4, bits, 0, 8);
+tests.assert_eq(0x0B, dst[0]);
+tests.assert_eq(0x20, dst[1]);
+
+// reductions
+let samples = Int16Array([-300, 5, 1200, -7]);
+tests.assert_eq(-300, bytes.min(samples));
+tests.assert_eq(1200, bytes.max(samples));
+tests.assert_eq(898, bytes.sum(samples));
+tests.assert_eq(-7, bytes.min(samples, 1));
+tests.assert_eq(1205, bytes.sum(samples, 1, 2));
+tests.assert_eq(0x39, bytes.max(digits));
+tests.assert_eq(0, bytes.sum(samples, 4));
+tests.assert_eq(undefined, bytes.min(samples, 4));
@@ -0,0 +1,34 @@
+let tests = require("tests");
+
+// objects survive collections that run between instructions and in delays
+let labels = ["first long label", "second long label", "third long label"];
+let kept = [];
+for (let i = 0; i < 300; i++) {
+    let item = { id: i, label: labels[i % 3] + " of an item", parts: [] };
+    for (let j = 0; j < 3; j++) {
+        item.parts.push({ value: i * 3 + j, name: labels[j] + " of a part" });
+    }
+    // garbage that refers to both new and kept objects
+    let scratch = { item: item, copy: labels[i % 3] + " scratch", nested: { kept: kept } };
+    if (i % 10 === 0) {
+        kept.push(item);
+    }
+    if (i % 100 === 0) {
+        delay(1);
+    }
+}
+
+function verify() {
+    tests.assert_eq(30, kept.length);
+    for (let i = 0; i < kept.length; i++) {
+        let item = kept[i];
+        tests.assert_eq(i * 10, item.id);
+        tests.assert_eq(labels[item.id % 3] + " of an item", item.label);
+        tests.assert_eq(item.id * 3 + 2, item.parts[2].value);
+        tests.assert_eq("second long label of a part", item.parts[1].name);
+    }
+}
+
+verify();
+gc(true);
+verify();
@@ -0,0 +1,40 @@
+let tests = require("tests");
+
+// objects past the indexing threshold keep working as before
+let table = {};
+let names = ["a", "bb", "ccc", "dddd", "eeeee", "ffffff", "ggggggg", "hhhhhhhh", "iiiiiiiii",
+    "j", "kk", "lll", "mmmm", "nnnnn", "oooooo", "ppppppp", "qqqqqqqq", "rrrrrrrrr"];
+for (let i = 0; i < names.length; i++) {
+    table[names[i]] = i;
+}
+for (let i = 0; i < names.length; i++) {
+    tests.assert_eq(i, table[names[i]]);
+}
+tests.assert_eq(true, table.missing === undefined);
+tests.assert_eq(true, table.missingLongName === undefined);
+
+// overwriting a property doesn't add another one
+table.rrrrrrrrr = 100;
+table.a = 200;
+tests.assert_eq(100, table.rrrrrrrrr);
+tests.assert_eq(200, table.a);
+
+let count = 0;
+let sum = 0;
+for (let key in table) {
+    count = count + 1;
+    sum = sum + table[key];
+}
+tests.assert_eq(names.length, count);
+// 0 + 1 + ... + 17 with 0 and 17 replaced
+tests.assert_eq(153 - 17 + 200 + 100, sum);
+
+// arrays store their elements as properties too
+let arr = [];
+for (let i = 0; i < 50; i++) {
+    arr.push(i * 2);
+}
+tests.assert_eq(50, arr.length);
+tests.assert_eq(0, arr[0]);
+tests.assert_eq(98, arr[49]);
+tests.assert_eq(true, arr[50] === undefined);
@@ -0,0 +1,44 @@
+let tests = require("tests");
+
+// lookups repeated from the same place see later declarations and new objects
+let counter = 0;
+let shadowed = "global";
+let longVariableName = 1;
+
+function readShadowed() {
+    return shadowed;
+}
+
+for (let i = 0; i < 10; i++) {
+    counter = counter + 1;
+    longVariableName = longVariableName * 2;
+    tests.assert_eq("global", readShadowed());
+    if (i >= 5) {
+        let shadowed = "inner";
+        tests.assert_eq("inner", shadowed);
+        tests.assert_eq("inner", readShadowed());
+    }
+    tests.assert_eq("global", shadowed);
+}
+tests.assert_eq(10, counter);
+tests.assert_eq(1024, longVariableName);
+
+// property reads from one place on different objects
+let objects = [{ value: 1, longPropertyName: "a" }, { value: 2, longPropertyName: "b" }];
+let sum = 0;
+let names = "";
+for (let i = 0; i < 6; i++) {
+    let obj = objects[i % 2];
+    sum = sum + obj.value;
+    names = names + obj.longPropertyName;
+    obj.value = obj.value + 10;
+}
+tests.assert_eq(1 + 2 + 11 + 12 + 21 + 22, sum);
+tests.assert_eq("ababab", names);
+
+// same property name on an object and a string
+let values = [{ length: 5 }, "abc"];
+tests.assert_eq(5, values[0].length);
+for (let i = 0; i < 4; i++) {
+    tests.assert_eq(i % 2 === 0 ? 5 : 3, values[i % 2].length);
+}
@@ -38,6 +38,46 @@ tests.assert_eq(true, file.eof());
 tests.assert_eq(true, file.close());
 tests.assert_eq(false, file.isOpen());
 
+// in-place buffers
+file = storage.openFile(baseDir + "/helloworld", "r", "open_existing");
+tests.assert_eq(true, !!file);
+let bytes = Uint8Array(16);
+tests.assert_eq(5, file.readInto(bytes, 2, 5));
+tests.assert_eq(0, bytes[1]);
+tests.assert_eq(72, bytes[2]); // "H"
+tests.assert_eq(111, bytes[6]); // "o"
+tests.assert_eq(0, bytes[7]);
+tests.assert_eq(8, file.readInto(bytes.buffer, 8));
+tests.assert_eq(33, bytes[15]); // "!"
+tests.assert_eq(0, file.readInto(bytes));
+tests.assert_eq(true, file.close());
+
+file = storage.openFile(baseDir + "/helloworld2", "w", "create_always");
+tests.assert_eq(true, !!file);
+tests.assert_eq(5, file.writeFrom(bytes, 2, 5));
+tests.assert_eq(8, file.writeFrom(bytes.buffer, 8));
+tests.assert_eq(true, file.close());
+
+file = storage.openFile(baseDir + "/helloworld2", "r", "open_existing");
+tests.assert_eq(true, !!file);
+tests.assert_eq("Hello, World!", file.read("ascii", 128));
+tests.assert_eq(true, file.seekAbsolute(0));
+let chunks = 0;
+tests.assert_eq(13, file.forEachChunk(ArrayBuffer(4), function (buf, length) {
+    chunks++;
+    tests.assert_eq(chunks < 4 ? 4 : 1, length);
+}));
+tests.assert_eq(4, chunks);
+tests.assert_eq(true, file.seekAbsolute(0));
+chunks = 0;
+tests.assert_eq(13, file.forEachChunk(bytes, function (buf, length) {
+    chunks++;
+    return false;
+}));
+tests.assert_eq(1, chunks);
+tests.assert_eq(true, file.close());
+tests.assert_eq(true, storage.remove(baseDir + "/helloworld2"));
+
 // byte-level copy
 let src = storage.openFile(baseDir + "/helloworld", "r", "open_existing");
 let dst = storage.openFile(baseDir + "/helloworld2", "rw", "create_always");
@@ -2,6 +2,48 @@
 #include "../test.h" // IWYU pragma: keep
 #include <bit_lib/bit_lib.h>
 
+#define TAG "BitLibTest"
+
+#define BIT_LIB_TEST_DATA_SIZE        (48U)
+#define BIT_LIB_TEST_BENCHMARK_ROUNDS (20000U)
+
+// Bit by bit reference implementations, the word kernels must match them exactly
+
+static uint64_t bit_lib_test_ref_get_bits(const uint8_t* data, size_t position, uint8_t length) {
+    uint64_t value = 0;
+    for(size_t i = 0; i < length; i++) {
+        value = (value << 1) | bit_lib_get_bit(data, position + i);
+    }
+    return value;
+}
+
+static void bit_lib_test_ref_copy_bits(
+    uint8_t* data,
+    size_t position,
+    size_t length,
+    const uint8_t* source,
+    size_t source_position) {
+    for(size_t i = 0; i < length; i++) {
+        bit_lib_set_bit(data, position + i, bit_lib_get_bit(source, source_position + i));
+    }
+}
+
+static void bit_lib_test_ref_reverse_bits(uint8_t* data, size_t position, uint8_t length) {
+    for(size_t i = 0, j = length - 1; i < j; i++, j--) {
+        bool tmp = bit_lib_get_bit(data, position + i);
+        bit_lib_set_bit(data, position + i, bit_lib_get_bit(data, position + j));
+        bit_lib_set_bit(data, position + j, tmp);
+    }
+}
+
+static void bit_lib_test_fill(uint8_t* data, size_t size, uint32_t seed) {
+    // Fixed LCG, so that failures are reproducible
+    for(size_t i = 0; i < size; i++) {
+        seed = seed * 1664525UL + 1013904223UL;
+        data[i] = seed >> 24;
+    }
+}
+
 MU_TEST(test_bit_lib_increment_index) {
     uint32_t index = 0;
 
@@ -708,6 +750,118 @@ MU_TEST(test_bit_lib_bytes_to_num_bcd) {
     mu_assert_int_eq(false, is_bcd_res);
 }
 
+MU_TEST(test_bit_lib_get_bits_reference) {
+    uint8_t data[BIT_LIB_TEST_DATA_SIZE];
+    bit_lib_test_fill(data, sizeof(data), 0x1234);
+
+    for(size_t position = 0; position < 64; position++) {
+        for(uint8_t length = 1; length <= 64; length++) {
+            uint64_t expected = bit_lib_test_ref_get_bits(data, position, length);
+            mu_assert(bit_lib_get_bits_64(data, position, length) == expected, "get_bits_64");
+            if(length <= 32) {
+                mu_assert_int_eq(expected, bit_lib_get_bits_32(data, position, length));
+            }
+            if(length <= 16) {
+                mu_assert_int_eq(expected, bit_lib_get_bits_16(data, position, length));
+            }
+            if(length <= 8) {
+                mu_assert_int_eq(expected, bit_lib_get_bits(data, position, length));
+            }
+        }
+    }
+
+    // Reading the very last bits of a buffer
+    uint8_t tail[5] = {0x00, 0x00, 0x00, 0x01, 0xA5};
+    mu_assert_int_eq(0xA5, bit_lib_get_bits(tail, 32, 8));
+    mu_assert_int_eq(0x1A5, bit_lib_get_bits_16(tail, 23, 9));
+    mu_assert_int_eq(0x000001A5, bit_lib_get_bits_32(tail, 8, 32));
+}
+
+MU_TEST(test_bit_lib_copy_bits_reference) {
+    uint8_t source[BIT_LIB_TEST_DATA_SIZE];
+    uint8_t expected[BIT_LIB_TEST_DATA_SIZE];
+    uint8_t actual[BIT_LIB_TEST_DATA_SIZE];
+    bit_lib_test_fill(source, sizeof(source), 0xCAFE);
+
+    for(size_t position = 0; position < 16; position++) {
+        for(size_t source_position = 0; source_position < 16; source_position++) {
+            for(size_t length = 0; length <= 160; length += 7) {
+                bit_lib_test_fill(expected, sizeof(expected), length);
+                memcpy(actual, expected, sizeof(actual));
+
+                bit_lib_test_ref_copy_bits(expected, position, length, source, source_position);
+                bit_lib_copy_bits(actual, position, length, source, source_position);
+                mu_assert_mem_eq(expected, actual, sizeof(actual));
+            }
+        }
+    }
+}
+
+MU_TEST(test_bit_lib_reverse_bits_reference) {
+    uint8_t expected[BIT_LIB_TEST_DATA_SIZE];
+    uint8_t actual[BIT_LIB_TEST_DATA_SIZE];
+
+    for(size_t position = 0; position < 16; position++) {
+        for(size_t length = 1; length <= 255; length++) {
+            bit_lib_test_fill(expected, sizeof(expected), position + length);
+            memcpy(actual, expected, sizeof(actual));
+
+            bit_lib_test_ref_reverse_bits(expected, position, length);
+            bit_lib_reverse_bits(actual, position, length);
+            mu_assert_mem_eq(expected, actual, sizeof(actual));
+        }
+    }
+}
+
+MU_TEST(test_bit_lib_parity_reference) {
+    uint8_t data[BIT_LIB_TEST_DATA_SIZE];
+    bit_lib_test_fill(data, sizeof(data), 0xBEEF);
+
+    for(size_t i = 0; i < sizeof(data) / sizeof(uint32_t); i++) {
+        uint32_t word = bit_lib_bytes_to_num_be(&data[i * sizeof(uint32_t)], sizeof(uint32_t));
+        bool odd_ones = bit_lib_get_bit_count(word) % 2;
+        mu_assert_int_eq(odd_ones, bit_lib_test_parity_32(word, BitLibParityEven));
+        mu_assert_int_eq(!odd_ones, bit_lib_test_parity_32(word, BitLibParityOdd));
+    }
+
+    for(size_t i = 0; i < 256; i++) {
+        uint8_t byte = i;
+        bit_lib_test_ref_reverse_bits(&byte, 0, 8);
+        mu_assert_int_eq(byte, bit_lib_reverse_8_fast(i));
+    }
+}
+
+MU_TEST(test_bit_lib_benchmark) {
+    uint8_t source[BIT_LIB_TEST_DATA_SIZE];
+    uint8_t expected[BIT_LIB_TEST_DATA_SIZE] = {};
+    uint8_t actual[BIT_LIB_TEST_DATA_SIZE] = {};
+    bit_lib_test_fill(source, sizeof(source), 0x5A5A);
+    uint64_t expected_sum = 0;
+    uint64_t actual_sum = 0;
+
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < BIT_LIB_TEST_BENCHMARK_ROUNDS; i++) {
+        expected_sum += bit_lib_test_ref_get_bits(source, i % 64, 64);
+        bit_lib_test_ref_copy_bits(expected, i % 32, 96, source, i % 16);
+        bit_lib_test_ref_reverse_bits(expected, i % 32, 96);
+    }
+    uint32_t reference_ticks = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(size_t i = 0; i < BIT_LIB_TEST_BENCHMARK_ROUNDS; i++) {
+        actual_sum += bit_lib_get_bits_64(source, i % 64, 64);
+        bit_lib_copy_bits(actual, i % 32, 96, source, i % 16);
+        bit_lib_reverse_bits(actual, i % 32, 96);
+    }
+    uint32_t kernel_ticks = furi_get_tick() - start;
+
+    FURI_LOG_I(
+        TAG, "Bit by bit: %lu ticks, word kernels: %lu ticks", reference_ticks, kernel_ticks);
+
+    mu_assert(actual_sum == expected_sum, "get_bits_64 result differs from reference");
+    mu_assert_mem_eq(expected, actual, sizeof(actual));
+}
+
 MU_TEST_SUITE(test_bit_lib) {
     MU_RUN_TEST(test_bit_lib_increment_index);
     MU_RUN_TEST(test_bit_lib_is_set);
@@ -732,6 +886,11 @@ MU_TEST_SUITE(test_bit_lib) {
     MU_RUN_TEST(test_bit_lib_bytes_to_num_be);
     MU_RUN_TEST(test_bit_lib_bytes_to_num_le);
     MU_RUN_TEST(test_bit_lib_bytes_to_num_bcd);
+    MU_RUN_TEST(test_bit_lib_get_bits_reference);
+    MU_RUN_TEST(test_bit_lib_copy_bits_reference);
+    MU_RUN_TEST(test_bit_lib_reverse_bits_reference);
+    MU_RUN_TEST(test_bit_lib_parity_reference);
+    MU_RUN_TEST(test_bit_lib_benchmark);
 }
 
 int run_minunit_test_bit_lib(void) {
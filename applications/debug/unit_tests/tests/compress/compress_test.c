@@ -338,11 +338,208 @@ static void compress_test_heatshrink_tar() {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define HS_TAR_REPACK_PATH         COMPRESS_UNIT_TESTS_PATH("repack.ths")
+#define HS_TAR_REPACK_EXTRACT_PATH COMPRESS_UNIT_TESTS_PATH("tar_repack_out")
+
+static void compress_test_heatshrink_tar_repack() {
+    Storage* api = furi_record_open(RECORD_STORAGE);
+
+    TarArchive* archive = tar_archive_alloc(api);
+    FuriString* path = furi_string_alloc();
+    FileInfo fileinfo;
+    File* file = storage_file_alloc(api);
+
+    do {
+        storage_simply_remove_recursive(api, HS_TAR_EXTRACT_PATH);
+        storage_simply_remove_recursive(api, HS_TAR_REPACK_EXTRACT_PATH);
+        storage_simply_remove(api, HS_TAR_REPACK_PATH);
+
+        mu_assert(storage_simply_mkdir(api, HS_TAR_EXTRACT_PATH), "Failed to create extract dir");
+        mu_assert(
+            storage_simply_mkdir(api, HS_TAR_REPACK_EXTRACT_PATH),
+            "Failed to create repack extract dir");
+
+        mu_assert(
+            tar_archive_open(archive, HS_TAR_PATH, TarOpenModeReadHeatshrink),
+            "Failed to open heatshrink tar");
+        mu_assert(
+            tar_archive_unpack_to(archive, HS_TAR_EXTRACT_PATH, NULL),
+            "Failed to unpack heatshrink tar");
+        tar_archive_free(archive);
+
+        archive = tar_archive_alloc(api);
+        mu_assert(
+            tar_archive_open(archive, HS_TAR_REPACK_PATH, TarOpenModeWriteHeatshrink),
+            "Failed to create heatshrink tar");
+        mu_assert(
+            tar_archive_add_dir(archive, HS_TAR_EXTRACT_PATH, ""), "Failed to pack directory");
+        mu_assert(tar_archive_finalize(archive), "Failed to finalize heatshrink tar");
+        mu_assert(tar_archive_close(archive), "Failed to flush heatshrink tar");
+        tar_archive_free(archive);
+
+        archive = tar_archive_alloc(api);
+        mu_assert(
+            tar_archive_open(archive, HS_TAR_REPACK_PATH, TarOpenModeReadHeatshrink),
+            "Failed to open repacked heatshrink tar");
+        mu_assert(
+            tar_archive_unpack_to(archive, HS_TAR_REPACK_EXTRACT_PATH, NULL),
+            "Failed to unpack repacked heatshrink tar");
+
+        uint8_t md5_total[16] = {0}, md5_file[16];
+
+        DirWalk* dir_walk = dir_walk_alloc(api);
+        mu_assert(
+            dir_walk_open(dir_walk, HS_TAR_REPACK_EXTRACT_PATH), "Failed to open dirwalk");
+        while(dir_walk_read(dir_walk, path, &fileinfo) == DirWalkOK) {
+            if(file_info_is_dir(&fileinfo)) {
+                continue;
+            }
+            mu_assert(
+                md5_calc_file(file, furi_string_get_cstr(path), md5_file, NULL),
+                "Failed to calc md5");
+
+            for(size_t i = 0; i < 16; i++) {
+                md5_total[i] ^= md5_file[i];
+            }
+        }
+        dir_walk_free(dir_walk);
+
+        // Same contents as the reference tar in compress_test_heatshrink_tar
+        static const unsigned char expected_md5[16] = {
+            0x92,
+            0xed,
+            0x57,
+            0x29,
+            0x78,
+            0x6d,
+            0x0e,
+            0x11,
+            0x76,
+            0xd0,
+            0x47,
+            0xe3,
+            0x5f,
+            0x52,
+            0xd3,
+            0x76};
+        mu_assert(memcmp(md5_total, expected_md5, sizeof(md5_total)) == 0, "MD5 mismatch");
+
+        storage_simply_remove_recursive(api, HS_TAR_EXTRACT_PATH);
+        storage_simply_remove_recursive(api, HS_TAR_REPACK_EXTRACT_PATH);
+        storage_simply_remove(api, HS_TAR_REPACK_PATH);
+    } while(false);
+
+    storage_file_free(file);
+    furi_string_free(path);
+    tar_archive_free(archive);
+    furi_record_close(RECORD_STORAGE);
+}
+
+#define HS_BLOCKS_PATH COMPRESS_UNIT_TESTS_PATH("blocks.hsbk")
+
+static bool hs_blocks_file_seek(void* context, size_t position) {
+    File* file = (File*)context;
+    return storage_file_seek(file, position, true);
+}
+
+static void compress_test_heatshrink_blocks() {
+    static const size_t src_data_size = 10000;
+    static const size_t block_size = 1024;
+    static const size_t read_size_max = 1500;
+
+    Storage* api = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(api);
+
+    CompressConfigHeatshrink config = {
+        .window_sz2 = 9,
+        .lookahead_sz2 = 4,
+        .input_buffer_sz = 256,
+    };
+
+    // Runs of repeated random bytes, so that there is something to compress
+    uint8_t* src_buff = malloc(src_data_size);
+    uint8_t* read_buff = malloc(read_size_max);
+    for(size_t i = 0; i < src_data_size;) {
+        uint8_t value = furi_hal_random_get();
+        size_t run = 1 + furi_hal_random_get() % 16;
+        for(; run && i < src_data_size; run--) {
+            src_buff[i++] = value;
+        }
+    }
+
+    do {
+        storage_simply_remove(api, HS_BLOCKS_PATH);
+
+        mu_assert(
+            storage_file_open(file, HS_BLOCKS_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS),
+            "Failed to open container file");
+
+        CompressBlockEncoder* encoder = compress_block_encoder_alloc(
+            CompressTypeHeatshrink,
+            &config,
+            block_size,
+            hs_unpacker_file_write,
+            hs_blocks_file_seek,
+            file);
+        bool encoded = true;
+        for(size_t offset = 0; offset < src_data_size && encoded;) {
+            size_t chunk_size = MIN(src_data_size - offset, 1 + furi_hal_random_get() % 700);
+            encoded = compress_block_encoder_write(encoder, &src_buff[offset], chunk_size);
+            offset += chunk_size;
+        }
+        encoded = encoded && compress_block_encoder_finish(encoder);
+        compress_block_encoder_free(encoder);
+        mu_assert(encoded, "Block compression failed");
+
+        size_t container_size = storage_file_size(file);
+        CompressBlockDecoder* decoder =
+            compress_block_decoder_alloc(hs_unpacker_file_read, hs_blocks_file_seek, file);
+        // Index doesn't fit in truncated input
+        mu_assert(
+            !compress_block_decoder_open(decoder, container_size - 1),
+            "Truncated container opened");
+        mu_assert(
+            compress_block_decoder_open(decoder, container_size), "Failed to open container");
+        mu_assert(
+            compress_block_decoder_size(decoder) == src_data_size, "Container size mismatch");
+
+        bool matched = true;
+        for(size_t i = 0; i < 100 && matched; i++) {
+            size_t position = furi_hal_random_get() % src_data_size;
+            size_t read_size = 1 + furi_hal_random_get() % read_size_max;
+            read_size = MIN(read_size, src_data_size - position);
+
+            matched = compress_block_decoder_seek(decoder, position) &&
+                      compress_block_decoder_read(decoder, read_buff, read_size) &&
+                      memcmp(read_buff, &src_buff[position], read_size) == 0 &&
+                      compress_block_decoder_tell(decoder) == position + read_size;
+        }
+
+        bool read_past_end = compress_block_decoder_seek(decoder, src_data_size - 1) &&
+                             compress_block_decoder_read(decoder, read_buff, 2);
+
+        compress_block_decoder_free(decoder);
+        storage_file_close(file);
+
+        mu_assert(matched, "Random access read mismatch");
+        mu_assert(!read_past_end, "Read past the end of data succeeded");
+
+        storage_simply_remove(api, HS_BLOCKS_PATH);
+    } while(false);
+
+    free(read_buff);
+    free(src_buff);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(test_compress) {
     MU_RUN_TEST(compress_test_random_comp_decomp);
     MU_RUN_TEST(compress_test_reference_comp_decomp);
     MU_RUN_TEST(compress_test_heatshrink_stream);
     MU_RUN_TEST(compress_test_heatshrink_tar);
+    MU_RUN_TEST(compress_test_heatshrink_tar_repack);
+    MU_RUN_TEST(compress_test_heatshrink_blocks);
 }
 
 int run_minunit_test_compress(void) {
@@ -0,0 +1,128 @@
+#include <furi.h>
+#include <storage/storage.h>
+
+#include "../test.h" // IWYU pragma: keep
+#include "../test_api.h"
+
+#include <loader/firmware_api/firmware_api.h>
+#include <flipper_application/flipper_application.h>
+
+// This plugin loads another copy of itself
+#define FAP_CACHE_TEST_PLUGIN_PATH EXT_PATH("apps_data/unit_tests/plugins/test_fap_cache.fal")
+#define FAP_CACHE_TEST_PATH        EXT_PATH(".fap_cache")
+// Magic, version, key and counts of the prelink cache entry
+#define FAP_CACHE_TEST_HEADER_SIZE (32U)
+
+static void fap_cache_test_entry_path(FuriString* path) {
+    // Same naming as the prelink cache
+    uint32_t name_hash = 2166136261UL;
+    for(const char* c = FAP_CACHE_TEST_PLUGIN_PATH; *c; c++) {
+        name_hash = (name_hash ^ (uint8_t)*c) * 16777619UL;
+    }
+    furi_string_printf(path, "%s/%08lX", FAP_CACHE_TEST_PATH, name_hash);
+}
+
+static bool fap_cache_test_load(Storage* storage) {
+    FlipperApplication* app = flipper_application_alloc(storage, firmware_api_interface);
+    bool success = false;
+
+    do {
+        if(flipper_application_preload(app, FAP_CACHE_TEST_PLUGIN_PATH) !=
+           FlipperApplicationPreloadStatusSuccess)
+            break;
+        if(flipper_application_map_to_memory(app) != FlipperApplicationLoadStatusSuccess) break;
+
+        // Descriptor, its strings and the code behind it are only right when fully relocated
+        const FlipperAppPluginDescriptor* descriptor =
+            flipper_application_plugin_get_descriptor(app);
+        if(!descriptor || strcmp(descriptor->appid, APPID) != 0 ||
+           descriptor->ep_api_version != API_VERSION)
+            break;
+
+        const TestApi* test_api = descriptor->entry_point;
+        success = test_api->get_minunit_run() == 0;
+    } while(false);
+
+    flipper_application_free(app);
+    return success;
+}
+
+static size_t fap_cache_test_read_entry(Storage* storage, const char* path, uint8_t** data) {
+    File* file = storage_file_alloc(storage);
+    size_t size = 0;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        size = storage_file_size(file);
+        *data = malloc(size);
+        if(storage_file_read(file, *data, size) != size) {
+            free(*data);
+            *data = NULL;
+            size = 0;
+        }
+    }
+
+    storage_file_free(file);
+    return size;
+}
+
+MU_TEST(test_fap_cache_hit_miss) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* path = furi_string_alloc();
+    fap_cache_test_entry_path(path);
+
+    // Miss, the entry is recorded
+    storage_simply_remove(storage, furi_string_get_cstr(path));
+    mu_assert(fap_cache_test_load(storage), "load on miss failed");
+
+    uint8_t* recorded = NULL;
+    size_t recorded_size =
+        fap_cache_test_read_entry(storage, furi_string_get_cstr(path), &recorded);
+    mu_assert(recorded_size > FAP_CACHE_TEST_HEADER_SIZE, "entry not recorded");
+
+    // Hit, the entry is left as it is
+    mu_assert(fap_cache_test_load(storage), "load on hit failed");
+
+    uint8_t* applied = NULL;
+    size_t applied_size = fap_cache_test_read_entry(storage, furi_string_get_cstr(path), &applied);
+    mu_assert_int_eq(recorded_size, applied_size);
+    mu_assert_mem_eq(recorded, applied, recorded_size);
+    free(applied);
+
+    // Corrupt entry that still matches the plugin, it is relocated and recorded again
+    File* file = storage_file_alloc(storage);
+    mu_assert(
+        storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_OPEN_EXISTING),
+        "entry open failed");
+    mu_assert(storage_file_seek(file, FAP_CACHE_TEST_HEADER_SIZE, true), "entry seek failed");
+    size_t garbage_size = recorded_size - FAP_CACHE_TEST_HEADER_SIZE;
+    uint8_t* garbage = malloc(garbage_size);
+    memset(garbage, 0xFF, garbage_size);
+    mu_assert_int_eq(garbage_size, storage_file_write(file, garbage, garbage_size));
+    free(garbage);
+    storage_file_free(file);
+
+    mu_assert(fap_cache_test_load(storage), "load on corrupt entry failed");
+
+    uint8_t* rerecorded = NULL;
+    size_t rerecorded_size =
+        fap_cache_test_read_entry(storage, furi_string_get_cstr(path), &rerecorded);
+    mu_assert_int_eq(recorded_size, rerecorded_size);
+    mu_assert_mem_eq(recorded, rerecorded, recorded_size);
+    free(rerecorded);
+
+    free(recorded);
+    storage_simply_remove(storage, furi_string_get_cstr(path));
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(test_fap_cache_suite) {
+    MU_RUN_TEST(test_fap_cache_hit_miss);
+}
+
+int run_minunit_test_fap_cache(void) {
+    MU_RUN_SUITE(test_fap_cache_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_fap_cache)
@@ -457,6 +457,47 @@ static bool test_read_multikey(const char* file_name) {
     return result;
 }
 
+static bool test_read_next(const char* file_name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool result = false;
+    FlipperFormat* file = flipper_format_file_alloc(storage);
+
+    FuriString* key = furi_string_alloc();
+    FuriString* string_value = furi_string_alloc();
+    uint32_t uint32_value;
+
+    do {
+        if(!flipper_format_file_open_existing(file, file_name)) break;
+        if(!flipper_format_read_header(file, string_value, &uint32_value)) break;
+
+        // Comment is skipped
+        if(!flipper_format_read_next_string(file, key, string_value)) break;
+        if(furi_string_cmp_str(key, test_string_key) != 0) break;
+        if(furi_string_cmp_str(string_value, test_string_data) != 0) break;
+
+        if(!flipper_format_read_next_string(file, key, string_value)) break;
+        if(furi_string_cmp_str(key, test_int_key) != 0) break;
+        if(furi_string_cmp_str(string_value, "1234 -6345 7813 0") != 0) break;
+
+        // Keyed reads continue from the current position
+        if(!flipper_format_read_uint32(file, test_uint_key, &uint32_value, 1)) break;
+        if(uint32_value != 1234) break;
+
+        if(!flipper_format_read_next_string(file, key, string_value)) break;
+        if(furi_string_cmp_str(key, test_float_key) != 0) break;
+
+        result = true;
+    } while(false);
+
+    furi_string_free(string_value);
+    furi_string_free(key);
+
+    flipper_format_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
 MU_TEST(flipper_format_write_test) {
     mu_assert(storage_write_string(test_file_linux, test_data_nix), "Write test error [Linux]");
     mu_assert(
@@ -470,6 +511,12 @@ MU_TEST(flipper_format_read_test) {
     mu_assert(test_read(test_file_flipper), "Read test error [Flipper]");
 }
 
+MU_TEST(flipper_format_read_next_test) {
+    mu_assert(test_read_next(test_file_linux), "Read next test error [Linux]");
+    mu_assert(test_read_next(test_file_windows), "Read next test error [Windows]");
+    mu_assert(test_read_next(test_file_flipper), "Read next test error [Flipper]");
+}
+
 MU_TEST(flipper_format_delete_test) {
     mu_assert(test_delete_last_key(test_file_linux), "Cannot delete key [Linux]");
     mu_assert(test_delete_last_key(test_file_windows), "Cannot delete key [Windows]");
@@ -533,6 +580,7 @@ MU_TEST_SUITE(flipper_format) {
     tests_setup();
     MU_RUN_TEST(flipper_format_write_test);
     MU_RUN_TEST(flipper_format_read_test);
+    MU_RUN_TEST(flipper_format_read_next_test);
     MU_RUN_TEST(flipper_format_delete_test);
     MU_RUN_TEST(flipper_format_delete_result_test);
     MU_RUN_TEST(flipper_format_append_test);
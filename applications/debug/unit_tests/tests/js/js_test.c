@@ -75,6 +75,18 @@ MU_TEST(js_test_event_loop) {
 MU_TEST(js_test_storage) {
     js_test_run(JS_SCRIPT_PATH("storage"));
 }
+MU_TEST(js_test_scope) {
+    js_test_run(JS_SCRIPT_PATH("scope"));
+}
+MU_TEST(js_test_object) {
+    js_test_run(JS_SCRIPT_PATH("object"));
+}
+MU_TEST(js_test_gc) {
+    js_test_run(JS_SCRIPT_PATH("gc"));
+}
+MU_TEST(js_test_bytes) {
+    js_test_run(JS_SCRIPT_PATH("bytes"));
+}
 
 static void js_value_test_compatibility_matrix(struct mjs* mjs) {
     static const JsValueType types[] = {
@@ -385,6 +397,10 @@ MU_TEST_SUITE(test_js) {
     MU_RUN_TEST(js_test_math);
     MU_RUN_TEST(js_test_event_loop);
     MU_RUN_TEST(js_test_storage);
+    MU_RUN_TEST(js_test_scope);
+    MU_RUN_TEST(js_test_object);
+    MU_RUN_TEST(js_test_gc);
+    MU_RUN_TEST(js_test_bytes);
 }
 
 int run_minunit_test_js(void) {
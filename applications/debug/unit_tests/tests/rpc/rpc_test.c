@@ -3,6 +3,7 @@
 
 #include <rpc/rpc.h>
 #include <rpc/rpc_i.h>
+#include <rpc/rpc_md5_cache.h>
 #include <storage/storage.h>
 #include <loader/loader.h>
 #include <storage/filesystem_api_defines.h>
@@ -1376,6 +1377,115 @@ MU_TEST(test_storage_md5sum) {
     test_storage_md5sum_run(TEST_DIR "file2.txt", ++command_id, md5sum2, PB_CommandStatus_OK);
 }
 
+#define TEST_MD5_CACHE_DIR    EXT_PATH(".rpc_md5")
+#define TEST_MD5_CACHE_AGE_MS 3500 // Digests of files changed in the last seconds aren't cached
+
+static void test_md5_cache_write(const char* path, const char* data) {
+    Storage* fs_api = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(fs_api);
+
+    furi_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    furi_check(storage_file_write(file, data, strlen(data)) == strlen(data));
+
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void test_md5_cache_check(RpcMd5Cache* cache, const char* path) {
+    char md5sum[MD5SUM_SIZE * 2 + 1] = {0};
+    FuriString* md5 = furi_string_alloc();
+
+    test_storage_calculate_md5sum(path, md5sum, sizeof(md5sum));
+    mu_check(rpc_md5_cache_get(cache, path, md5, NULL));
+    mu_assert_string_eq(md5sum, furi_string_get_cstr(md5));
+
+    furi_string_free(md5);
+}
+
+static size_t test_md5_cache_count_manifests(void) {
+    Storage* fs_api = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(fs_api);
+    FileInfo fileinfo;
+    size_t count = 0;
+
+    if(storage_dir_open(dir, TEST_MD5_CACHE_DIR)) {
+        while(storage_dir_read(dir, &fileinfo, NULL, 0)) {
+            if(!file_info_is_dir(&fileinfo)) count++;
+        }
+    }
+
+    storage_dir_close(dir);
+    storage_file_free(dir);
+    furi_record_close(RECORD_STORAGE);
+    return count;
+}
+
+MU_TEST(test_storage_md5_cache) {
+    Storage* fs_api = furi_record_open(RECORD_STORAGE);
+    RpcMd5Cache* cache;
+
+    test_md5_cache_write(TEST_DIR "cached.txt", "first");
+    test_create_dir(TEST_DIR "cached_dir");
+    test_md5_cache_write(TEST_DIR "cached_dir/file.txt", "data");
+    furi_delay_ms(TEST_MD5_CACHE_AGE_MS);
+
+    // Digests go to the manifests of both directories
+    cache = rpc_md5_cache_alloc(fs_api);
+    test_md5_cache_check(cache, TEST_DIR "cached.txt");
+    test_md5_cache_check(cache, TEST_DIR "cached_dir/file.txt");
+    rpc_md5_cache_free(cache);
+    size_t manifests_count = test_md5_cache_count_manifests();
+    mu_check(manifests_count >= 2);
+
+    // Size changed
+    test_md5_cache_write(TEST_DIR "cached.txt", "second!");
+    cache = rpc_md5_cache_alloc(fs_api);
+    test_md5_cache_check(cache, TEST_DIR "cached.txt");
+    rpc_md5_cache_free(cache);
+
+    // Same size, timestamp changed
+    furi_delay_ms(TEST_MD5_CACHE_AGE_MS);
+    cache = rpc_md5_cache_alloc(fs_api);
+    test_md5_cache_check(cache, TEST_DIR "cached.txt");
+    rpc_md5_cache_free(cache);
+    test_md5_cache_write(TEST_DIR "cached.txt", "third!!");
+    cache = rpc_md5_cache_alloc(fs_api);
+    test_md5_cache_check(cache, TEST_DIR "cached.txt");
+    rpc_md5_cache_free(cache);
+
+    // Manifest of a directory removed behind the cache's back is left for a later prune
+    storage_simply_remove_recursive(fs_api, TEST_DIR "cached_dir");
+    cache = rpc_md5_cache_alloc(fs_api);
+    rpc_md5_cache_free(cache);
+    mu_assert_int_eq(manifests_count, test_md5_cache_count_manifests());
+
+    // Manifest of a directory removed through RPC goes right away
+    test_create_dir(TEST_DIR "cached_dir");
+    test_md5_cache_write(TEST_DIR "cached_dir/file.txt", "data");
+    furi_delay_ms(TEST_MD5_CACHE_AGE_MS);
+    cache = rpc_md5_cache_alloc(fs_api);
+    test_md5_cache_check(cache, TEST_DIR "cached_dir/file.txt");
+    rpc_md5_cache_free(cache);
+    mu_assert_int_eq(manifests_count, test_md5_cache_count_manifests());
+    cache = rpc_md5_cache_alloc(fs_api);
+    rpc_md5_cache_invalidate_dir(cache, TEST_DIR "cached_dir");
+    rpc_md5_cache_free(cache);
+    mu_assert_int_eq(manifests_count - 1, test_md5_cache_count_manifests());
+
+    // Pending entries of a subdirectory are not saved under the removed path
+    test_create_dir(TEST_DIR "cached_dir/sub");
+    test_md5_cache_write(TEST_DIR "cached_dir/sub/file.txt", "data");
+    furi_delay_ms(TEST_MD5_CACHE_AGE_MS);
+    cache = rpc_md5_cache_alloc(fs_api);
+    test_md5_cache_check(cache, TEST_DIR "cached_dir/sub/file.txt");
+    rpc_md5_cache_invalidate_dir(cache, TEST_DIR "cached_dir");
+    rpc_md5_cache_free(cache);
+    mu_assert_int_eq(manifests_count - 1, test_md5_cache_count_manifests());
+
+    furi_record_close(RECORD_STORAGE);
+}
+
 static void test_rpc_storage_rename_run(
     const char* old_path,
     const char* new_path,
@@ -1500,6 +1610,7 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_delete_recursive);
     MU_RUN_TEST(test_storage_mkdir);
     MU_RUN_TEST(test_storage_md5sum);
+    MU_RUN_TEST(test_storage_md5_cache);
     MU_RUN_TEST(test_storage_rename);
 
     DISABLE_TEST(MU_RUN_TEST(test_storage_interrupt_continuous_same_system););
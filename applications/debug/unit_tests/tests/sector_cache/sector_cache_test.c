@@ -0,0 +1,233 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#include <targets/f7/fatfs/sector_cache.h>
+
+#define SECTOR_CACHE_TEST_SECTOR_SIZE  (512U)
+#define SECTOR_CACHE_TEST_DISK_SECTORS (256U)
+
+// RAM-backed block device, sector contents are derived from the sector number
+typedef struct {
+    uint32_t sectors;
+    uint32_t reads;
+    uint32_t sectors_read;
+} SectorCacheTestDisk;
+
+typedef struct {
+    SectorCache* cache;
+    void* memory;
+    SectorCacheTestDisk disk;
+} SectorCacheTest;
+
+static void sector_cache_test_fill(uint8_t* data, uint32_t n_sector) {
+    memset(data, n_sector & 0xFF, SECTOR_CACHE_TEST_SECTOR_SIZE);
+    memcpy(data, &n_sector, sizeof(n_sector));
+}
+
+static bool sector_cache_test_disk_read(
+    SectorCacheTestDisk* disk,
+    uint8_t* buff,
+    uint32_t n_sector,
+    uint32_t count) {
+    if(n_sector + count > disk->sectors) return false;
+
+    for(uint32_t i = 0; i < count; i++) {
+        sector_cache_test_fill(&buff[i * SECTOR_CACHE_TEST_SECTOR_SIZE], n_sector + i);
+    }
+    disk->reads++;
+    disk->sectors_read += count;
+
+    return true;
+}
+
+static SectorCacheTest* sector_cache_test_alloc(size_t capacity, size_t readahead) {
+    SectorCacheTest* test = malloc(sizeof(SectorCacheTest));
+    test->memory = malloc(sector_cache_get_memory_size(capacity, readahead));
+    test->cache = sector_cache_init(test->memory, capacity, readahead);
+    test->disk.sectors = SECTOR_CACHE_TEST_DISK_SECTORS;
+    test->disk.reads = 0;
+    test->disk.sectors_read = 0;
+    return test;
+}
+
+static void sector_cache_test_free(SectorCacheTest* test) {
+    free(test->memory);
+    free(test);
+}
+
+// Same sequence as the single sector read path of furi_hal_sd
+static bool sector_cache_test_read(SectorCacheTest* test, uint32_t n_sector) {
+    uint8_t buff[SECTOR_CACHE_TEST_SECTOR_SIZE];
+    bool success = false;
+
+    do {
+        uint8_t* cached_data = sector_cache_get(test->cache, n_sector);
+        if(cached_data) {
+            memcpy(buff, cached_data, SECTOR_CACHE_TEST_SECTOR_SIZE);
+            success = true;
+            break;
+        }
+
+        uint32_t count = sector_cache_readahead_count(test->cache, n_sector);
+        uint8_t* readahead_buff = sector_cache_get_readahead_buffer(test->cache);
+        if(count > 1 && readahead_buff &&
+           sector_cache_test_disk_read(&test->disk, readahead_buff, n_sector, count)) {
+            sector_cache_put_readahead(test->cache, n_sector, count);
+            memcpy(buff, readahead_buff, SECTOR_CACHE_TEST_SECTOR_SIZE);
+            success = true;
+            break;
+        }
+
+        if(!sector_cache_test_disk_read(&test->disk, buff, n_sector, 1)) break;
+        sector_cache_put(test->cache, n_sector, buff);
+        success = true;
+    } while(false);
+
+    if(success) {
+        uint8_t expected[SECTOR_CACHE_TEST_SECTOR_SIZE];
+        sector_cache_test_fill(expected, n_sector);
+        success = memcmp(expected, buff, SECTOR_CACHE_TEST_SECTOR_SIZE) == 0;
+    }
+
+    return success;
+}
+
+static bool sector_cache_test_is_cached(SectorCacheTest* test, uint32_t n_sector) {
+    uint32_t reads = test->disk.reads;
+    bool success = sector_cache_test_read(test, n_sector);
+    return success && (reads == test->disk.reads);
+}
+
+MU_TEST(test_sector_cache_lru) {
+    SectorCacheTest* test = sector_cache_test_alloc(SECTOR_CACHE_SECTORS_MIN, 0);
+
+    // Fill the cache with odd sectors, so that nothing looks sequential
+    for(uint32_t i = 0; i < SECTOR_CACHE_SECTORS_MIN; i++) {
+        mu_assert(sector_cache_test_read(test, 1 + i * 2), "read failed");
+    }
+    mu_assert_int_eq(SECTOR_CACHE_SECTORS_MIN, test->disk.reads);
+
+    // Touch the oldest sector, the next one in line becomes least recently used
+    mu_assert(sector_cache_test_is_cached(test, 1), "sector 1 not cached");
+    mu_assert(sector_cache_test_read(test, 101), "read failed");
+
+    mu_assert(sector_cache_test_is_cached(test, 1), "recently used sector evicted");
+    mu_assert(!sector_cache_test_is_cached(test, 3), "least recently used sector kept");
+    mu_assert(sector_cache_test_is_cached(test, 101), "new sector not cached");
+
+    SectorCacheStats stats;
+    sector_cache_get_stats(test->cache, &stats);
+    mu_assert_int_eq(SECTOR_CACHE_SECTORS_MIN, stats.capacity);
+    mu_assert_int_eq(3, stats.hits);
+    mu_assert_int_eq(SECTOR_CACHE_SECTORS_MIN + 2, stats.misses);
+    // Sector 101 pushed out sector 3, reading sector 3 back pushed out sector 5
+    mu_assert_int_eq(2, stats.evictions);
+    mu_assert_int_eq(0, stats.readahead);
+
+    sector_cache_test_free(test);
+}
+
+MU_TEST(test_sector_cache_invalidate) {
+    SectorCacheTest* test = sector_cache_test_alloc(SECTOR_CACHE_SECTORS_MIN, 0);
+
+    for(uint32_t i = 0; i < 4; i++) {
+        mu_assert(sector_cache_test_read(test, 10 + i * 2), "read failed");
+    }
+    sector_cache_invalidate_range(test->cache, 12, 14);
+
+    mu_assert(sector_cache_test_is_cached(test, 10), "sector before the range dropped");
+    mu_assert(!sector_cache_test_is_cached(test, 12), "sector in the range kept");
+    mu_assert(!sector_cache_test_is_cached(test, 14), "sector in the range kept");
+    mu_assert(sector_cache_test_is_cached(test, 16), "sector after the range dropped");
+
+    // Sector 0 is never cached
+    uint8_t data[SECTOR_CACHE_TEST_SECTOR_SIZE];
+    sector_cache_test_fill(data, 0);
+    sector_cache_put(test->cache, 0, data);
+    mu_assert(sector_cache_get(test->cache, 0) == NULL, "sector 0 cached");
+
+    sector_cache_reset(test->cache);
+    mu_assert(!sector_cache_test_is_cached(test, 10), "sector kept after reset");
+
+    sector_cache_test_free(test);
+}
+
+MU_TEST(test_sector_cache_pinning) {
+    SectorCacheTest* test = sector_cache_test_alloc(SECTOR_CACHE_SECTORS_MIN, 0);
+    const uint32_t pinned_count = SECTOR_CACHE_SECTORS_MIN / 2;
+    sector_cache_pin_range(test->cache, 100, 100 + (pinned_count - 1) * 2);
+
+    for(uint32_t i = 0; i < pinned_count; i++) {
+        mu_assert(sector_cache_test_read(test, 100 + i * 2), "read failed");
+    }
+    // A long scan must not flush the pinned sectors
+    for(uint32_t i = 0; i < SECTOR_CACHE_SECTORS_MIN * 4; i++) {
+        mu_assert(sector_cache_test_read(test, 151 + i * 2), "read failed");
+    }
+    for(uint32_t i = 0; i < pinned_count; i++) {
+        mu_assert(sector_cache_test_is_cached(test, 100 + i * 2), "pinned sector evicted");
+    }
+
+    // Pinned sectors over half of the cache are evicted as usual
+    sector_cache_reset(test->cache);
+    sector_cache_pin_range(test->cache, 100, 100 + pinned_count * 2);
+    for(uint32_t i = 0; i <= pinned_count; i++) {
+        mu_assert(sector_cache_test_read(test, 100 + i * 2), "read failed");
+    }
+    for(uint32_t i = 0; i < SECTOR_CACHE_SECTORS_MIN * 4; i++) {
+        mu_assert(sector_cache_test_read(test, 151 + i * 2), "read failed");
+    }
+    mu_assert(!sector_cache_test_is_cached(test, 100), "over-pinned sector kept");
+
+    sector_cache_test_free(test);
+}
+
+MU_TEST(test_sector_cache_readahead) {
+    SectorCacheTest* test =
+        sector_cache_test_alloc(SECTOR_CACHE_SECTORS_MIN, SECTOR_CACHE_READAHEAD_MAX);
+    SectorCacheStats stats;
+
+    // The first miss is a single sector read, the adjacent one starts reading ahead
+    mu_assert(sector_cache_test_read(test, 10), "read failed");
+    mu_assert(sector_cache_test_read(test, 11), "read failed");
+    mu_assert_int_eq(2, test->disk.reads);
+    mu_assert_int_eq(1 + SECTOR_CACHE_READAHEAD_MAX, test->disk.sectors_read);
+
+    for(uint32_t i = 1; i < SECTOR_CACHE_READAHEAD_MAX; i++) {
+        mu_assert(sector_cache_test_is_cached(test, 11 + i), "sector not read ahead");
+    }
+
+    sector_cache_get_stats(test->cache, &stats);
+    mu_assert_int_eq(SECTOR_CACHE_READAHEAD_MAX - 1, stats.readahead);
+
+    // A random access doesn't read ahead
+    mu_assert(sector_cache_test_read(test, 100), "read failed");
+    mu_assert_int_eq(3, test->disk.reads);
+    mu_assert_int_eq(2 + SECTOR_CACHE_READAHEAD_MAX, test->disk.sectors_read);
+
+    // A read ahead past the end of the disk fails, the single sector read takes over
+    uint32_t last = SECTOR_CACHE_TEST_DISK_SECTORS - 1;
+    mu_assert(sector_cache_test_read(test, last - 1), "read failed");
+    mu_assert(sector_cache_test_read(test, last), "read failed");
+
+    sector_cache_get_stats(test->cache, &stats);
+    mu_assert_int_eq(SECTOR_CACHE_READAHEAD_MAX - 1, stats.readahead);
+
+    sector_cache_test_free(test);
+}
+
+MU_TEST_SUITE(test_sector_cache_suite) {
+    MU_RUN_TEST(test_sector_cache_lru);
+    MU_RUN_TEST(test_sector_cache_invalidate);
+    MU_RUN_TEST(test_sector_cache_pinning);
+    MU_RUN_TEST(test_sector_cache_readahead);
+}
+
+int run_minunit_test_sector_cache(void) {
+    MU_RUN_SUITE(test_sector_cache_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_sector_cache)
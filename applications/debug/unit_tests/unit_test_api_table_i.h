@@ -6,9 +6,11 @@
 #include <task.h>
 
 #include <rpc/rpc_i.h>
+#include <rpc/rpc_md5_cache.h>
 #include <flipper.pb.h>
 #include <applications/system/js_app/js_thread.h>
 #include <applications/system/js_app/js_value.h>
+#include <targets/f7/fatfs/sector_cache.h>
 
 static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_alloc, ResourceManifestReader*, (Storage*)),
@@ -19,6 +21,10 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(slix_process_iso15693_3_error, SlixError, (Iso15693_3Error)),
     API_METHOD(iso15693_3_poller_get_data, const Iso15693_3Data*, (Iso15693_3Poller*)),
     API_METHOD(rpc_system_storage_get_error, PB_CommandStatus, (FS_Error)),
+    API_METHOD(rpc_md5_cache_alloc, RpcMd5Cache*, (Storage*)),
+    API_METHOD(rpc_md5_cache_free, void, (RpcMd5Cache*)),
+    API_METHOD(rpc_md5_cache_get, bool, (RpcMd5Cache*, const char*, FuriString*, FS_Error*)),
+    API_METHOD(rpc_md5_cache_invalidate_dir, void, (RpcMd5Cache*, const char*)),
     API_METHOD(xQueueSemaphoreTake, BaseType_t, (QueueHandle_t, TickType_t)),
     API_METHOD(
         xTaskGenericNotify,
@@ -51,4 +57,15 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
          mjs_val_t* source,
          size_t n_c_vals,
          ...)),
+    API_METHOD(sector_cache_get_memory_size, size_t, (size_t, size_t)),
+    API_METHOD(sector_cache_init, SectorCache*, (void*, size_t, size_t)),
+    API_METHOD(sector_cache_reset, void, (SectorCache*)),
+    API_METHOD(sector_cache_get, uint8_t*, (SectorCache*, uint32_t)),
+    API_METHOD(sector_cache_put, void, (SectorCache*, uint32_t, uint8_t*)),
+    API_METHOD(sector_cache_put_readahead, void, (SectorCache*, uint32_t, uint32_t)),
+    API_METHOD(sector_cache_invalidate_range, void, (SectorCache*, uint32_t, uint32_t)),
+    API_METHOD(sector_cache_pin_range, void, (SectorCache*, uint32_t, uint32_t)),
+    API_METHOD(sector_cache_readahead_count, uint32_t, (SectorCache*, uint32_t)),
+    API_METHOD(sector_cache_get_readahead_buffer, uint8_t*, (SectorCache*)),
+    API_METHOD(sector_cache_get_stats, void, (SectorCache*, SectorCacheStats*)),
     API_VARIABLE(PB_Main_msg, PB_Main_msg_t)));
@@ -0,0 +1,717 @@
+#include "mfkey32_recovery.h"
+
+#include <nfc/helpers/crypto1.h>
+#include <bit_lib/bit_lib.h>
+#include <stream/stream.h>
+#include <stream/buffered_file_stream.h>
+#include <toolbox/keys_dict.h>
+
+#include <furi.h>
+
+#define TAG "Mfkey32Recovery"
+
+// Key recovery from two reader authentications, algorithm from
+// https://github.com/RfidResearchGroup/proxmark3.git (crapto1 lfsr_recovery32 and mfkey32v2)
+//
+// Reconstructing the LFSR state from 32 keystream bits needs candidate tables of ~2^19 entries
+// per register half, which does not fit into RAM. Candidates are therefore expanded in two phases:
+// 1. Spill: every seed is extended by 8 keystream bits and the resulting entries are written to
+//    the SD card, partitioned by their feedback contribution byte (bucket).
+// 2. Recover: odd and even entries can only match within the same bucket, so buckets are loaded
+//    one by one and the rest of the search runs in RAM.
+// RAM usage: MFKEY32_RECOVERY_BUCKETS_NUM block buffers during the spill phase (32 KiB), two
+// tables of MFKEY32_RECOVERY_TABLE_CAPACITY entries during the recover phase (32 KiB).
+
+#define MFKEY32_RECOVERY_THREAD_STACK_SIZE (4 * 1024)
+#define MFKEY32_RECOVERY_SPILL_PATH        EXT_PATH("nfc/.mfkey32_spill.tmp")
+
+#define MFKEY32_RECOVERY_SEEDS_NUM           ((1UL << 20) + 1)
+#define MFKEY32_RECOVERY_SIMPLE_STEPS        (4U)
+#define MFKEY32_RECOVERY_SPILL_STEPS         (8U)
+#define MFKEY32_RECOVERY_REMAINING_STEPS     (7)
+#define MFKEY32_RECOVERY_STEPS_PER_LEVEL     (4)
+#define MFKEY32_RECOVERY_BUCKETS_NUM         (256U)
+#define MFKEY32_RECOVERY_BLOCK_ENTRIES       (31U)
+#define MFKEY32_RECOVERY_BLOCK_NONE          (UINT16_MAX)
+#define MFKEY32_RECOVERY_TABLE_CAPACITY      (4096U)
+#define MFKEY32_RECOVERY_PROGRESS_SEEDS_STEP (1UL << 15)
+
+#define LF_POLY_ODD  (0x29CE5C)
+#define LF_POLY_EVEN (0x870804)
+
+#define BEBIT(x, n)  FURI_BIT(x, (n) ^ 24)
+#define BUCKET(x)    ((x) >> 24)
+#define STATE_MASK   (0xFFFFFFU)
+#define PARITY(x)    ((uint32_t)__builtin_parity(x))
+
+typedef enum {
+    Mfkey32RecoveryHalfOdd,
+    Mfkey32RecoveryHalfEven,
+
+    Mfkey32RecoveryHalfNum,
+} Mfkey32RecoveryHalf;
+
+typedef enum {
+    Mfkey32RecoveryResultInProgress,
+    Mfkey32RecoveryResultKeyFound,
+    Mfkey32RecoveryResultKeyNotFound,
+    Mfkey32RecoveryResultError,
+    Mfkey32RecoveryResultCancelled,
+} Mfkey32RecoveryResult;
+
+typedef struct {
+    uint32_t cuid;
+    uint8_t sector_num;
+    char key_type;
+    uint32_t nt0;
+    uint32_t nr0;
+    uint32_t ar0;
+    uint32_t nt1;
+    uint32_t nr1;
+    uint32_t ar1;
+} Mfkey32RecoveryNonces;
+
+typedef struct {
+    uint16_t prev_block;
+    uint16_t count;
+    uint32_t entries[MFKEY32_RECOVERY_BLOCK_ENTRIES];
+} Mfkey32RecoveryBlock;
+
+struct Mfkey32Recovery {
+    Storage* storage;
+    FuriThread* thread;
+    FuriMutex* mutex;
+    FuriString* log_path;
+    FuriString* dict_path;
+    Mfkey32RecoveryCallback callback;
+    void* context;
+    Mfkey32RecoveryProgress progress;
+    volatile bool is_running;
+
+    // Current nonce pair
+    Mfkey32RecoveryNonces nonces;
+    uint32_t ar1_ks_plain;
+    uint32_t ks[Mfkey32RecoveryHalfNum];
+    Mfkey32RecoveryResult result;
+    uint64_t key;
+
+    // Spill phase
+    File* spill_file;
+    Mfkey32RecoveryBlock* blocks;
+    uint16_t blocks_written;
+    uint16_t last_block[Mfkey32RecoveryHalfNum][MFKEY32_RECOVERY_BUCKETS_NUM];
+
+    // Recover phase
+    uint32_t* tables[Mfkey32RecoveryHalfNum];
+};
+
+static inline uint8_t mfkey32_recovery_filter(uint32_t in) {
+    uint32_t out = 0;
+    out = 0xf22c0 >> (in & 0xf) & 16;
+    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
+    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
+    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    return FURI_BIT(0xEC57E80A, out);
+}
+
+// Calculates the partial linear feedback contributions and puts them into the MSB
+static inline uint32_t
+    mfkey32_recovery_update_contribution(uint32_t item, uint32_t mask1, uint32_t mask2) {
+    uint32_t p = item >> 25;
+
+    p = p << 1 | PARITY(item & mask1);
+    p = p << 1 | PARITY(item & mask2);
+    return p << 24 | (item & STATE_MASK);
+}
+
+static inline void mfkey32_recovery_get_masks(
+    Mfkey32RecoveryHalf half,
+    uint32_t* mask1,
+    uint32_t* mask2) {
+    if(half == Mfkey32RecoveryHalfOdd) {
+        *mask1 = LF_POLY_EVEN << 1 | 1;
+        *mask2 = LF_POLY_ODD << 1;
+    } else {
+        *mask1 = LF_POLY_ODD;
+        *mask2 = LF_POLY_EVEN << 1 | 1;
+    }
+}
+
+static void mfkey32_recovery_set_nonce_progress(Mfkey32Recovery* instance, uint8_t progress) {
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    bool is_updated = (instance->progress.nonce_progress != progress);
+    instance->progress.nonce_progress = progress;
+    furi_mutex_release(instance->mutex);
+
+    if(is_updated && instance->callback) {
+        instance->callback(Mfkey32RecoveryEventTypeProgress, instance->context);
+    }
+}
+
+static bool mfkey32_recovery_is_active(Mfkey32Recovery* instance) {
+    if(!instance->is_running && (instance->result == Mfkey32RecoveryResultInProgress)) {
+        instance->result = Mfkey32RecoveryResultCancelled;
+    }
+
+    return instance->result == Mfkey32RecoveryResultInProgress;
+}
+
+static bool mfkey32_recovery_spill_flush(
+    Mfkey32Recovery* instance,
+    Mfkey32RecoveryHalf half,
+    uint8_t bucket) {
+    Mfkey32RecoveryBlock* block = &instance->blocks[bucket];
+
+    bool success = false;
+    do {
+        if(instance->blocks_written == MFKEY32_RECOVERY_BLOCK_NONE) break;
+        block->prev_block = instance->last_block[half][bucket];
+        if(storage_file_write(instance->spill_file, block, sizeof(Mfkey32RecoveryBlock)) !=
+           sizeof(Mfkey32RecoveryBlock))
+            break;
+        instance->last_block[half][bucket] = instance->blocks_written++;
+        block->count = 0;
+        success = true;
+    } while(false);
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Failed to write spill block");
+        instance->result = Mfkey32RecoveryResultError;
+    }
+
+    return success;
+}
+
+static bool mfkey32_recovery_spill_entry(
+    Mfkey32Recovery* instance,
+    Mfkey32RecoveryHalf half,
+    uint32_t item,
+    uint8_t step) {
+    if(step == MFKEY32_RECOVERY_SPILL_STEPS) {
+        uint8_t bucket = BUCKET(item);
+        Mfkey32RecoveryBlock* block = &instance->blocks[bucket];
+        block->entries[block->count++] = item;
+        if(block->count < MFKEY32_RECOVERY_BLOCK_ENTRIES) return true;
+        return mfkey32_recovery_spill_flush(instance, half, bucket);
+    }
+
+    uint8_t bit = FURI_BIT(instance->ks[half], step + 1);
+    item <<= 1;
+    uint8_t filter0 = mfkey32_recovery_filter(item);
+    uint8_t filter1 = mfkey32_recovery_filter(item | 1);
+
+    uint32_t children[2];
+    uint8_t children_num = 0;
+    if(filter0 != filter1) {
+        children[children_num++] = item | (filter0 ^ bit);
+    } else if(filter0 == bit) {
+        children[children_num++] = item;
+        children[children_num++] = item | 1;
+    }
+
+    bool success = true;
+    for(uint8_t i = 0; (i < children_num) && success; i++) {
+        uint32_t child = children[i];
+        if(step >= MFKEY32_RECOVERY_SIMPLE_STEPS) {
+            uint32_t mask1, mask2;
+            mfkey32_recovery_get_masks(half, &mask1, &mask2);
+            child = mfkey32_recovery_update_contribution(child, mask1, mask2);
+        }
+        success = mfkey32_recovery_spill_entry(instance, half, child, step + 1);
+    }
+
+    return success;
+}
+
+static bool mfkey32_recovery_spill(Mfkey32Recovery* instance) {
+    instance->blocks_written = 0;
+    memset(instance->last_block, 0xff, sizeof(instance->last_block));
+
+    for(size_t half = 0; half < Mfkey32RecoveryHalfNum; half++) {
+        for(size_t i = 0; i < MFKEY32_RECOVERY_BUCKETS_NUM; i++) {
+            instance->blocks[i].count = 0;
+        }
+
+        for(uint32_t seed = 0; seed < MFKEY32_RECOVERY_SEEDS_NUM; seed++) {
+            if((seed % MFKEY32_RECOVERY_PROGRESS_SEEDS_STEP) == 0) {
+                if(!mfkey32_recovery_is_active(instance)) return false;
+                uint32_t seeds_done = half * MFKEY32_RECOVERY_SEEDS_NUM + seed;
+                // Spill phase takes up the first half of the progress
+                mfkey32_recovery_set_nonce_progress(
+                    instance, seeds_done * 50ULL / (MFKEY32_RECOVERY_SEEDS_NUM * 2));
+            }
+            if(mfkey32_recovery_filter(seed) != (instance->ks[half] & 1)) continue;
+            if(!mfkey32_recovery_spill_entry(instance, half, seed, 0)) return false;
+        }
+
+        for(size_t i = 0; i < MFKEY32_RECOVERY_BUCKETS_NUM; i++) {
+            if(instance->blocks[i].count == 0) continue;
+            if(!mfkey32_recovery_spill_flush(instance, half, i)) return false;
+        }
+    }
+
+    return true;
+}
+
+static bool mfkey32_recovery_load_bucket(
+    Mfkey32Recovery* instance,
+    Mfkey32RecoveryHalf half,
+    uint8_t bucket,
+    size_t* size) {
+    Mfkey32RecoveryBlock block;
+    uint32_t* table = instance->tables[half];
+    uint16_t block_num = instance->last_block[half][bucket];
+    *size = 0;
+
+    while(block_num != MFKEY32_RECOVERY_BLOCK_NONE) {
+        if(!storage_file_seek(
+               instance->spill_file, block_num * sizeof(Mfkey32RecoveryBlock), true) ||
+           storage_file_read(instance->spill_file, &block, sizeof(Mfkey32RecoveryBlock)) !=
+               sizeof(Mfkey32RecoveryBlock)) {
+            FURI_LOG_E(TAG, "Failed to read spill block");
+            instance->result = Mfkey32RecoveryResultError;
+            return false;
+        }
+        if(*size + block.count > MFKEY32_RECOVERY_TABLE_CAPACITY) {
+            FURI_LOG_E(TAG, "Bucket %u does not fit into RAM budget", bucket);
+            instance->result = Mfkey32RecoveryResultError;
+            return false;
+        }
+        memcpy(&table[*size], block.entries, block.count * sizeof(uint32_t));
+        *size += block.count;
+        block_num = block.prev_block;
+    }
+
+    return true;
+}
+
+// Extend the table of possible LFSR states in place using one keystream bit
+// Entries before index i are processed, entries from i to size are not
+static bool mfkey32_recovery_extend_table(
+    uint32_t* table,
+    size_t* size,
+    size_t capacity,
+    uint8_t bit,
+    uint32_t mask1,
+    uint32_t mask2) {
+    size_t end = *size;
+    size_t i = 0;
+
+    while(i < end) {
+        uint32_t item = table[i] << 1;
+        uint8_t filter0 = mfkey32_recovery_filter(item);
+        uint8_t filter1 = mfkey32_recovery_filter(item | 1);
+
+        if(filter0 != filter1) {
+            table[i++] =
+                mfkey32_recovery_update_contribution(item | (filter0 ^ bit), mask1, mask2);
+        } else if(filter0 == bit) {
+            if(end >= capacity) return false;
+            // Move the next unprocessed entry out of the way to keep both children adjacent
+            table[end++] = table[i + 1];
+            table[i++] = mfkey32_recovery_update_contribution(item, mask1, mask2);
+            table[i++] = mfkey32_recovery_update_contribution(item | 1, mask1, mask2);
+        } else {
+            table[i] = table[--end];
+        }
+    }
+
+    *size = end;
+    return true;
+}
+
+static void mfkey32_recovery_sift_down(uint32_t* table, size_t root, size_t size) {
+    while(2 * root + 1 < size) {
+        size_t child = 2 * root + 1;
+        if((child + 1 < size) && (table[child] < table[child + 1])) child++;
+        if(table[root] >= table[child]) break;
+        FURI_SWAP(table[root], table[child]);
+        root = child;
+    }
+}
+
+// Heapsort: in place and without recursion, the thread stack is small
+static void mfkey32_recovery_sort(uint32_t* table, size_t size) {
+    for(size_t i = size / 2; i > 0; i--) {
+        mfkey32_recovery_sift_down(table, i - 1, size);
+    }
+    for(size_t end = size; end > 1; end--) {
+        FURI_SWAP(table[0], table[end - 1]);
+        mfkey32_recovery_sift_down(table, 0, end - 1);
+    }
+}
+
+static inline uint64_t mfkey32_recovery_get_lfsr(const Crypto1* crypto) {
+    uint64_t lfsr = 0;
+    for(int8_t i = 23; i >= 0; i--) {
+        lfsr = lfsr << 1 | FURI_BIT(crypto->odd, i ^ 3);
+        lfsr = lfsr << 1 | FURI_BIT(crypto->even, i ^ 3);
+    }
+    return lfsr;
+}
+
+static void mfkey32_recovery_check_state(Mfkey32Recovery* instance, uint32_t odd, uint32_t even) {
+    const Mfkey32RecoveryNonces* nonces = &instance->nonces;
+    Crypto1 crypto = {.odd = odd & STATE_MASK, .even = even & STATE_MASK};
+
+    // Roll back to the key, then replay the second authentication
+    crypto1_lfsr_rollback_word(&crypto, 0, 0);
+    crypto1_lfsr_rollback_word(&crypto, nonces->nr0, 1);
+    crypto1_lfsr_rollback_word(&crypto, nonces->cuid ^ nonces->nt0, 0);
+    uint64_t key = mfkey32_recovery_get_lfsr(&crypto);
+
+    crypto1_word(&crypto, nonces->cuid ^ nonces->nt1, 0);
+    crypto1_word(&crypto, nonces->nr1, 1);
+    if(nonces->ar1 == (crypto1_word(&crypto, 0, 0) ^ instance->ar1_ks_plain)) {
+        instance->key = key;
+        instance->result = Mfkey32RecoveryResultKeyFound;
+    }
+}
+
+static void mfkey32_recovery_recover(
+    Mfkey32Recovery* instance,
+    uint32_t* odd,
+    size_t odd_size,
+    size_t odd_capacity,
+    uint32_t oks,
+    uint32_t* even,
+    size_t even_size,
+    size_t even_capacity,
+    uint32_t eks,
+    int8_t rem) {
+    if(rem < 0) {
+        for(size_t e = 0; e < even_size; e++) {
+            uint32_t even_item = even[e] << 1 ^ PARITY(even[e] & LF_POLY_EVEN);
+            for(size_t o = 0; o < odd_size; o++) {
+                mfkey32_recovery_check_state(
+                    instance, even_item ^ PARITY(odd[o] & LF_POLY_ODD), odd[o]);
+                if(instance->result != Mfkey32RecoveryResultInProgress) return;
+            }
+        }
+        return;
+    }
+
+    int8_t steps = MIN(rem, MFKEY32_RECOVERY_STEPS_PER_LEVEL);
+    rem = (rem >= MFKEY32_RECOVERY_STEPS_PER_LEVEL) ? (rem - MFKEY32_RECOVERY_STEPS_PER_LEVEL) :
+                                                      -1;
+    for(int8_t i = 0; i < steps; i++) {
+        oks >>= 1;
+        eks >>= 1;
+        if(!mfkey32_recovery_extend_table(
+               odd, &odd_size, odd_capacity, oks & 1, LF_POLY_EVEN << 1 | 1, LF_POLY_ODD << 1) ||
+           !mfkey32_recovery_extend_table(
+               even, &even_size, even_capacity, eks & 1, LF_POLY_ODD, LF_POLY_EVEN << 1 | 1)) {
+            FURI_LOG_E(TAG, "Candidate table overflow");
+            instance->result = Mfkey32RecoveryResultError;
+            return;
+        }
+        if((odd_size == 0) || (even_size == 0)) return;
+    }
+
+    mfkey32_recovery_sort(odd, odd_size);
+    mfkey32_recovery_sort(even, even_size);
+
+    // Match entries with equal contributions, starting from the tail:
+    // tails of the tables are free to be overwritten by the extension of the earlier groups
+    size_t odd_end = odd_size;
+    size_t even_end = even_size;
+    while((odd_end > 0) && (even_end > 0)) {
+        uint8_t odd_bucket = BUCKET(odd[odd_end - 1]);
+        uint8_t even_bucket = BUCKET(even[even_end - 1]);
+
+        size_t odd_start = odd_end;
+        if(odd_bucket >= even_bucket) {
+            while((odd_start > 0) && (BUCKET(odd[odd_start - 1]) == odd_bucket)) odd_start--;
+        }
+        size_t even_start = even_end;
+        if(even_bucket >= odd_bucket) {
+            while((even_start > 0) && (BUCKET(even[even_start - 1]) == even_bucket)) even_start--;
+        }
+
+        if(odd_bucket == even_bucket) {
+            mfkey32_recovery_recover(
+                instance,
+                &odd[odd_start],
+                odd_end - odd_start,
+                odd_capacity - odd_start,
+                oks,
+                &even[even_start],
+                even_end - even_start,
+                even_capacity - even_start,
+                eks,
+                rem);
+            if(instance->result != Mfkey32RecoveryResultInProgress) return;
+        }
+
+        odd_end = odd_start;
+        even_end = even_start;
+    }
+}
+
+static Mfkey32RecoveryResult mfkey32_recovery_recover_key(Mfkey32Recovery* instance) {
+    const Mfkey32RecoveryNonces* nonces = &instance->nonces;
+
+    instance->result = Mfkey32RecoveryResultInProgress;
+    instance->ar1_ks_plain = crypto1_prng_successor(nonces->nt1, 64);
+
+    // Keystream used to encrypt the first reader answer
+    uint32_t ks2 = nonces->ar0 ^ crypto1_prng_successor(nonces->nt0, 64);
+    instance->ks[Mfkey32RecoveryHalfOdd] = 0;
+    instance->ks[Mfkey32RecoveryHalfEven] = 0;
+    for(int8_t i = 31; i >= 0; i -= 2) {
+        instance->ks[Mfkey32RecoveryHalfOdd] =
+            instance->ks[Mfkey32RecoveryHalfOdd] << 1 | BEBIT(ks2, i);
+    }
+    for(int8_t i = 30; i >= 0; i -= 2) {
+        instance->ks[Mfkey32RecoveryHalfEven] =
+            instance->ks[Mfkey32RecoveryHalfEven] << 1 | BEBIT(ks2, i);
+    }
+
+    do {
+        instance->spill_file = storage_file_alloc(instance->storage);
+        if(!storage_file_open(
+               instance->spill_file,
+               MFKEY32_RECOVERY_SPILL_PATH,
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Failed to open spill file");
+            instance->result = Mfkey32RecoveryResultError;
+            break;
+        }
+
+        instance->blocks = malloc(sizeof(Mfkey32RecoveryBlock) * MFKEY32_RECOVERY_BUCKETS_NUM);
+        bool spill_success = mfkey32_recovery_spill(instance);
+        free(instance->blocks);
+        instance->blocks = NULL;
+        if(!spill_success) break;
+
+        for(size_t half = 0; half < Mfkey32RecoveryHalfNum; half++) {
+            instance->tables[half] = malloc(sizeof(uint32_t) * MFKEY32_RECOVERY_TABLE_CAPACITY);
+        }
+
+        for(size_t bucket = 0; bucket < MFKEY32_RECOVERY_BUCKETS_NUM; bucket++) {
+            if(!mfkey32_recovery_is_active(instance)) break;
+            mfkey32_recovery_set_nonce_progress(
+                instance, 50 + bucket * 50 / MFKEY32_RECOVERY_BUCKETS_NUM);
+
+            size_t odd_size = 0;
+            size_t even_size = 0;
+            if(!mfkey32_recovery_load_bucket(
+                   instance, Mfkey32RecoveryHalfOdd, bucket, &odd_size)) {
+                break;
+            }
+            if(odd_size == 0) continue;
+            if(!mfkey32_recovery_load_bucket(
+                   instance, Mfkey32RecoveryHalfEven, bucket, &even_size)) {
+                break;
+            }
+            if(even_size == 0) continue;
+
+            mfkey32_recovery_recover(
+                instance,
+                instance->tables[Mfkey32RecoveryHalfOdd],
+                odd_size,
+                MFKEY32_RECOVERY_TABLE_CAPACITY,
+                instance->ks[Mfkey32RecoveryHalfOdd] >> MFKEY32_RECOVERY_SPILL_STEPS,
+                instance->tables[Mfkey32RecoveryHalfEven],
+                even_size,
+                MFKEY32_RECOVERY_TABLE_CAPACITY,
+                instance->ks[Mfkey32RecoveryHalfEven] >> MFKEY32_RECOVERY_SPILL_STEPS,
+                MFKEY32_RECOVERY_REMAINING_STEPS);
+        }
+
+        for(size_t half = 0; half < Mfkey32RecoveryHalfNum; half++) {
+            free(instance->tables[half]);
+            instance->tables[half] = NULL;
+        }
+    } while(false);
+
+    storage_file_close(instance->spill_file);
+    storage_file_free(instance->spill_file);
+    instance->spill_file = NULL;
+    storage_simply_remove(instance->storage, MFKEY32_RECOVERY_SPILL_PATH);
+
+    if(instance->result == Mfkey32RecoveryResultInProgress) {
+        instance->result = Mfkey32RecoveryResultKeyNotFound;
+    }
+
+    return instance->result;
+}
+
+static bool mfkey32_recovery_parse_nonces(const char* line, Mfkey32RecoveryNonces* nonces) {
+    unsigned int sector_num = 0;
+    int fields = sscanf(
+        line,
+        "Sec %u key %c cuid %08lx nt0 %08lx nr0 %08lx ar0 %08lx nt1 %08lx nr1 %08lx ar1 %08lx",
+        &sector_num,
+        &nonces->key_type,
+        &nonces->cuid,
+        &nonces->nt0,
+        &nonces->nr0,
+        &nonces->ar0,
+        &nonces->nt1,
+        &nonces->nr1,
+        &nonces->ar1);
+    nonces->sector_num = sector_num;
+
+    return fields == 9;
+}
+
+static size_t mfkey32_recovery_count_nonces(Stream* stream, FuriString* line) {
+    Mfkey32RecoveryNonces nonces;
+    size_t nonces_num = 0;
+
+    stream_rewind(stream);
+    while(stream_read_line(stream, line)) {
+        if(mfkey32_recovery_parse_nonces(furi_string_get_cstr(line), &nonces)) nonces_num++;
+    }
+    stream_rewind(stream);
+
+    return nonces_num;
+}
+
+static void mfkey32_recovery_add_key(Mfkey32Recovery* instance, uint64_t key) {
+    MfClassicKey mf_key = {};
+    bit_lib_num_to_bytes_be(key, sizeof(MfClassicKey), mf_key.data);
+    FURI_LOG_I(TAG, "Found key %012llX", key);
+
+    KeysDict* dict = keys_dict_alloc(
+        furi_string_get_cstr(instance->dict_path), KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    if(!keys_dict_is_key_present(dict, mf_key.data, sizeof(MfClassicKey))) {
+        keys_dict_add_key(dict, mf_key.data, sizeof(MfClassicKey));
+    }
+    keys_dict_free(dict);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    instance->progress.keys_found++;
+    furi_mutex_release(instance->mutex);
+
+    if(instance->callback) {
+        instance->callback(Mfkey32RecoveryEventTypeKeyFound, instance->context);
+    }
+}
+
+static int32_t mfkey32_recovery_worker(void* context) {
+    Mfkey32Recovery* instance = context;
+
+    Stream* stream = buffered_file_stream_alloc(instance->storage);
+    FuriString* line = furi_string_alloc();
+    bool is_error = false;
+
+    do {
+        if(!buffered_file_stream_open(
+               stream, furi_string_get_cstr(instance->log_path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_E(TAG, "Failed to open log");
+            is_error = true;
+            break;
+        }
+
+        size_t nonces_total = mfkey32_recovery_count_nonces(stream, line);
+        furi_mutex_acquire(instance->mutex, FuriWaitForever);
+        instance->progress.nonces_total = nonces_total;
+        furi_mutex_release(instance->mutex);
+
+        while(instance->is_running && stream_read_line(stream, line)) {
+            if(!mfkey32_recovery_parse_nonces(furi_string_get_cstr(line), &instance->nonces)) {
+                continue;
+            }
+
+            furi_mutex_acquire(instance->mutex, FuriWaitForever);
+            instance->progress.nonces_current++;
+            instance->progress.nonce_progress = 0;
+            furi_mutex_release(instance->mutex);
+
+            FURI_LOG_D(
+                TAG,
+                "Recovering sector %u key %c",
+                instance->nonces.sector_num,
+                instance->nonces.key_type);
+            Mfkey32RecoveryResult result = mfkey32_recovery_recover_key(instance);
+            if(result == Mfkey32RecoveryResultKeyFound) {
+                mfkey32_recovery_add_key(instance, instance->key);
+            } else if(result == Mfkey32RecoveryResultError) {
+                is_error = true;
+                break;
+            }
+        }
+    } while(false);
+
+    furi_string_free(line);
+    buffered_file_stream_close(stream);
+    stream_free(stream);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    instance->progress.is_error = is_error;
+    furi_mutex_release(instance->mutex);
+
+    if(instance->callback) {
+        instance->callback(Mfkey32RecoveryEventTypeFinished, instance->context);
+    }
+
+    return 0;
+}
+
+Mfkey32Recovery* mfkey32_recovery_alloc(Storage* storage) {
+    furi_assert(storage);
+
+    Mfkey32Recovery* instance = malloc(sizeof(Mfkey32Recovery));
+    instance->storage = storage;
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->log_path = furi_string_alloc();
+    instance->dict_path = furi_string_alloc();
+    instance->thread = furi_thread_alloc_ex(
+        TAG, MFKEY32_RECOVERY_THREAD_STACK_SIZE, mfkey32_recovery_worker, instance);
+
+    return instance;
+}
+
+void mfkey32_recovery_free(Mfkey32Recovery* instance) {
+    furi_assert(instance);
+    furi_assert(!instance->is_running);
+
+    furi_thread_free(instance->thread);
+    furi_string_free(instance->dict_path);
+    furi_string_free(instance->log_path);
+    furi_mutex_free(instance->mutex);
+    free(instance);
+}
+
+void mfkey32_recovery_start(
+    Mfkey32Recovery* instance,
+    const char* log_path,
+    const char* dict_path,
+    Mfkey32RecoveryCallback callback,
+    void* context) {
+    furi_assert(instance);
+    furi_assert(log_path);
+    furi_assert(dict_path);
+    furi_assert(!instance->is_running);
+
+    furi_string_set(instance->log_path, log_path);
+    furi_string_set(instance->dict_path, dict_path);
+    instance->callback = callback;
+    instance->context = context;
+    memset(&instance->progress, 0, sizeof(Mfkey32RecoveryProgress));
+
+    instance->is_running = true;
+    furi_thread_start(instance->thread);
+}
+
+void mfkey32_recovery_stop(Mfkey32Recovery* instance) {
+    furi_assert(instance);
+
+    if(!instance->is_running) return;
+
+    instance->is_running = false;
+    furi_thread_join(instance->thread);
+}
+
+void mfkey32_recovery_get_progress(Mfkey32Recovery* instance, Mfkey32RecoveryProgress* progress) {
+    furi_assert(instance);
+    furi_assert(progress);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    *progress = instance->progress;
+    furi_mutex_release(instance->mutex);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Mfkey32Recovery Mfkey32Recovery;
+
+typedef enum {
+    Mfkey32RecoveryEventTypeProgress,
+    Mfkey32RecoveryEventTypeKeyFound,
+    Mfkey32RecoveryEventTypeFinished,
+} Mfkey32RecoveryEventType;
+
+typedef void (*Mfkey32RecoveryCallback)(Mfkey32RecoveryEventType type, void* context);
+
+typedef struct {
+    size_t nonces_total;
+    size_t nonces_current;
+    uint8_t nonce_progress; // Percent of the current nonce pair processed
+    size_t keys_found;
+    bool is_error;
+} Mfkey32RecoveryProgress;
+
+Mfkey32Recovery* mfkey32_recovery_alloc(Storage* storage);
+
+void mfkey32_recovery_free(Mfkey32Recovery* instance);
+
+/**
+ * @brief Start recovering keys from nonce pairs saved by Mfkey32Logger.
+ *
+ * Runs in a separate thread. Every recovered key is added to the dictionary at dict_path.
+ * Candidate state lists are partitioned and spilled to the SD card, so that the RAM usage
+ * stays within a fixed budget regardless of the nonce values.
+ *
+ * @param instance pointer to the Mfkey32Recovery instance.
+ * @param log_path path to the mfkey32 log file.
+ * @param dict_path path to the user dictionary to store the recovered keys in.
+ * @param callback callback to be called on progress update, may be called from the worker thread.
+ * @param context callback context.
+ */
+void mfkey32_recovery_start(
+    Mfkey32Recovery* instance,
+    const char* log_path,
+    const char* dict_path,
+    Mfkey32RecoveryCallback callback,
+    void* context);
+
+void mfkey32_recovery_stop(Mfkey32Recovery* instance);
+
+void mfkey32_recovery_get_progress(Mfkey32Recovery* instance, Mfkey32RecoveryProgress* progress);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,34 +1,352 @@
 #include "nfc_emv_parser.h"
-#include <flipper_format/flipper_format.h>
+
+#include <toolbox/stream/buffered_file_stream.h>
+
+#define TAG "NfcEmvParser"
+
+#define NFC_EMV_PARSER_INDEX_SUFFIX  ".idx"
+#define NFC_EMV_PARSER_INDEX_MAGIC   (0x49564D45U) // "EMVI"
+#define NFC_EMV_PARSER_INDEX_VERSION (1U)
+#define NFC_EMV_PARSER_SLOTS_MAX     (1024U)
+#define NFC_EMV_PARSER_SLOT_EMPTY    (0U)
 
 static const char* nfc_resources_header = "Flipper EMV resources";
 static const uint32_t nfc_resources_file_version = 1;
 
+// Resources are compiled into an open addressing hash table file next to the source,
+// so that a lookup takes a few small reads instead of a full scan of the source file.
+// The index is rebuilt whenever the source timestamp or size changes. Sources with more
+// entries than the table can hold get an index without slots and are searched sequentially.
+
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t source_timestamp;
+    uint32_t source_size;
+    uint32_t slot_count;
+} NfcEmvParserIndexHeader;
+
+typedef struct FURI_PACKED {
+    uint32_t hash;
+    uint32_t record_offset; // Records follow the slots, so 0 marks an empty slot
+} NfcEmvParserIndexSlot;
+
+typedef struct FURI_PACKED {
+    uint8_t key_len;
+    uint8_t value_len;
+} NfcEmvParserIndexRecord;
+
+typedef bool (*NfcEmvParserEntryCallback)(const char* key, const char* value, void* context);
+
+static uint32_t nfc_emv_parser_hash(const char* key) {
+    // FNV-1a
+    uint32_t hash = 2166136261U;
+    while(*key) {
+        hash ^= (uint8_t)*key++;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+static bool nfc_emv_parser_source_for_each(
+    Storage* storage,
+    const char* file_name,
+    NfcEmvParserEntryCallback callback,
+    void* context) {
+    bool parsed = false;
+    Stream* stream = buffered_file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    FuriString* key = furi_string_alloc();
+    bool header_valid = false;
+    bool version_valid = false;
+
+    do {
+        if(!buffered_file_stream_open(stream, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        bool entries_valid = true;
+        while(stream_read_line(stream, line)) {
+            furi_string_trim(line);
+            if(furi_string_empty(line) || (furi_string_get_char(line, 0) == '#')) continue;
+
+            size_t separator = furi_string_search_str(line, ": ");
+            if(separator == FURI_STRING_FAILURE) continue;
+
+            furi_string_set_n(key, line, 0, separator);
+            furi_string_right(line, separator + 2);
+
+            if(furi_string_equal_str(key, "Filetype")) {
+                header_valid = furi_string_equal_str(line, nfc_resources_header);
+            } else if(furi_string_equal_str(key, "Version")) {
+                version_valid = (strtoul(furi_string_get_cstr(line), NULL, 10) ==
+                                 nfc_resources_file_version);
+            } else if(!header_valid || !version_valid) {
+                entries_valid = false;
+                break;
+            } else if(
+                (furi_string_size(key) > UINT8_MAX) || (furi_string_size(line) > UINT8_MAX)) {
+                // Record lengths are stored in a byte, such entries can't be looked up
+                FURI_LOG_W(TAG, "Entry too long: %s", furi_string_get_cstr(key));
+                continue;
+            } else if(!callback(furi_string_get_cstr(key), furi_string_get_cstr(line), context)) {
+                entries_valid = false;
+                break;
+            }
+        }
+        if(!entries_valid || !header_valid || !version_valid) break;
+
+        parsed = true;
+    } while(false);
+
+    furi_string_free(key);
+    furi_string_free(line);
+    buffered_file_stream_close(stream);
+    stream_free(stream);
+
+    return parsed;
+}
+
+typedef struct {
+    NfcEmvParserIndexSlot* slots;
+    uint32_t slot_count;
+    uint32_t entry_count;
+    uint32_t record_offset;
+} NfcEmvParserIndexBuildContext;
+
+static bool nfc_emv_parser_count_callback(const char* key, const char* value, void* context) {
+    UNUSED(key);
+    UNUSED(value);
+    NfcEmvParserIndexBuildContext* build_context = context;
+    build_context->entry_count++;
+    return true;
+}
+
+static bool nfc_emv_parser_place_callback(const char* key, const char* value, void* context) {
+    NfcEmvParserIndexBuildContext* build_context = context;
+    uint32_t hash = nfc_emv_parser_hash(key);
+    uint32_t mask = build_context->slot_count - 1;
+
+    // Duplicate keys keep the first occurrence, same as a sequential FlipperFormat search
+    uint32_t slot_idx = hash & mask;
+    while(build_context->slots[slot_idx].record_offset != NFC_EMV_PARSER_SLOT_EMPTY) {
+        slot_idx = (slot_idx + 1) & mask;
+    }
+    build_context->slots[slot_idx].hash = hash;
+    build_context->slots[slot_idx].record_offset = build_context->record_offset;
+    build_context->record_offset += sizeof(NfcEmvParserIndexRecord) + strlen(key) + strlen(value);
+
+    return true;
+}
+
+static bool nfc_emv_parser_write_callback(const char* key, const char* value, void* context) {
+    File* file = context;
+    size_t key_len = strlen(key);
+    size_t value_len = strlen(value);
+    if((key_len > UINT8_MAX) || (value_len > UINT8_MAX)) return false;
+
+    NfcEmvParserIndexRecord record = {
+        .key_len = key_len,
+        .value_len = value_len,
+    };
+
+    return (storage_file_write(file, &record, sizeof(record)) == sizeof(record)) &&
+           (storage_file_write(file, key, record.key_len) == record.key_len) &&
+           (storage_file_write(file, value, record.value_len) == record.value_len);
+}
+
+static bool nfc_emv_parser_index_build(
+    Storage* storage,
+    const char* file_name,
+    const char* index_name,
+    const FileInfo* source_info,
+    uint32_t source_timestamp) {
+    bool index_built = false;
+    NfcEmvParserIndexBuildContext build_context = {};
+    File* file = storage_file_alloc(storage);
+
+    do {
+        if(!nfc_emv_parser_source_for_each(
+               storage, file_name, nfc_emv_parser_count_callback, &build_context))
+            break;
+
+        // Keep the load factor at 50% or less, so that probe sequences stay short
+        build_context.slot_count = 1;
+        while(build_context.slot_count < build_context.entry_count * 2) {
+            build_context.slot_count <<= 1;
+        }
+        if(build_context.slot_count > NFC_EMV_PARSER_SLOTS_MAX) {
+            FURI_LOG_W(TAG, "Too many entries in %s, falling back to scan", file_name);
+            build_context.slot_count = 0;
+        }
+
+        if(build_context.slot_count > 0) {
+            build_context.slots =
+                malloc(build_context.slot_count * sizeof(NfcEmvParserIndexSlot));
+            build_context.record_offset =
+                sizeof(NfcEmvParserIndexHeader) +
+                build_context.slot_count * sizeof(NfcEmvParserIndexSlot);
+            if(!nfc_emv_parser_source_for_each(
+                   storage, file_name, nfc_emv_parser_place_callback, &build_context))
+                break;
+        }
+
+        if(!storage_file_open(file, index_name, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        NfcEmvParserIndexHeader header = {
+            .magic = NFC_EMV_PARSER_INDEX_MAGIC,
+            .version = NFC_EMV_PARSER_INDEX_VERSION,
+            .source_timestamp = source_timestamp,
+            .source_size = source_info->size,
+            .slot_count = build_context.slot_count,
+        };
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.slot_count == 0) {
+            index_built = true;
+            break;
+        }
+        size_t slots_size = build_context.slot_count * sizeof(NfcEmvParserIndexSlot);
+        if(storage_file_write(file, build_context.slots, slots_size) != slots_size) break;
+        if(!nfc_emv_parser_source_for_each(
+               storage, file_name, nfc_emv_parser_write_callback, file))
+            break;
+
+        index_built = true;
+    } while(false);
+
+    storage_file_free(file);
+    free(build_context.slots);
+
+    if(!index_built) {
+        storage_simply_remove(storage, index_name);
+    }
+
+    return index_built;
+}
+
+static bool nfc_emv_parser_index_open(
+    Storage* storage,
+    File* file,
+    const char* file_name,
+    NfcEmvParserIndexHeader* header) {
+    bool index_opened = false;
+    FuriString* index_name =
+        furi_string_alloc_printf("%s%s", file_name, NFC_EMV_PARSER_INDEX_SUFFIX);
+
+    do {
+        FileInfo source_info = {};
+        uint32_t source_timestamp = 0;
+        if(storage_common_stat(storage, file_name, &source_info) != FSE_OK) break;
+        if(storage_common_timestamp(storage, file_name, &source_timestamp) != FSE_OK) break;
+
+        for(size_t attempt = 0; attempt < 2; attempt++) {
+            if(storage_file_open(
+                   file, furi_string_get_cstr(index_name), FSAM_READ, FSOM_OPEN_EXISTING)) {
+                bool header_valid =
+                    (storage_file_read(file, header, sizeof(NfcEmvParserIndexHeader)) ==
+                     sizeof(NfcEmvParserIndexHeader)) &&
+                    (header->magic == NFC_EMV_PARSER_INDEX_MAGIC) &&
+                    (header->version == NFC_EMV_PARSER_INDEX_VERSION) &&
+                    (header->source_timestamp == source_timestamp) &&
+                    (header->source_size == source_info.size) &&
+                    (header->slot_count <= NFC_EMV_PARSER_SLOTS_MAX) &&
+                    ((header->slot_count & (header->slot_count - 1)) == 0);
+                if(header_valid) {
+                    index_opened = true;
+                    break;
+                }
+            }
+            if(storage_file_is_open(file)) storage_file_close(file);
+
+            if(attempt > 0) break;
+            FURI_LOG_D(TAG, "Building index for %s", file_name);
+            if(!nfc_emv_parser_index_build(
+                   storage,
+                   file_name,
+                   furi_string_get_cstr(index_name),
+                   &source_info,
+                   source_timestamp))
+                break;
+        }
+    } while(false);
+
+    furi_string_free(index_name);
+
+    return index_opened;
+}
+
+typedef struct {
+    FuriString* key;
+    FuriString* data;
+    bool found;
+} NfcEmvParserScanContext;
+
+static bool nfc_emv_parser_scan_callback(const char* key, const char* value, void* context) {
+    NfcEmvParserScanContext* scan_context = context;
+
+    if(furi_string_equal_str(scan_context->key, key)) {
+        furi_string_set_str(scan_context->data, value);
+        scan_context->found = true;
+        // Stop at the first match
+        return false;
+    }
+
+    return true;
+}
+
 static bool nfc_emv_parser_search_data(
     Storage* storage,
     const char* file_name,
     FuriString* key,
     FuriString* data) {
     bool parsed = false;
-    FlipperFormat* file = flipper_format_file_alloc(storage);
-    FuriString* temp_str;
-    temp_str = furi_string_alloc();
+    File* file = storage_file_alloc(storage);
+    char buffer[UINT8_MAX * 2];
 
     do {
-        // Open file
-        if(!flipper_format_file_open_existing(file, file_name)) break;
-        // Read file header and version
-        uint32_t version = 0;
-        if(!flipper_format_read_header(file, temp_str, &version)) break;
-        if(furi_string_cmp_str(temp_str, nfc_resources_header) ||
-           (version != nfc_resources_file_version))
+        NfcEmvParserIndexHeader header = {};
+        bool index_opened = nfc_emv_parser_index_open(storage, file, file_name, &header);
+        if(!index_opened || (header.slot_count == 0)) {
+            if(storage_file_is_open(file)) storage_file_close(file);
+            NfcEmvParserScanContext scan_context = {.key = key, .data = data};
+            nfc_emv_parser_source_for_each(
+                storage, file_name, nfc_emv_parser_scan_callback, &scan_context);
+            parsed = scan_context.found;
             break;
-        if(!flipper_format_read_string(file, furi_string_get_cstr(key), data)) break;
-        parsed = true;
+        }
+
+        uint32_t hash = nfc_emv_parser_hash(furi_string_get_cstr(key));
+        uint32_t mask = header.slot_count - 1;
+        uint32_t slot_idx = hash & mask;
+
+        for(uint32_t probe = 0; probe < header.slot_count; probe++) {
+            NfcEmvParserIndexSlot slot = {};
+            if(!storage_file_seek(
+                   file, sizeof(header) + slot_idx * sizeof(NfcEmvParserIndexSlot), true))
+                break;
+            if(storage_file_read(file, &slot, sizeof(slot)) != sizeof(slot)) break;
+            if(slot.record_offset == NFC_EMV_PARSER_SLOT_EMPTY) break;
+
+            if(slot.hash == hash) {
+                NfcEmvParserIndexRecord record = {};
+                if(!storage_file_seek(file, slot.record_offset, true)) break;
+                if(storage_file_read(file, &record, sizeof(record)) != sizeof(record)) break;
+                size_t record_len = record.key_len + record.value_len;
+                if(record_len > sizeof(buffer)) break;
+
+                // Hash collisions with a different key length don't need the record body
+                if((record.key_len == furi_string_size(key)) &&
+                   (storage_file_read(file, buffer, record_len) == record_len) &&
+                   (memcmp(buffer, furi_string_get_cstr(key), record.key_len) == 0)) {
+                    furi_string_set_strn(data, &buffer[record.key_len], record.value_len);
+                    parsed = true;
+                    break;
+                }
+            }
+
+            slot_idx = (slot_idx + 1) & mask;
+        }
     } while(false);
 
-    furi_string_free(temp_str);
-    flipper_format_free(file);
+    storage_file_free(file);
     return parsed;
 }
 
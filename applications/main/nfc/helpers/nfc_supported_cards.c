@@ -3,6 +3,9 @@
 
 #include "../plugins/supported_cards/nfc_supported_card_plugin.h"
 
+#include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
+#include <nfc/protocols/mf_desfire/mf_desfire.h>
+
 #include <flipper_application/flipper_application.h>
 #include <flipper_application/plugins/plugin_manager.h>
 #include <flipper_application/plugins/composite_resolver.h>
@@ -10,12 +13,18 @@
 
 #include <furi.h>
 #include <path.h>
+#include <bit_lib/bit_lib.h>
 #include <m-array.h>
 
 #define TAG "NfcSupportedCards"
 
 #define NFC_SUPPORTED_CARDS_PLUGINS_PATH  APP_DATA_PATH("plugins")
 #define NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX "_parser.fal"
+#define NFC_SUPPORTED_CARDS_INDEX_PATH    APP_DATA_PATH(".plugins.idx")
+#define NFC_SUPPORTED_CARDS_INDEX_MAGIC   (0x5843444EU) // "NDCX"
+#define NFC_SUPPORTED_CARDS_INDEX_VERSION (2U)
+#define NFC_SUPPORTED_CARDS_RESIDENT_MAX  (2U)
+#define NFC_SUPPORTED_CARDS_KEY_CHECK_MAX (16U)
 
 typedef enum {
     NfcSupportedCardsPluginFeatureHasVerify = (1U << 0),
@@ -25,12 +34,30 @@ typedef enum {
 
 typedef struct {
     FuriString* name;
+    uint64_t file_size;
     NfcProtocol protocol;
     NfcSupportedCardsPluginFeature feature;
+    NfcSupportedCardPluginSignature* signatures;
+    uint8_t signatures_count;
 } NfcSupportedCardsPluginCache;
 
 ARRAY_DEF(NfcSupportedCardsPluginCache, NfcSupportedCardsPluginCache, M_POD_OPLIST); //-V658
 
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t api_version;
+    uint32_t count;
+} NfcSupportedCardsIndexHeader;
+
+typedef struct FURI_PACKED {
+    uint64_t file_size;
+    uint8_t protocol;
+    uint8_t feature;
+    uint8_t name_len;
+    uint8_t signatures_count;
+} NfcSupportedCardsIndexRecord;
+
 typedef enum {
     NfcSupportedCardsLoadStateIdle,
     NfcSupportedCardsLoadStateInProgress,
@@ -42,19 +69,77 @@ typedef struct {
     Storage* storage;
     File* directory;
     char file_name[256];
+    FileInfo file_info;
     FlipperApplication* app;
 } NfcSupportedCardsLoadContext;
 
+typedef struct {
+    size_t cache_idx;
+    FlipperApplication* app;
+    const NfcSupportedCardsPlugin* plugin;
+} NfcSupportedCardsResidentPlugin;
+
+typedef struct {
+    uint8_t sector;
+    uint8_t key_type;
+    uint64_t key;
+    bool is_valid;
+} NfcSupportedCardsKeyCheck;
+
+typedef struct {
+    Nfc* nfc;
+    const NfcDevice* device;
+} NfcSupportedCardsMatchContext;
+
 struct NfcSupportedCards {
+    Storage* storage;
     CompositeApiResolver* api_resolver;
     NfcSupportedCardsPluginCache_t plugins_cache_arr;
     NfcSupportedCardsLoadState load_state;
     NfcSupportedCardsLoadContext* load_context;
+    // Most recently used plugins stay loaded, index 0 is the hottest one
+    NfcSupportedCardsResidentPlugin resident[NFC_SUPPORTED_CARDS_RESIDENT_MAX];
+    size_t resident_count;
+    // Keys tried on the card during the current read, so that plugins sharing a key cost one auth
+    NfcSupportedCardsKeyCheck key_checks[NFC_SUPPORTED_CARDS_KEY_CHECK_MAX];
+    size_t key_checks_count;
 };
 
+typedef bool (
+    *NfcSupportedCardsPluginHandler)(const NfcSupportedCardsPlugin* plugin, void* context);
+
+static void nfc_supported_cards_plugins_cache_reset(NfcSupportedCardsPluginCache_t cache_arr) {
+    NfcSupportedCardsPluginCache_it_t iter;
+    for(NfcSupportedCardsPluginCache_it(iter, cache_arr);
+        !NfcSupportedCardsPluginCache_end_p(iter);
+        NfcSupportedCardsPluginCache_next(iter)) {
+        NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
+        furi_string_free(plugin_cache->name);
+        free(plugin_cache->signatures);
+    }
+    NfcSupportedCardsPluginCache_reset(cache_arr);
+}
+
+static void nfc_supported_cards_plugin_cache_set_signatures(
+    NfcSupportedCardsPluginCache* plugin_cache,
+    const NfcSupportedCardPluginSignature* signatures,
+    size_t signatures_count) {
+    plugin_cache->signatures = NULL;
+    plugin_cache->signatures_count = 0;
+
+    if((signatures == NULL) || (signatures_count == 0)) return;
+
+    const size_t size = signatures_count * sizeof(NfcSupportedCardPluginSignature);
+    plugin_cache->signatures = malloc(size);
+    memcpy(plugin_cache->signatures, signatures, size);
+    plugin_cache->signatures_count = signatures_count;
+}
+
 NfcSupportedCards* nfc_supported_cards_alloc(void) {
     NfcSupportedCards* instance = malloc(sizeof(NfcSupportedCards));
 
+    instance->storage = furi_record_open(RECORD_STORAGE);
+
     instance->api_resolver = composite_api_resolver_alloc();
     composite_api_resolver_add(instance->api_resolver, firmware_api_interface);
     composite_api_resolver_add(instance->api_resolver, nfc_application_api_interface);
@@ -67,23 +152,22 @@ NfcSupportedCards* nfc_supported_cards_alloc(void) {
 void nfc_supported_cards_free(NfcSupportedCards* instance) {
     furi_assert(instance);
 
-    NfcSupportedCardsPluginCache_it_t iter;
-    for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
-        !NfcSupportedCardsPluginCache_end_p(iter);
-        NfcSupportedCardsPluginCache_next(iter)) {
-        NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
-        furi_string_free(plugin_cache->name);
+    for(size_t i = 0; i < instance->resident_count; i++) {
+        flipper_application_free(instance->resident[i].app);
     }
+
+    nfc_supported_cards_plugins_cache_reset(instance->plugins_cache_arr);
     NfcSupportedCardsPluginCache_clear(instance->plugins_cache_arr);
 
     composite_api_resolver_free(instance->api_resolver);
+    furi_record_close(RECORD_STORAGE);
     free(instance);
 }
 
-static NfcSupportedCardsLoadContext* nfc_supported_cards_load_context_alloc(void) {
+static NfcSupportedCardsLoadContext* nfc_supported_cards_load_context_alloc(Storage* storage) {
     NfcSupportedCardsLoadContext* instance = malloc(sizeof(NfcSupportedCardsLoadContext));
 
-    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->storage = storage;
     instance->directory = storage_file_alloc(instance->storage);
 
     if(!storage_dir_open(instance->directory, NFC_SUPPORTED_CARDS_PLUGINS_PATH)) {
@@ -101,32 +185,26 @@ static void nfc_supported_cards_load_context_free(NfcSupportedCardsLoadContext*
     storage_dir_close(instance->directory);
     storage_file_free(instance->directory);
 
-    furi_record_close(RECORD_STORAGE);
     free(instance);
 }
 
-static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
-    NfcSupportedCardsLoadContext* instance,
-    const char* name,
-    const ElfApiInterface* api_interface) {
-    furi_assert(instance);
+static const NfcSupportedCardsPlugin* nfc_supported_cards_load_plugin(
+    FlipperApplication* app,
+    const char* name) {
+    furi_assert(app);
     furi_assert(name);
 
     const NfcSupportedCardsPlugin* plugin = NULL;
     FuriString* plugin_path = furi_string_alloc_printf(
         "%s/%s%s", NFC_SUPPORTED_CARDS_PLUGINS_PATH, name, NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
     do {
-        if(instance->app) flipper_application_free(instance->app);
-        instance->app = flipper_application_alloc(instance->storage, api_interface);
-
-        if(flipper_application_preload(instance->app, furi_string_get_cstr(plugin_path)) !=
+        if(flipper_application_preload(app, furi_string_get_cstr(plugin_path)) !=
            FlipperApplicationPreloadStatusSuccess)
             break;
-        if(!flipper_application_is_plugin(instance->app)) break;
-        if(flipper_application_map_to_memory(instance->app) != FlipperApplicationLoadStatusSuccess)
-            break;
+        if(!flipper_application_is_plugin(app)) break;
+        if(flipper_application_map_to_memory(app) != FlipperApplicationLoadStatusSuccess) break;
         const FlipperAppPluginDescriptor* descriptor =
-            flipper_application_plugin_get_descriptor(instance->app);
+            flipper_application_plugin_get_descriptor(app);
 
         if(descriptor == NULL) break;
 
@@ -140,35 +218,178 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
     return plugin;
 }
 
-static const NfcSupportedCardsPlugin* nfc_supported_cards_get_next_plugin(
-    NfcSupportedCardsLoadContext* instance,
-    const ElfApiInterface* api_interface) {
-    const NfcSupportedCardsPlugin* plugin = NULL;
+static bool nfc_supported_cards_get_next_plugin_name(NfcSupportedCardsLoadContext* instance) {
+    bool name_found = false;
 
-    do {
-        if(!storage_file_is_open(instance->directory)) break;
+    while(storage_file_is_open(instance->directory)) {
         if(!storage_dir_read(
-               instance->directory, NULL, instance->file_name, sizeof(instance->file_name)))
+               instance->directory,
+               &instance->file_info,
+               instance->file_name,
+               sizeof(instance->file_name)))
             break;
 
         const size_t suffix_len = strlen(NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
         const size_t file_name_len = strlen(instance->file_name);
-        if(file_name_len <= suffix_len) break;
+        if(file_name_len <= suffix_len) continue;
 
         size_t suffix_start_pos = file_name_len - suffix_len;
         if(memcmp(
                &instance->file_name[suffix_start_pos],
                NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX,
                suffix_len) != 0) //-V1051
-            break;
+            continue;
 
         // Trim suffix from file_name to save memory. The suffix will be concatenated on plugin load.
         instance->file_name[suffix_start_pos] = '\0';
+        name_found = true;
+        break;
+    }
+
+    return name_found;
+}
 
-        plugin = nfc_supported_cards_get_plugin(instance, instance->file_name, api_interface);
-    } while(plugin == NULL); //-V654
+static bool nfc_supported_cards_index_load(
+    Storage* storage,
+    NfcSupportedCardsPluginCache_t cache_arr) {
+    bool index_loaded = false;
+    File* file = storage_file_alloc(storage);
+    char name[UINT8_MAX + 1];
 
-    return plugin;
+    do {
+        if(!storage_file_open(
+               file, NFC_SUPPORTED_CARDS_INDEX_PATH, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        NfcSupportedCardsIndexHeader header = {};
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != NFC_SUPPORTED_CARDS_INDEX_MAGIC) break;
+        if(header.version != NFC_SUPPORTED_CARDS_INDEX_VERSION) break;
+        if(header.api_version != NFC_SUPPORTED_CARD_PLUGIN_API_VERSION) break;
+
+        uint32_t i = 0;
+        for(; i < header.count; i++) {
+            NfcSupportedCardsIndexRecord record = {};
+            if(storage_file_read(file, &record, sizeof(record)) != sizeof(record)) break;
+            if(record.protocol >= NfcProtocolNum) break;
+            if(storage_file_read(file, name, record.name_len) != record.name_len) break;
+            name[record.name_len] = '\0';
+
+            const size_t signatures_size =
+                record.signatures_count * sizeof(NfcSupportedCardPluginSignature);
+            NfcSupportedCardsPluginCache plugin_cache = {
+                .name = furi_string_alloc_set(name),
+                .file_size = record.file_size,
+                .protocol = record.protocol,
+                .feature = record.feature,
+                .signatures_count = record.signatures_count,
+            };
+            if(signatures_size > 0) {
+                plugin_cache.signatures = malloc(signatures_size);
+            }
+            // Pushed before reading the signatures, so that the buffer is freed on failure
+            NfcSupportedCardsPluginCache_push_back(cache_arr, plugin_cache);
+            if((signatures_size > 0) &&
+               (storage_file_read(file, plugin_cache.signatures, signatures_size) !=
+                signatures_size))
+                break;
+        }
+        if(i != header.count) break;
+
+        index_loaded = true;
+    } while(false);
+
+    if(!index_loaded) {
+        nfc_supported_cards_plugins_cache_reset(cache_arr);
+    }
+
+    storage_file_free(file);
+
+    return index_loaded;
+}
+
+static void nfc_supported_cards_index_save(
+    Storage* storage,
+    NfcSupportedCardsPluginCache_t cache_arr) {
+    bool index_saved = false;
+    File* file = storage_file_alloc(storage);
+
+    do {
+        if(!storage_file_open(
+               file, NFC_SUPPORTED_CARDS_INDEX_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+
+        NfcSupportedCardsIndexHeader header = {
+            .magic = NFC_SUPPORTED_CARDS_INDEX_MAGIC,
+            .version = NFC_SUPPORTED_CARDS_INDEX_VERSION,
+            .api_version = NFC_SUPPORTED_CARD_PLUGIN_API_VERSION,
+            .count = NfcSupportedCardsPluginCache_size(cache_arr),
+        };
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        bool records_saved = true;
+        NfcSupportedCardsPluginCache_it_t iter;
+        for(NfcSupportedCardsPluginCache_it(iter, cache_arr);
+            !NfcSupportedCardsPluginCache_end_p(iter);
+            NfcSupportedCardsPluginCache_next(iter)) {
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cref(iter);
+            NfcSupportedCardsIndexRecord record = {
+                .file_size = plugin_cache->file_size,
+                .protocol = plugin_cache->protocol,
+                .feature = plugin_cache->feature,
+                .name_len = furi_string_size(plugin_cache->name),
+                .signatures_count = plugin_cache->signatures_count,
+            };
+            const size_t signatures_size =
+                record.signatures_count * sizeof(NfcSupportedCardPluginSignature);
+            if((storage_file_write(file, &record, sizeof(record)) != sizeof(record)) ||
+               (storage_file_write(
+                    file, furi_string_get_cstr(plugin_cache->name), record.name_len) !=
+                record.name_len) ||
+               ((signatures_size > 0) &&
+                (storage_file_write(file, plugin_cache->signatures, signatures_size) !=
+                 signatures_size))) {
+                records_saved = false;
+                break;
+            }
+        }
+        if(!records_saved) break;
+
+        index_saved = true;
+    } while(false);
+
+    storage_file_free(file);
+
+    if(!index_saved) {
+        FURI_LOG_W(TAG, "Failed to save plugin index");
+        storage_simply_remove(storage, NFC_SUPPORTED_CARDS_INDEX_PATH);
+    }
+}
+
+static bool nfc_supported_cards_index_lookup(
+    NfcSupportedCardsPluginCache_t index_arr,
+    const char* name,
+    uint64_t file_size,
+    NfcSupportedCardsPluginCache* plugin_cache) {
+    bool entry_found = false;
+
+    NfcSupportedCardsPluginCache_it_t iter;
+    for(NfcSupportedCardsPluginCache_it(iter, index_arr);
+        !NfcSupportedCardsPluginCache_end_p(iter);
+        NfcSupportedCardsPluginCache_next(iter)) {
+        const NfcSupportedCardsPluginCache* entry = NfcSupportedCardsPluginCache_cref(iter);
+        if((entry->file_size == file_size) && furi_string_equal_str(entry->name, name)) {
+            plugin_cache->protocol = entry->protocol;
+            plugin_cache->feature = entry->feature;
+            nfc_supported_cards_plugin_cache_set_signatures(
+                plugin_cache, entry->signatures, entry->signatures_count);
+            entry_found = true;
+            break;
+        }
+    }
+
+    return entry_found;
 }
 
 void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
@@ -179,33 +400,63 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
            (instance->load_state == NfcSupportedCardsLoadStateFail))
             break;
 
-        instance->load_context = nfc_supported_cards_load_context_alloc();
+        // Plugin features are taken from the index unless the plugin file has changed,
+        // so that the plugins don't have to be loaded one by one on every start.
+        NfcSupportedCardsPluginCache_t index_arr;
+        NfcSupportedCardsPluginCache_init(index_arr);
+        bool index_valid = nfc_supported_cards_index_load(instance->storage, index_arr);
 
-        while(true) {
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin =
-                nfc_supported_cards_get_next_plugin(instance->load_context, api_interface);
-            if(plugin == NULL) break; //-V547
+        instance->load_context = nfc_supported_cards_load_context_alloc(instance->storage);
 
+        while(nfc_supported_cards_get_next_plugin_name(instance->load_context)) {
+            const char* file_name = instance->load_context->file_name;
             NfcSupportedCardsPluginCache plugin_cache = {}; //-V779
-            plugin_cache.name = furi_string_alloc_set(instance->load_context->file_name);
-            plugin_cache.protocol = plugin->protocol;
-            if(plugin->verify) {
-                plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasVerify;
-            }
-            if(plugin->read) {
-                plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasRead;
-            }
-            if(plugin->parse) {
-                plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasParse;
+            plugin_cache.file_size = instance->load_context->file_info.size;
+
+            if(!nfc_supported_cards_index_lookup(
+                   index_arr, file_name, plugin_cache.file_size, &plugin_cache)) {
+                index_valid = false;
+
+                if(instance->load_context->app) {
+                    flipper_application_free(instance->load_context->app);
+                }
+                instance->load_context->app = flipper_application_alloc(
+                    instance->storage, composite_api_resolver_get(instance->api_resolver));
+                const NfcSupportedCardsPlugin* plugin =
+                    nfc_supported_cards_load_plugin(instance->load_context->app, file_name);
+                if(plugin == NULL) continue;
+
+                plugin_cache.protocol = plugin->protocol;
+                if(plugin->verify) {
+                    plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasVerify;
+                }
+                if(plugin->read) {
+                    plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasRead;
+                }
+                if(plugin->parse) {
+                    plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasParse;
+                }
+                nfc_supported_cards_plugin_cache_set_signatures(
+                    &plugin_cache, plugin->signatures, plugin->signatures_count);
             }
+
+            plugin_cache.name = furi_string_alloc_set(file_name);
             NfcSupportedCardsPluginCache_push_back(instance->plugins_cache_arr, plugin_cache);
         }
 
         nfc_supported_cards_load_context_free(instance->load_context);
+        instance->load_context = NULL;
 
         size_t plugins_loaded = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
+        if(plugins_loaded != NfcSupportedCardsPluginCache_size(index_arr)) {
+            index_valid = false;
+        }
+        if(!index_valid && (plugins_loaded > 0)) {
+            nfc_supported_cards_index_save(instance->storage, instance->plugins_cache_arr);
+        }
+        nfc_supported_cards_plugins_cache_reset(index_arr);
+        NfcSupportedCardsPluginCache_clear(index_arr);
+
         if(plugins_loaded == 0) {
             FURI_LOG_D(TAG, "Plugins not found");
             instance->load_state = NfcSupportedCardsLoadStateFail;
@@ -217,91 +468,291 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
     } while(false);
 }
 
-bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nfc* nfc) {
-    furi_assert(instance);
-    furi_assert(device);
-    furi_assert(nfc);
+static const NfcSupportedCardsPlugin*
+    nfc_supported_cards_get_plugin(NfcSupportedCards* instance, size_t cache_idx) {
+    NfcSupportedCardsResidentPlugin resident = {};
+    size_t resident_idx = 0;
 
-    bool card_read = false;
-    NfcProtocol protocol = nfc_device_get_protocol(device);
+    for(; resident_idx < instance->resident_count; resident_idx++) {
+        if(instance->resident[resident_idx].cache_idx == cache_idx) break;
+    }
 
-    do {
-        if(instance->load_state != NfcSupportedCardsLoadStateSuccess) break;
+    if(resident_idx < instance->resident_count) {
+        resident = instance->resident[resident_idx];
+    } else {
+        // Evict the least recently used plugin first to free its memory for the new one
+        if(instance->resident_count == NFC_SUPPORTED_CARDS_RESIDENT_MAX) {
+            instance->resident_count--;
+            flipper_application_free(instance->resident[instance->resident_count].app);
+        }
 
-        instance->load_context = nfc_supported_cards_load_context_alloc();
+        const NfcSupportedCardsPluginCache* plugin_cache =
+            NfcSupportedCardsPluginCache_cget(instance->plugins_cache_arr, cache_idx);
+        resident.cache_idx = cache_idx;
+        resident.app = flipper_application_alloc(
+            instance->storage, composite_api_resolver_get(instance->api_resolver));
+        resident.plugin = nfc_supported_cards_load_plugin(
+            resident.app, furi_string_get_cstr(plugin_cache->name));
+        if(resident.plugin == NULL) {
+            flipper_application_free(resident.app);
+            return NULL;
+        }
 
-        NfcSupportedCardsPluginCache_it_t iter;
-        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
-            !NfcSupportedCardsPluginCache_end_p(iter);
-            NfcSupportedCardsPluginCache_next(iter)) {
-            NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
-            if(plugin_cache->protocol != protocol) continue;
-            if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasRead) == 0) continue;
-
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
-            if(plugin == NULL) continue;
+        resident_idx = instance->resident_count++;
+    }
 
-            if(plugin->verify) {
-                if(!plugin->verify(nfc)) continue;
-            }
+    // Move to the front
+    memmove(
+        &instance->resident[1],
+        &instance->resident[0],
+        resident_idx * sizeof(NfcSupportedCardsResidentPlugin));
+    instance->resident[0] = resident;
 
-            if(plugin->read) {
-                if(plugin->read(nfc, device)) {
-                    card_read = true;
-                    break;
-                }
-            }
+    return resident.plugin;
+}
+
+static bool nfc_supported_cards_check_key(
+    NfcSupportedCards* instance,
+    Nfc* nfc,
+    const NfcSupportedCardPluginSignature* signature) {
+    for(size_t i = 0; i < instance->key_checks_count; i++) {
+        const NfcSupportedCardsKeyCheck* key_check = &instance->key_checks[i];
+        if((key_check->sector == signature->sector) &&
+           (key_check->key_type == signature->key_type) && (key_check->key == signature->value)) {
+            return key_check->is_valid;
         }
+    }
 
-        nfc_supported_cards_load_context_free(instance->load_context);
-    } while(false);
+    MfClassicKey key = {};
+    bit_lib_num_to_bytes_be(signature->value, COUNT_OF(key.data), key.data);
+    const uint8_t block_num = mf_classic_get_first_block_num_of_sector(signature->sector);
+    MfClassicError error =
+        mf_classic_poller_sync_auth(nfc, block_num, &key, signature->key_type, NULL);
+    const bool is_valid = (error == MfClassicErrorNone);
+
+    if(instance->key_checks_count < NFC_SUPPORTED_CARDS_KEY_CHECK_MAX) {
+        NfcSupportedCardsKeyCheck* key_check = &instance->key_checks[instance->key_checks_count++];
+        key_check->sector = signature->sector;
+        key_check->key_type = signature->key_type;
+        key_check->key = signature->value;
+        key_check->is_valid = is_valid;
+    }
 
-    return card_read;
+    return is_valid;
 }
 
-bool nfc_supported_cards_parse(
+static bool nfc_supported_cards_check_data(
+    const NfcDevice* device,
+    const NfcSupportedCardPluginSignature* signature) {
+    bool is_valid = false;
+
+    if(signature->type == NfcSupportedCardPluginSignatureTypeMfClassicKey) {
+        const MfClassicData* data = nfc_device_get_data(device, NfcProtocolMfClassic);
+        if(signature->sector < mf_classic_get_total_sectors_num(data->type)) {
+            const MfClassicSectorTrailer* sec_tr =
+                mf_classic_get_sector_trailer_by_sector(data, signature->sector);
+            const MfClassicKey* key = (signature->key_type == MfClassicKeyTypeA) ?
+                                          &sec_tr->key_a :
+                                          &sec_tr->key_b;
+            is_valid = (bit_lib_bytes_to_num_be(key->data, COUNT_OF(key->data)) ==
+                        signature->value);
+        }
+    } else if(signature->type == NfcSupportedCardPluginSignatureTypeMfDesfireApp) {
+        const MfDesfireData* data = nfc_device_get_data(device, NfcProtocolMfDesfire);
+        MfDesfireApplicationId app_id = {};
+        bit_lib_num_to_bytes_be(signature->value, COUNT_OF(app_id.data), app_id.data);
+        is_valid = (mf_desfire_get_application(data, &app_id) != NULL);
+    }
+
+    return is_valid;
+}
+
+static bool nfc_supported_cards_check_signature(
     NfcSupportedCards* instance,
-    NfcDevice* device,
-    FuriString* parsed_data) {
-    furi_assert(instance);
-    furi_assert(device);
-    furi_assert(parsed_data);
+    NfcProtocol protocol,
+    const NfcSupportedCardPluginSignature* signature,
+    const NfcSupportedCardsMatchContext* match_context) {
+    bool is_valid = false;
+
+    if((signature->type == NfcSupportedCardPluginSignatureTypeMfClassicKey) &&
+       (protocol == NfcProtocolMfClassic) &&
+       (signature->sector < MF_CLASSIC_TOTAL_SECTORS_MAX)) {
+        is_valid = match_context->device ?
+                       nfc_supported_cards_check_data(match_context->device, signature) :
+                       nfc_supported_cards_check_key(instance, match_context->nfc, signature);
+    } else if(
+        (signature->type == NfcSupportedCardPluginSignatureTypeMfDesfireApp) &&
+        (protocol == NfcProtocolMfDesfire)) {
+        // Applications can only be checked in the read data, verify() does the rest
+        is_valid = match_context->device ?
+                       nfc_supported_cards_check_data(match_context->device, signature) :
+                       true;
+    }
 
-    bool card_parsed = false;
-    NfcProtocol protocol = nfc_device_get_protocol(device);
+    return is_valid;
+}
+
+static bool nfc_supported_cards_plugin_is_suitable(
+    NfcSupportedCards* instance,
+    size_t cache_idx,
+    NfcProtocol protocol,
+    NfcSupportedCardsPluginFeature feature,
+    const NfcSupportedCardsMatchContext* match_context) {
+    const NfcSupportedCardsPluginCache* plugin_cache =
+        NfcSupportedCardsPluginCache_cget(instance->plugins_cache_arr, cache_idx);
+    bool is_suitable = (plugin_cache->protocol == protocol) &&
+                       ((plugin_cache->feature & feature) != 0);
+
+    // Plugins without signatures can't be ruled out without loading them
+    if(is_suitable && (plugin_cache->signatures_count > 0)) {
+        is_suitable = false;
+        for(size_t i = 0; (i < plugin_cache->signatures_count) && !is_suitable; i++) {
+            is_suitable = nfc_supported_cards_check_signature(
+                instance, protocol, &plugin_cache->signatures[i], match_context);
+        }
+    }
+
+    return is_suitable;
+}
+
+static bool nfc_supported_cards_dispatch(
+    NfcSupportedCards* instance,
+    NfcProtocol protocol,
+    NfcSupportedCardsPluginFeature feature,
+    const NfcSupportedCardsMatchContext* match_context,
+    NfcSupportedCardsPluginHandler handler,
+    void* context) {
+    bool handled = false;
 
     do {
         if(instance->load_state != NfcSupportedCardsLoadStateSuccess) break;
 
-        instance->load_context = nfc_supported_cards_load_context_alloc();
+        instance->key_checks_count = 0;
 
-        NfcSupportedCardsPluginCache_it_t iter;
-        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
-            !NfcSupportedCardsPluginCache_end_p(iter);
-            NfcSupportedCardsPluginCache_next(iter)) {
-            NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
-            if(plugin_cache->protocol != protocol) continue;
-            if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasParse) == 0) continue;
-
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+        // Resident plugins go first: in a session it's most likely the same kind of card
+        size_t tried_idx[NFC_SUPPORTED_CARDS_RESIDENT_MAX] = {};
+        size_t tried_count = 0;
+        for(size_t i = 0; i < instance->resident_count; i++) {
+            tried_idx[tried_count++] = instance->resident[i].cache_idx;
+        }
+        for(size_t i = 0; (i < tried_count) && !handled; i++) {
+            if(!nfc_supported_cards_plugin_is_suitable(
+                   instance, tried_idx[i], protocol, feature, match_context))
+                continue;
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_get_plugin(instance, tried_idx[i]);
             if(plugin == NULL) continue;
+            handled = handler(plugin, context);
+        }
 
-            if(plugin->parse) {
-                if(plugin->parse(device, parsed_data)) {
-                    card_parsed = true;
+        size_t plugins_count = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
+        for(size_t cache_idx = 0; (cache_idx < plugins_count) && !handled; cache_idx++) {
+            if(!nfc_supported_cards_plugin_is_suitable(
+                   instance, cache_idx, protocol, feature, match_context))
+                continue;
+
+            bool already_tried = false;
+            for(size_t i = 0; i < tried_count; i++) {
+                if(tried_idx[i] == cache_idx) {
+                    already_tried = true;
                     break;
                 }
             }
+            if(already_tried) continue;
+
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_get_plugin(instance, cache_idx);
+            if(plugin == NULL) continue;
+            handled = handler(plugin, context);
         }
+    } while(false);
 
-        nfc_supported_cards_load_context_free(instance->load_context);
+    return handled;
+}
+
+typedef struct {
+    NfcDevice* device;
+    Nfc* nfc;
+} NfcSupportedCardsReadContext;
+
+static bool
+    nfc_supported_cards_read_handler(const NfcSupportedCardsPlugin* plugin, void* context) {
+    NfcSupportedCardsReadContext* read_context = context;
+    bool card_read = false;
+
+    do {
+        if(plugin->verify) {
+            if(!plugin->verify(read_context->nfc)) break;
+        }
+
+        if(plugin->read) {
+            card_read = plugin->read(read_context->nfc, read_context->device);
+        }
     } while(false);
 
+    return card_read;
+}
+
+bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nfc* nfc) {
+    furi_assert(instance);
+    furi_assert(device);
+    furi_assert(nfc);
+
+    NfcSupportedCardsReadContext read_context = {
+        .device = device,
+        .nfc = nfc,
+    };
+    NfcSupportedCardsMatchContext match_context = {
+        .nfc = nfc,
+    };
+
+    return nfc_supported_cards_dispatch(
+        instance,
+        nfc_device_get_protocol(device),
+        NfcSupportedCardsPluginFeatureHasRead,
+        &match_context,
+        nfc_supported_cards_read_handler,
+        &read_context);
+}
+
+typedef struct {
+    NfcDevice* device;
+    FuriString* parsed_data;
+} NfcSupportedCardsParseContext;
+
+static bool
+    nfc_supported_cards_parse_handler(const NfcSupportedCardsPlugin* plugin, void* context) {
+    NfcSupportedCardsParseContext* parse_context = context;
+    bool card_parsed = false;
+
+    if(plugin->parse) {
+        card_parsed = plugin->parse(parse_context->device, parse_context->parsed_data);
+    }
+
     return card_parsed;
 }
+
+bool nfc_supported_cards_parse(
+    NfcSupportedCards* instance,
+    NfcDevice* device,
+    FuriString* parsed_data) {
+    furi_assert(instance);
+    furi_assert(device);
+    furi_assert(parsed_data);
+
+    NfcSupportedCardsParseContext parse_context = {
+        .device = device,
+        .parsed_data = parsed_data,
+    };
+    NfcSupportedCardsMatchContext match_context = {
+        .device = device,
+    };
+
+    return nfc_supported_cards_dispatch(
+        instance,
+        nfc_device_get_protocol(device),
+        NfcSupportedCardsPluginFeatureHasParse,
+        &match_context,
+        nfc_supported_cards_parse_handler,
+        &parse_context);
+}
@@ -30,6 +30,7 @@
 #include "helpers/mf_ultralight_auth.h"
 #include "helpers/mf_user_dict.h"
 #include "helpers/mfkey32_logger.h"
+#include "helpers/mfkey32_recovery.h"
 #include "helpers/mf_classic_key_cache.h"
 #include "helpers/nfc_supported_cards.h"
 #include "helpers/felica_auth.h"
@@ -160,6 +161,7 @@ struct NfcApp {
     NfcMfClassicDictAttackContext nfc_dict_context;
     NfcMfUltralightCDictContext mf_ultralight_c_dict_context;
     Mfkey32Logger* mfkey32_logger;
+    Mfkey32Recovery* mfkey32_recovery;
     MfUserDict* mf_user_dict;
     MfClassicKeyCache* mfc_key_cache;
     NfcSupportedCards* nfc_supported_cards;
@@ -149,11 +149,17 @@ static bool aime_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature aime_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(0, MfClassicKeyTypeA, 0x574343467632),
+};
+
 static const NfcSupportedCardsPlugin aime_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = aime_verify,
     .read = aime_read,
     .parse = aime_parse,
+    .signatures = aime_signatures,
+    .signatures_count = COUNT_OF(aime_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
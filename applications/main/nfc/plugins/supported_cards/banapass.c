@@ -264,11 +264,17 @@ static bool banapass_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature banapass_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(0, MfClassicKeyTypeA, 0x6090D00632F5),
+};
+
 static const NfcSupportedCardsPlugin banapass_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = banapass_verify,
     .read = banapass_read,
     .parse = banapass_parse,
+    .signatures = banapass_signatures,
+    .signatures_count = COUNT_OF(banapass_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
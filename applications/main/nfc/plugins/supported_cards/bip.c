@@ -349,11 +349,17 @@ static bool bip_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature bip_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(0, MfClassicKeyTypeA, 0x3a42f33af429),
+};
+
 static const NfcSupportedCardsPlugin bip_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = bip_verify,
     .read = bip_read,
     .parse = bip_parse,
+    .signatures = bip_signatures,
+    .signatures_count = COUNT_OF(bip_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
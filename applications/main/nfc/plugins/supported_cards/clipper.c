@@ -621,11 +621,18 @@ static void epoch_1900_datetime_to_furi(uint32_t seconds, DateTime* out) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature clipper_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_DESFIRE_APP(0x9011f2),
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_DESFIRE_APP(0x9111f2),
+};
+
 static const NfcSupportedCardsPlugin clipper_plugin = {
     .protocol = NfcProtocolMfDesfire,
     .verify = NULL,
     .read = NULL,
     .parse = clipper_parse,
+    .signatures = clipper_signatures,
+    .signatures_count = COUNT_OF(clipper_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -206,11 +206,17 @@ static bool hi_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature hi_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(0, MfClassicKeyTypeB, 0x30871CF60CF1),
+};
+
 static const NfcSupportedCardsPlugin hi_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = hi_verify,
     .read = hi_read,
     .parse = hi_parse,
+    .signatures = hi_signatures,
+    .signatures_count = COUNT_OF(hi_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -133,11 +133,17 @@ static bool hid_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature hid_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(1, MfClassicKeyTypeA, 0x484944204953),
+};
+
 static const NfcSupportedCardsPlugin hid_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = hid_verify,
     .read = hid_read,
     .parse = hid_parse,
+    .signatures = hid_signatures,
+    .signatures_count = COUNT_OF(hid_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -223,11 +223,17 @@ bool hworld_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature hworld_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(1, MfClassicKeyTypeA, 0x543071543071),
+};
+
 static const NfcSupportedCardsPlugin hworld_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = hworld_verify,
     .read = hworld_read,
     .parse = hworld_parse,
+    .signatures = hworld_signatures,
+    .signatures_count = COUNT_OF(hworld_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
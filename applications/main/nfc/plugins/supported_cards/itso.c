@@ -108,11 +108,17 @@ static bool itso_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature itso_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_DESFIRE_APP(0x1602a0),
+};
+
 static const NfcSupportedCardsPlugin itso_plugin = {
     .protocol = NfcProtocolMfDesfire,
     .verify = NULL,
     .read = NULL,
     .parse = itso_parse,
+    .signatures = itso_signatures,
+    .signatures_count = COUNT_OF(itso_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -237,11 +237,17 @@ static bool mizip_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature mizip_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(0, MfClassicKeyTypeB, 0xb4c132439eef),
+};
+
 static const NfcSupportedCardsPlugin mizip_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = mizip_verify,
     .read = mizip_read,
     .parse = mizip_parse,
+    .signatures = mizip_signatures,
+    .signatures_count = COUNT_OF(mizip_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -96,11 +96,17 @@ static bool myki_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature myki_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_DESFIRE_APP(0x0011f2),
+};
+
 static const NfcSupportedCardsPlugin myki_plugin = {
     .protocol = NfcProtocolMfDesfire,
     .verify = NULL,
     .read = NULL,
     .parse = myki_parse,
+    .signatures = myki_signatures,
+    .signatures_count = COUNT_OF(myki_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -36,7 +36,7 @@
 /**
  * @brief Currently supported plugin API version.
  */
-#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 1
+#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 2
 
 /**
  * @brief Verify that the card is of a supported type.
@@ -81,14 +81,60 @@ typedef bool (*NfcSupportedCardPluginRead)(Nfc* nfc, NfcDevice* device);
  */
 typedef bool (*NfcSupportedCardPluginParse)(const NfcDevice* device, FuriString* parsed_data);
 
+/**
+ * @brief Kinds of card signatures a plugin may declare.
+ */
+typedef enum {
+    NfcSupportedCardPluginSignatureTypeMfClassicKey, /**< MfClassic sector key. */
+    NfcSupportedCardPluginSignatureTypeMfDesfireApp, /**< MfDesfire application id. */
+} NfcSupportedCardPluginSignatureType;
+
+/**
+ * @brief Declarative card signature.
+ *
+ * Signatures are stored in the plugin index, so that the application can rule a
+ * plugin out without loading it. A card is considered suitable for the plugin if it
+ * matches any of the plugin's signatures. A signature is a necessary condition only:
+ * the verify() and parse() functions still have to perform their own checks.
+ */
+typedef struct {
+    uint8_t type; /**< Signature type, one of NfcSupportedCardPluginSignatureType. */
+    uint8_t sector; /**< MfClassic sector number the key belongs to. */
+    uint8_t key_type; /**< MfClassicKeyType of the key. */
+    uint64_t value; /**< Key or application id, most significant byte first. */
+} NfcSupportedCardPluginSignature;
+
+/**
+ * @brief Declare an MfClassic card which can be authenticated with a given key.
+ */
+#define NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(sector_num, type, key) \
+    {                                                                      \
+        .type = NfcSupportedCardPluginSignatureTypeMfClassicKey,           \
+        .sector = (sector_num),                                            \
+        .key_type = (type),                                                \
+        .value = (key),                                                    \
+    }
+
+/**
+ * @brief Declare an MfDesfire card which has a given application.
+ */
+#define NFC_SUPPORTED_CARD_SIGNATURE_MF_DESFIRE_APP(app_id)      \
+    {                                                            \
+        .type = NfcSupportedCardPluginSignatureTypeMfDesfireApp, \
+        .value = (app_id),                                       \
+    }
+
 /**
  * @brief Supported card plugin interface.
  *
  * For a minimally functional plugin, only the parse() function must be implemented.
+ * Plugins without signatures are tried on every card of their protocol.
  */
 typedef struct {
     NfcProtocol protocol; /**< Identifier of the protocol this card type works on top of. */
     NfcSupportedCardPluginVerify verify; /**< Pointer to the verify() function. */
     NfcSupportedCardPluginRead read; /**< Pointer to the read() function. */
     NfcSupportedCardPluginParse parse; /**< Pointer to the parse() function. */
+    const NfcSupportedCardPluginSignature* signatures; /**< Card signatures, may be NULL. */
+    size_t signatures_count; /**< Number of elements in the signatures array. */
 } NfcSupportedCardsPlugin;
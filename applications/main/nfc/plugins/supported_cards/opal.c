@@ -213,11 +213,17 @@ static bool opal_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature opal_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_DESFIRE_APP(0x314553),
+};
+
 static const NfcSupportedCardsPlugin opal_plugin = {
     .protocol = NfcProtocolMfDesfire,
     .verify = NULL,
     .read = NULL,
     .parse = opal_parse,
+    .signatures = opal_signatures,
+    .signatures_count = COUNT_OF(opal_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
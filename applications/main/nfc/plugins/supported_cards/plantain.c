@@ -386,11 +386,17 @@ static bool plantain_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature plantain_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(8, MfClassicKeyTypeA, 0x26973ea74321),
+};
+
 static const NfcSupportedCardsPlugin plantain_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = plantain_verify,
     .read = plantain_read,
     .parse = plantain_parse,
+    .signatures = plantain_signatures,
+    .signatures_count = COUNT_OF(plantain_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
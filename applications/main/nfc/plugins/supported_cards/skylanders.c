@@ -193,11 +193,17 @@ static bool skylanders_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature skylanders_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(0, MfClassicKeyTypeA, 0x4b0b20107ccb),
+};
+
 static const NfcSupportedCardsPlugin skylanders_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = skylanders_verify,
     .read = skylanders_read,
     .parse = skylanders_parse,
+    .signatures = skylanders_signatures,
+    .signatures_count = COUNT_OF(skylanders_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -281,11 +281,17 @@ static bool social_moscow_parse(const NfcDevice* device, FuriString* parsed_data
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature social_moscow_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(15, MfClassicKeyTypeA, 0xa0a1a2a3a4a5),
+};
+
 static const NfcSupportedCardsPlugin social_moscow_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = social_moscow_verify,
     .read = social_moscow_read,
     .parse = social_moscow_parse,
+    .signatures = social_moscow_signatures,
+    .signatures_count = COUNT_OF(social_moscow_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -231,11 +231,18 @@ static bool troika_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature troika_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(11, MfClassicKeyTypeA, 0x08b386463229),
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(8, MfClassicKeyTypeA, 0xa73f5dc1d333),
+};
+
 static const NfcSupportedCardsPlugin troika_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = troika_verify,
     .read = troika_read,
     .parse = troika_parse,
+    .signatures = troika_signatures,
+    .signatures_count = COUNT_OF(troika_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -171,11 +171,17 @@ static bool two_cities_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature two_cities_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(4, MfClassicKeyTypeA, 0xe56ac127dd45),
+};
+
 static const NfcSupportedCardsPlugin two_cities_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = two_cities_verify,
     .read = two_cities_read,
     .parse = two_cities_parse,
+    .signatures = two_cities_signatures,
+    .signatures_count = COUNT_OF(two_cities_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
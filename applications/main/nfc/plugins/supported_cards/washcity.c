@@ -177,11 +177,17 @@ static bool washcity_parse(const NfcDevice* device, FuriString* parsed_data) {
 }
 
 /* Actual implementation of app<>plugin interface */
+static const NfcSupportedCardPluginSignature washcity_signatures[] = {
+    NFC_SUPPORTED_CARD_SIGNATURE_MF_CLASSIC_KEY(1, MfClassicKeyTypeA, 0xc78a3d0e1bcd),
+};
+
 static const NfcSupportedCardsPlugin washcity_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = washcity_verify,
     .read = washcity_read,
     .parse = washcity_parse,
+    .signatures = washcity_signatures,
+    .signatures_count = COUNT_OF(washcity_signatures),
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
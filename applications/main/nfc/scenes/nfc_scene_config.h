@@ -44,6 +44,7 @@ ADD_SCENE(nfc, mf_classic_dict_attack, MfClassicDictAttack)
 ADD_SCENE(nfc, mf_classic_detect_reader, MfClassicDetectReader)
 ADD_SCENE(nfc, mf_classic_mfkey_nonces_info, MfClassicMfkeyNoncesInfo)
 ADD_SCENE(nfc, mf_classic_mfkey_complete, MfClassicMfkeyComplete)
+ADD_SCENE(nfc, mf_classic_mfkey_recovery, MfClassicMfkeyRecovery)
 ADD_SCENE(nfc, mf_classic_update_initial, MfClassicUpdateInitial)
 ADD_SCENE(nfc, mf_classic_update_initial_success, MfClassicUpdateInitialSuccess)
 ADD_SCENE(nfc, mf_classic_update_initial_wrong_card, MfClassicUpdateInitialWrongCard)
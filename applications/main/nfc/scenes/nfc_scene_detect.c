@@ -27,6 +27,7 @@ void nfc_scene_detect_on_enter(void* context) {
     nfc_detected_protocols_reset(instance->detected_protocols);
 
     instance->scanner = nfc_scanner_alloc(instance->nfc);
+    nfc_scanner_set_mode(instance->scanner, NfcScannerModeFast);
     nfc_scanner_start(instance->scanner, nfc_scene_detect_scan_callback, instance);
 
     nfc_blink_detect_start(instance);
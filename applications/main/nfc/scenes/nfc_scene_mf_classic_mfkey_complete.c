@@ -62,6 +62,12 @@ void nfc_scene_mf_classic_mfkey_complete_on_enter(void* context) {
             nfc_scene_mf_classic_mfkey_complete_callback,
             instance);
     }
+    widget_add_button_element(
+        instance->widget,
+        GuiButtonTypeLeft,
+        "Crack",
+        nfc_scene_mf_classic_mfkey_complete_callback,
+        instance);
     view_dispatcher_switch_to_view(instance->view_dispatcher, NfcViewWidget);
 }
 
@@ -70,7 +76,10 @@ bool nfc_scene_mf_classic_mfkey_complete_on_event(void* context, SceneManagerEve
     bool consumed = false;
 
     if(event.type == SceneManagerEventTypeCustom) {
-        if(event.event == GuiButtonTypeRight) {
+        if(event.event == GuiButtonTypeLeft) {
+            scene_manager_next_scene(instance->scene_manager, NfcSceneMfClassicMfkeyRecovery);
+            consumed = true;
+        } else if(event.event == GuiButtonTypeRight) {
             NfcSceneMfClassicMfKeyCompleteState scene_state = scene_manager_get_scene_state(
                 instance->scene_manager, NfcSceneMfClassicMfkeyComplete);
             if(scene_state == NfcSceneMfClassicMfKeyCompleteStateAppMissing) {
@@ -0,0 +1,111 @@
+#include "../nfc_app_i.h"
+
+typedef enum {
+    NfcSceneMfClassicMfkeyRecoveryStateInProgress,
+    NfcSceneMfClassicMfkeyRecoveryStateFinished,
+} NfcSceneMfClassicMfkeyRecoveryState;
+
+static void nfc_scene_mf_classic_mfkey_recovery_callback(
+    Mfkey32RecoveryEventType type,
+    void* context) {
+    NfcApp* instance = context;
+
+    if(type == Mfkey32RecoveryEventTypeFinished) {
+        view_dispatcher_send_custom_event(instance->view_dispatcher, NfcCustomEventWorkerExit);
+    } else {
+        view_dispatcher_send_custom_event(instance->view_dispatcher, NfcCustomEventWorkerUpdate);
+    }
+}
+
+static void nfc_scene_mf_classic_mfkey_recovery_update_view(NfcApp* instance) {
+    Mfkey32RecoveryProgress progress = {};
+    mfkey32_recovery_get_progress(instance->mfkey32_recovery, &progress);
+
+    NfcSceneMfClassicMfkeyRecoveryState state = scene_manager_get_scene_state(
+        instance->scene_manager, NfcSceneMfClassicMfkeyRecovery);
+    if(state == NfcSceneMfClassicMfkeyRecoveryStateInProgress) {
+        nfc_text_store_set(
+            instance,
+            "Nonce pair %zu/%zu: %u%%\nKeys found: %zu",
+            progress.nonces_current,
+            progress.nonces_total,
+            progress.nonce_progress,
+            progress.keys_found);
+    } else if(progress.is_error) {
+        nfc_text_store_set(instance, "Recovery failed\nKeys found: %zu", progress.keys_found);
+    } else {
+        nfc_text_store_set(instance, "Keys found: %zu\nSaved to user dict", progress.keys_found);
+    }
+    popup_set_text(instance->popup, instance->text_store, 64, 28, AlignCenter, AlignTop);
+}
+
+void nfc_scene_mf_classic_mfkey_recovery_on_enter(void* context) {
+    NfcApp* instance = context;
+
+    scene_manager_set_scene_state(
+        instance->scene_manager,
+        NfcSceneMfClassicMfkeyRecovery,
+        NfcSceneMfClassicMfkeyRecoveryStateInProgress);
+
+    popup_set_header(instance->popup, "Recovering Keys", 64, 8, AlignCenter, AlignTop);
+
+    instance->mfkey32_recovery = mfkey32_recovery_alloc(instance->storage);
+    mfkey32_recovery_start(
+        instance->mfkey32_recovery,
+        NFC_APP_MFKEY32_LOGS_FILE_PATH,
+        NFC_APP_MF_CLASSIC_DICT_USER_PATH,
+        nfc_scene_mf_classic_mfkey_recovery_callback,
+        instance);
+    nfc_scene_mf_classic_mfkey_recovery_update_view(instance);
+
+    view_dispatcher_switch_to_view(instance->view_dispatcher, NfcViewPopup);
+    nfc_blink_read_start(instance);
+}
+
+bool nfc_scene_mf_classic_mfkey_recovery_on_event(void* context, SceneManagerEvent event) {
+    NfcApp* instance = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == NfcCustomEventWorkerUpdate) {
+            nfc_scene_mf_classic_mfkey_recovery_update_view(instance);
+            consumed = true;
+        } else if(event.event == NfcCustomEventWorkerExit) {
+            scene_manager_set_scene_state(
+                instance->scene_manager,
+                NfcSceneMfClassicMfkeyRecovery,
+                NfcSceneMfClassicMfkeyRecoveryStateFinished);
+            nfc_blink_stop(instance);
+
+            Mfkey32RecoveryProgress progress = {};
+            mfkey32_recovery_get_progress(instance->mfkey32_recovery, &progress);
+            if(progress.is_error) {
+                notification_message(instance->notifications, &sequence_error);
+                popup_set_header(instance->popup, "Failed!", 64, 8, AlignCenter, AlignTop);
+            } else {
+                notification_message(instance->notifications, &sequence_success);
+                popup_set_header(instance->popup, "Completed!", 64, 8, AlignCenter, AlignTop);
+            }
+            nfc_scene_mf_classic_mfkey_recovery_update_view(instance);
+            consumed = true;
+        }
+    } else if(event.type == SceneManagerEventTypeBack) {
+        const uint32_t prev_scenes[] = {NfcSceneSavedMenu, NfcSceneStart};
+        consumed = scene_manager_search_and_switch_to_previous_scene_one_of(
+            instance->scene_manager, prev_scenes, COUNT_OF(prev_scenes));
+    }
+
+    return consumed;
+}
+
+void nfc_scene_mf_classic_mfkey_recovery_on_exit(void* context) {
+    NfcApp* instance = context;
+
+    mfkey32_recovery_stop(instance->mfkey32_recovery);
+    mfkey32_recovery_free(instance->mfkey32_recovery);
+    instance->mfkey32_recovery = NULL;
+
+    nfc_blink_stop(instance);
+    popup_reset(instance->popup);
+    nfc_text_store_clear(instance);
+}
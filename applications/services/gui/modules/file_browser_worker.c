@@ -19,6 +19,10 @@
 #define FILE_NAME_LEN_MAX   256
 #define LONG_LOAD_THRESHOLD 100
 
+#define SNAPSHOT_ITEM_FOLDER  'd'
+#define SNAPSHOT_ITEM_FILE    'f'
+#define SNAPSHOT_HEAP_DIVIDER 2
+
 typedef enum {
     WorkerEvtStop = (1 << 0),
     WorkerEvtLoad = (1 << 1),
@@ -35,6 +39,14 @@ typedef enum {
 ARRAY_DEF(IdxLastArray, int32_t) //-V658
 ARRAY_DEF(ExtFilterArray, FuriString*, FURI_STRING_OPLIST) //-V658
 
+// Filtered and sorted listing of the current folder, paging is served from it
+typedef struct {
+    char* names; // Item type followed by zero terminated name, one after another
+    char** items;
+    uint32_t items_cnt;
+    bool is_valid;
+} BrowserSnapshot;
+
 struct BrowserWorker {
     FuriThread* thread;
 
@@ -48,6 +60,7 @@ struct BrowserWorker {
     bool hide_dot_files;
     IdxLastArray_t idx_last;
     ExtFilterArray_t ext_filter;
+    BrowserSnapshot snapshot;
 
     void* cb_ctx;
     BrowserWorkerFolderOpenCallback folder_cb;
@@ -142,6 +155,78 @@ static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, boo
     return false;
 }
 
+static void browser_snapshot_reset(BrowserSnapshot* snapshot) {
+    free(snapshot->names);
+    free(snapshot->items);
+    memset(snapshot, 0, sizeof(BrowserSnapshot));
+}
+
+static void browser_snapshot_build(
+    BrowserWorker* browser,
+    File* directory,
+    FuriString* path,
+    uint32_t items_cnt,
+    size_t names_size) {
+    BrowserSnapshot* snapshot = &browser->snapshot;
+    browser_snapshot_reset(snapshot);
+
+    // Sizes come from the counting pass, so the snapshot takes exactly what it needs.
+    // Folders that still don't fit are listed straight from the storage instead, so items
+    // are kept in directory order here too, whichever way the folder is listed.
+    size_t snapshot_size = names_size + items_cnt * sizeof(char*);
+    if(snapshot_size > memmgr_heap_get_max_free_block() / SNAPSHOT_HEAP_DIVIDER) {
+        FURI_LOG_W(TAG, "No memory for snapshot of %lu items", items_cnt);
+        return;
+    }
+
+    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
+        FileInfo file_info;
+        char name_temp[FILE_NAME_LEN_MAX];
+        FuriString* name_str = furi_string_alloc();
+        size_t names_used = 0;
+
+        snapshot->names = malloc(MAX(names_size, 1U));
+        snapshot->items = malloc(MAX(items_cnt, 1U) * sizeof(char*));
+
+        while(snapshot->items_cnt < items_cnt) {
+            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+                break;
+            }
+            if((storage_file_get_error(directory) != FSE_OK) || (name_temp[0] == '\0')) {
+                continue;
+            }
+
+            bool is_folder = file_info_is_dir(&file_info);
+            furi_string_set(name_str, name_temp);
+            if(!browser_filter_by_name(browser, name_str, is_folder)) continue;
+
+            // Folder contents may have changed since they were counted
+            size_t name_size = strlen(name_temp) + 2;
+            if(names_used + name_size > names_size) break;
+
+            char* item = &snapshot->names[names_used];
+            item[0] = is_folder ? SNAPSHOT_ITEM_FOLDER : SNAPSHOT_ITEM_FILE;
+            memcpy(&item[1], name_temp, name_size - 1);
+            snapshot->items[snapshot->items_cnt++] = item;
+            names_used += name_size;
+        }
+
+        furi_string_free(name_str);
+        snapshot->is_valid = true;
+    }
+
+    storage_dir_close(directory);
+}
+
+static int32_t browser_snapshot_find(BrowserSnapshot* snapshot, FuriString* name) {
+    for(uint32_t i = 0; i < snapshot->items_cnt; i++) {
+        if(furi_string_cmp_str(name, &snapshot->items[i][1]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 static bool browser_folder_check_and_switch(FuriString* path) {
     FileInfo file_info;
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -183,6 +268,7 @@ static bool browser_folder_init(
     char name_temp[FILE_NAME_LEN_MAX];
     FuriString* name_str;
     name_str = furi_string_alloc();
+    size_t names_size = 0;
 
     *item_cnt = 0;
     *file_idx = -1;
@@ -197,6 +283,7 @@ static bool browser_folder_init(
                 total_files_cnt++;
                 furi_string_set(name_str, name_temp);
                 if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+                    names_size += furi_string_size(name_str) + 2;
                     if(!furi_string_empty(filename)) {
                         if(furi_string_cmp(name_str, filename) == 0) {
                             *file_idx = *item_cnt;
@@ -217,15 +304,65 @@ static bool browser_folder_init(
     furi_string_free(name_str);
 
     storage_dir_close(directory);
+
+    if(state) {
+        browser_snapshot_build(browser, directory, path, *item_cnt, names_size);
+    } else {
+        browser_snapshot_reset(&browser->snapshot);
+    }
+
     storage_file_free(directory);
 
     furi_record_close(RECORD_STORAGE);
 
+    if(browser->snapshot.is_valid) {
+        *item_cnt = browser->snapshot.items_cnt;
+        if(!furi_string_empty(filename)) {
+            *file_idx = browser_snapshot_find(&browser->snapshot, filename);
+        }
+    }
+
     return state;
 }
 
+static bool browser_snapshot_load(
+    BrowserWorker* browser,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    BrowserSnapshot* snapshot = &browser->snapshot;
+    if(offset > snapshot->items_cnt) return false;
+
+    if(browser->list_load_cb) {
+        browser->list_load_cb(browser->cb_ctx, offset);
+    }
+
+    uint32_t items_cnt = MIN(count, snapshot->items_cnt - offset);
+    FuriString* name_str = furi_string_alloc();
+
+    for(uint32_t i = offset; i < offset + items_cnt; i++) {
+        const char* item = snapshot->items[i];
+        furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), &item[1]);
+        if(browser->list_item_cb) {
+            browser->list_item_cb(
+                browser->cb_ctx, name_str, item[0] == SNAPSHOT_ITEM_FOLDER, false);
+        }
+    }
+    if(browser->list_item_cb) {
+        browser->list_item_cb(browser->cb_ctx, NULL, false, true);
+    }
+
+    furi_string_free(name_str);
+
+    return items_cnt == count;
+}
+
 static bool
     browser_folder_load(BrowserWorker* browser, FuriString* path, uint32_t offset, uint32_t count) {
+    if(browser->snapshot.is_valid) {
+        return browser_snapshot_load(browser, path, offset, count);
+    }
+
     FileInfo file_info;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -449,6 +586,7 @@ void file_browser_worker_free(BrowserWorker* browser) {
 
     IdxLastArray_clear(browser->idx_last);
     ExtFilterArray_clear(browser->ext_filter);
+    browser_snapshot_reset(&browser->snapshot);
 
     free(browser);
 }
@@ -26,6 +26,9 @@ typedef enum {
 
 #define RPC_ALL_EVENTS (RpcEvtNewData | RpcEvtDisconnect)
 
+#define RPC_SEND_BUFFER_SIZE     (1024U)
+#define RPC_SEND_PREFIX_SIZE_MAX (5U) // Varint encoded uint32_t
+
 DICT_DEF2(RpcHandlerDict, pb_size_t, M_DEFAULT_OPLIST, RpcHandler, M_POD_OPLIST)
 
 typedef struct {
@@ -84,6 +87,10 @@ struct RpcSession {
     RpcSessionTerminatedCallback terminated_callback;
     RpcOwner owner;
     void* context;
+
+    // Outgoing message encoding, guarded by callbacks_mutex
+    uint8_t* send_buffer;
+    size_t send_buffer_size;
 };
 
 struct Rpc {
@@ -369,6 +376,7 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
     furi_mutex_release(session->callbacks_mutex);
 
     furi_mutex_free(session->callbacks_mutex);
+    free(session->send_buffer);
     furi_thread_join(session->thread);
     furi_thread_free(session->thread);
     free(session);
@@ -387,6 +395,7 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
 
     RpcSession* session = malloc(sizeof(RpcSession));
     session->callbacks_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    session->send_buffer = malloc(RPC_SEND_BUFFER_SIZE);
     session->stream = furi_stream_buffer_alloc(RPC_BUFFER_SIZE, 1);
     session->rpc = rpc;
     session->terminate = false;
@@ -454,36 +463,80 @@ void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* han
     RpcHandlerDict_set_at(session->handlers, message_tag, *handler);
 }
 
+static void rpc_send_bytes(RpcSession* session, uint8_t* data, size_t size) {
+#ifdef SRV_RPC_DEBUG
+    rpc_debug_print_data("OUTPUT", data, size);
+#endif
+
+    if(session->send_bytes_callback) {
+        session->send_bytes_callback(session->context, data, size);
+    }
+}
+
+static bool rpc_send_stream_callback(pb_ostream_t* stream, const pb_byte_t* buf, size_t count) {
+    RpcSession* session = stream->state;
+
+    while(count > 0) {
+        size_t chunk_size = MIN(count, RPC_SEND_BUFFER_SIZE - session->send_buffer_size);
+        memcpy(&session->send_buffer[session->send_buffer_size], buf, chunk_size);
+        session->send_buffer_size += chunk_size;
+        buf += chunk_size;
+        count -= chunk_size;
+
+        if(session->send_buffer_size == RPC_SEND_BUFFER_SIZE) {
+            rpc_send_bytes(session, session->send_buffer, session->send_buffer_size);
+            session->send_buffer_size = 0;
+        }
+    }
+
+    return true;
+}
+
 void rpc_send(RpcSession* session, PB_Main* message) {
     furi_assert(session);
     furi_assert(message);
 
-    pb_ostream_t ostream = PB_OSTREAM_SIZING;
-
 #ifdef SRV_RPC_DEBUG
     FURI_LOG_I(TAG, "OUTPUT:");
     rpc_debug_print_message(message);
 #endif
 
-    bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
-    furi_check(result && ostream.bytes_written);
+    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
 
-    uint8_t* buffer = malloc(ostream.bytes_written);
-    ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
+    // Most messages fit the session buffer: encode once behind the room left for the length
+    uint8_t* body = &session->send_buffer[RPC_SEND_PREFIX_SIZE_MAX];
+    pb_ostream_t ostream =
+        pb_ostream_from_buffer(body, RPC_SEND_BUFFER_SIZE - RPC_SEND_PREFIX_SIZE_MAX);
 
-    pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    if(pb_encode(&ostream, &PB_Main_msg, message)) {
+        size_t body_size = ostream.bytes_written;
 
-#ifdef SRV_RPC_DEBUG
-    rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
-#endif
+        uint8_t prefix[RPC_SEND_PREFIX_SIZE_MAX];
+        ostream = pb_ostream_from_buffer(prefix, sizeof(prefix));
+        pb_encode_varint(&ostream, body_size);
 
-    furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
-    if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
+        uint8_t* data = body - ostream.bytes_written;
+        memcpy(data, prefix, ostream.bytes_written);
+        rpc_send_bytes(session, data, ostream.bytes_written + body_size);
+    } else {
+        // Bigger ones are streamed to the transport in buffer sized chunks
+        session->send_buffer_size = 0;
+        ostream = (pb_ostream_t){
+            .callback = rpc_send_stream_callback,
+            .state = session,
+            .max_size = SIZE_MAX,
+        };
+
+        bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+        furi_check(result && ostream.bytes_written);
+
+        if(session->send_buffer_size) {
+            rpc_send_bytes(session, session->send_buffer, session->send_buffer_size);
+            session->send_buffer_size = 0;
+        }
     }
-    furi_mutex_release(session->callbacks_mutex);
 
-    free(buffer);
+    furi_mutex_release(session->callbacks_mutex);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
@@ -0,0 +1,435 @@
+#include "rpc_md5_cache.h"
+
+#include <furi.h>
+#include <furi_hal_rtc.h>
+#include <lib/toolbox/md5_calc.h>
+#include <lib/toolbox/path.h>
+#include <toolbox/stream/buffered_file_stream.h>
+
+#define TAG "RpcMd5Cache"
+
+#define RPC_MD5_CACHE_PATH        EXT_PATH(".rpc_md5")
+#define RPC_MD5_CACHE_MAGIC       (0x35444D52UL) // "RMD5"
+#define RPC_MD5_CACHE_VERSION     (1U)
+#define RPC_MD5_CACHE_ENTRIES_MAX (2048U)
+#define RPC_MD5_CACHE_HASH_SIZE   (16U)
+// Manifests of removed directories are looked for once there are more manifests than this
+#define RPC_MD5_CACHE_MANIFESTS_MAX (64U)
+// Entries of a directory may take up to this fraction of the free heap
+#define RPC_MD5_CACHE_HEAP_DIVIDER (8U)
+// Heap block header of a name copy
+#define RPC_MD5_CACHE_NAME_OVERHEAD (8U)
+// FAT timestamps have 2 seconds resolution, a file changed again within it keeps its timestamp
+#define RPC_MD5_CACHE_RACY_WINDOW (2U)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t dir_length;
+} FURI_PACKED RpcMd5CacheHeader;
+
+typedef struct {
+    uint64_t size;
+    uint32_t timestamp;
+    uint8_t md5[RPC_MD5_CACHE_HASH_SIZE];
+    uint8_t name_length;
+} FURI_PACKED RpcMd5CacheRecord;
+
+typedef struct {
+    char* name;
+    uint64_t size;
+    uint32_t timestamp;
+    uint8_t md5[RPC_MD5_CACHE_HASH_SIZE];
+} RpcMd5CacheEntry;
+
+struct RpcMd5Cache {
+    Storage* storage;
+    File* file;
+    Stream* stream;
+
+    FuriString* dir; // Directory the entries belong to
+    FuriString* manifest_path;
+    FuriString* name;
+
+    RpcMd5CacheEntry* entries;
+    size_t entries_count;
+    size_t entries_capacity;
+    size_t names_memory; // Heap taken by name copies
+    size_t memory_max; // Budget for entries and names of the current directory
+    size_t hint; // Listings walk the directory in the order entries were added
+    bool is_dirty;
+    bool is_pruned;
+};
+
+static bool rpc_md5_cache_is_cacheable(const char* path) {
+    return strncmp(path, STORAGE_EXT_PATH_PREFIX "/", strlen(STORAGE_EXT_PATH_PREFIX) + 1) == 0 &&
+           strncmp(path, RPC_MD5_CACHE_PATH, strlen(RPC_MD5_CACHE_PATH)) != 0;
+}
+
+static void rpc_md5_cache_format(const uint8_t md5[RPC_MD5_CACHE_HASH_SIZE], FuriString* output) {
+    furi_string_reset(output);
+    for(size_t i = 0; i < RPC_MD5_CACHE_HASH_SIZE; i++) {
+        furi_string_cat_printf(output, "%02x", md5[i]);
+    }
+}
+
+static void rpc_md5_cache_get_manifest_path(const char* dir, FuriString* manifest_path) {
+    // FNV-1a
+    uint32_t dir_hash = 2166136261UL;
+    while(*dir) {
+        dir_hash = (dir_hash ^ (uint8_t)*dir++) * 16777619UL;
+    }
+    furi_string_printf(manifest_path, "%s/%08lX", RPC_MD5_CACHE_PATH, dir_hash);
+}
+
+static void rpc_md5_cache_clear(RpcMd5Cache* cache) {
+    for(size_t i = 0; i < cache->entries_count; i++) {
+        free(cache->entries[i].name);
+    }
+    // Entries of the next directory start from scratch within a fresh budget
+    free(cache->entries);
+    cache->entries = NULL;
+    cache->entries_count = 0;
+    cache->entries_capacity = 0;
+    cache->names_memory = 0;
+    cache->hint = 0;
+    cache->is_dirty = false;
+}
+
+static RpcMd5CacheEntry* rpc_md5_cache_add(RpcMd5Cache* cache, const char* name) {
+    if(cache->entries_count >= RPC_MD5_CACHE_ENTRIES_MAX) return NULL;
+
+    size_t name_memory = strlen(name) + 1 + RPC_MD5_CACHE_NAME_OVERHEAD;
+    size_t names_memory = cache->names_memory + name_memory;
+    if(names_memory > cache->memory_max) return NULL;
+
+    if(cache->entries_count == cache->entries_capacity) {
+        // Grow by doubling, but no further than the budget allows
+        size_t capacity_max = (cache->memory_max - names_memory) / sizeof(RpcMd5CacheEntry);
+        size_t capacity = cache->entries_capacity ? cache->entries_capacity * 2 : 16;
+        capacity = MIN(capacity, MIN(capacity_max, (size_t)RPC_MD5_CACHE_ENTRIES_MAX));
+        if(capacity <= cache->entries_count) return NULL;
+
+        cache->entries = realloc(cache->entries, capacity * sizeof(RpcMd5CacheEntry)); //-V701
+        cache->entries_capacity = capacity;
+    } else if(
+        names_memory + cache->entries_capacity * sizeof(RpcMd5CacheEntry) > cache->memory_max) {
+        return NULL;
+    }
+
+    RpcMd5CacheEntry* entry = &cache->entries[cache->entries_count++];
+    entry->name = strdup(name);
+    cache->names_memory = names_memory;
+    return entry;
+}
+
+static void rpc_md5_cache_remove(RpcMd5Cache* cache, size_t index) {
+    cache->names_memory -= strlen(cache->entries[index].name) + 1 + RPC_MD5_CACHE_NAME_OVERHEAD;
+    free(cache->entries[index].name);
+    cache->entries_count--;
+    memmove(
+        &cache->entries[index],
+        &cache->entries[index + 1],
+        (cache->entries_count - index) * sizeof(RpcMd5CacheEntry));
+    cache->hint = 0;
+    cache->is_dirty = true;
+}
+
+static int32_t rpc_md5_cache_find(RpcMd5Cache* cache, const char* name) {
+    for(size_t i = 0; i < cache->entries_count; i++) {
+        size_t index = (cache->hint + i) % cache->entries_count;
+        if(strcmp(cache->entries[index].name, name) == 0) {
+            cache->hint = index + 1;
+            return index;
+        }
+    }
+    return -1;
+}
+
+static void rpc_md5_cache_prune(RpcMd5Cache* cache) {
+    File* dir = storage_file_alloc(cache->storage);
+    FileInfo file_info;
+    char name[16];
+    char* dir_name = NULL;
+    FuriString* manifest_path = furi_string_alloc();
+    size_t manifests_count = 0;
+
+    cache->is_pruned = true;
+
+    // Listing is cheap, manifests are only opened when there are too many of them
+    if(storage_dir_open(dir, RPC_MD5_CACHE_PATH)) {
+        while(storage_dir_read(dir, &file_info, NULL, 0)) {
+            if(!file_info_is_dir(&file_info)) manifests_count++;
+        }
+    }
+    storage_dir_close(dir);
+
+    if(manifests_count > RPC_MD5_CACHE_MANIFESTS_MAX &&
+       storage_dir_open(dir, RPC_MD5_CACHE_PATH)) {
+        while(storage_dir_read(dir, &file_info, name, sizeof(name))) {
+            if(file_info_is_dir(&file_info)) continue;
+            furi_string_printf(manifest_path, "%s/%s", RPC_MD5_CACHE_PATH, name);
+            const char* path = furi_string_get_cstr(manifest_path);
+
+            // Manifests that can't be read or belong to a directory that is gone are removed
+            bool is_stale = true;
+            RpcMd5CacheHeader header;
+            if(storage_file_open(cache->file, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+               storage_file_read(cache->file, &header, sizeof(header)) == sizeof(header) &&
+               header.magic == RPC_MD5_CACHE_MAGIC && header.version == RPC_MD5_CACHE_VERSION) {
+                dir_name = realloc(dir_name, header.dir_length + 1); //-V701
+                if(storage_file_read(cache->file, dir_name, header.dir_length) ==
+                   header.dir_length) {
+                    dir_name[header.dir_length] = '\0';
+                    is_stale = !storage_dir_exists(cache->storage, dir_name);
+                }
+            }
+            if(storage_file_is_open(cache->file)) storage_file_close(cache->file);
+
+            if(is_stale) {
+                FURI_LOG_D(TAG, "Removing stale %s", path);
+                storage_common_remove(cache->storage, path);
+            }
+        }
+    }
+
+    furi_string_free(manifest_path);
+    free(dir_name);
+    storage_dir_close(dir);
+    storage_file_free(dir);
+}
+
+static void rpc_md5_cache_save(RpcMd5Cache* cache) {
+    if(!cache->is_dirty) return;
+    cache->is_dirty = false;
+
+    if(cache->entries_count == 0) {
+        storage_simply_remove(cache->storage, furi_string_get_cstr(cache->manifest_path));
+        return;
+    }
+
+    storage_simply_mkdir(cache->storage, RPC_MD5_CACHE_PATH);
+
+    Stream* stream = cache->stream;
+    bool success = false;
+    bool is_new = !storage_file_exists(cache->storage, furi_string_get_cstr(cache->manifest_path));
+
+    do {
+        if(!buffered_file_stream_open(
+               stream,
+               furi_string_get_cstr(cache->manifest_path),
+               FSAM_WRITE,
+               FSOM_CREATE_ALWAYS))
+            break;
+
+        RpcMd5CacheHeader header = {
+            .magic = RPC_MD5_CACHE_MAGIC,
+            .version = RPC_MD5_CACHE_VERSION,
+            .dir_length = furi_string_size(cache->dir),
+        };
+        if(stream_write(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(stream_write_string(stream, cache->dir) != header.dir_length) break;
+
+        size_t i = 0;
+        for(; i < cache->entries_count; i++) {
+            RpcMd5CacheEntry* entry = &cache->entries[i];
+            RpcMd5CacheRecord record = {
+                .size = entry->size,
+                .timestamp = entry->timestamp,
+                .name_length = strlen(entry->name),
+            };
+            memcpy(record.md5, entry->md5, RPC_MD5_CACHE_HASH_SIZE);
+
+            if(stream_write(stream, (uint8_t*)&record, sizeof(record)) != sizeof(record)) break;
+            if(stream_write_cstring(stream, entry->name) != record.name_length) break;
+        }
+        if(i != cache->entries_count) break;
+
+        success = true;
+    } while(false);
+
+    buffered_file_stream_close(stream);
+
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to save %s", furi_string_get_cstr(cache->manifest_path));
+        storage_simply_remove(cache->storage, furi_string_get_cstr(cache->manifest_path));
+    } else if(is_new && !cache->is_pruned) {
+        // Only new manifests add up, at most one prune per session
+        rpc_md5_cache_prune(cache);
+    }
+}
+
+static void rpc_md5_cache_load(RpcMd5Cache* cache, FuriString* dir) {
+    if(furi_string_equal(cache->dir, dir)) return;
+
+    rpc_md5_cache_save(cache);
+    rpc_md5_cache_clear(cache);
+
+    furi_string_set(cache->dir, dir);
+    rpc_md5_cache_get_manifest_path(furi_string_get_cstr(dir), cache->manifest_path);
+    cache->memory_max = memmgr_get_free_heap() / RPC_MD5_CACHE_HEAP_DIVIDER;
+
+    Stream* stream = cache->stream;
+    char* name = malloc(MAX(furi_string_size(dir), UINT8_MAX) + 1);
+
+    do {
+        if(!buffered_file_stream_open(
+               stream,
+               furi_string_get_cstr(cache->manifest_path),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING))
+            break;
+
+        RpcMd5CacheHeader header;
+        if(stream_read(stream, (uint8_t*)&header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != RPC_MD5_CACHE_MAGIC || header.version != RPC_MD5_CACHE_VERSION) break;
+
+        // Manifests of directories with the same hash replace each other
+        if(header.dir_length != furi_string_size(dir)) break;
+        if(stream_read(stream, (uint8_t*)name, header.dir_length) != header.dir_length) break;
+        if(strncmp(name, furi_string_get_cstr(dir), header.dir_length) != 0) break;
+
+        RpcMd5CacheRecord record;
+        while(true) {
+            if(stream_read(stream, (uint8_t*)&record, sizeof(record)) != sizeof(record)) break;
+            if(stream_read(stream, (uint8_t*)name, record.name_length) != record.name_length)
+                break;
+            name[record.name_length] = '\0';
+
+            // Entries over the budget are dropped, their digests are calculated again
+            RpcMd5CacheEntry* entry = rpc_md5_cache_add(cache, name);
+            if(!entry) break;
+            entry->size = record.size;
+            entry->timestamp = record.timestamp;
+            memcpy(entry->md5, record.md5, RPC_MD5_CACHE_HASH_SIZE);
+        }
+    } while(false);
+
+    free(name);
+    buffered_file_stream_close(stream);
+}
+
+RpcMd5Cache* rpc_md5_cache_alloc(Storage* storage) {
+    furi_check(storage);
+
+    RpcMd5Cache* cache = malloc(sizeof(RpcMd5Cache));
+    cache->storage = storage;
+    cache->file = storage_file_alloc(storage);
+    cache->stream = buffered_file_stream_alloc(storage);
+    cache->dir = furi_string_alloc();
+    cache->manifest_path = furi_string_alloc();
+    cache->name = furi_string_alloc();
+
+    return cache;
+}
+
+void rpc_md5_cache_free(RpcMd5Cache* cache) {
+    furi_check(cache);
+
+    rpc_md5_cache_save(cache);
+    rpc_md5_cache_clear(cache);
+
+    furi_string_free(cache->name);
+    furi_string_free(cache->manifest_path);
+    furi_string_free(cache->dir);
+    stream_free(cache->stream);
+    storage_file_free(cache->file);
+
+    free(cache);
+}
+
+bool rpc_md5_cache_get(
+    RpcMd5Cache* cache,
+    const char* path,
+    FuriString* output,
+    FS_Error* file_error) {
+    furi_check(cache);
+    furi_check(path);
+    furi_check(output);
+
+    if(!rpc_md5_cache_is_cacheable(path)) {
+        return md5_string_calc_file(cache->file, path, output, file_error);
+    }
+
+    FileInfo file_info;
+    uint32_t timestamp;
+    if(storage_common_stat(cache->storage, path, &file_info) != FSE_OK ||
+       storage_common_timestamp(cache->storage, path, &timestamp) != FSE_OK) {
+        return md5_string_calc_file(cache->file, path, output, file_error);
+    }
+
+    path_extract_dirname(path, cache->name);
+    rpc_md5_cache_load(cache, cache->name);
+    path_extract_basename(path, cache->name);
+    const char* name = furi_string_get_cstr(cache->name);
+
+    int32_t index = rpc_md5_cache_find(cache, name);
+    if(index >= 0) {
+        RpcMd5CacheEntry* entry = &cache->entries[index];
+        if(entry->size == file_info.size && entry->timestamp == timestamp) {
+            rpc_md5_cache_format(entry->md5, output);
+            if(file_error != NULL) {
+                *file_error = FSE_OK;
+            }
+            return true;
+        }
+    }
+
+    uint8_t md5[RPC_MD5_CACHE_HASH_SIZE];
+    if(!md5_calc_file(cache->file, path, md5, file_error)) {
+        return false;
+    }
+    rpc_md5_cache_format(md5, output);
+
+    // A file changed right now may change again without its timestamp moving
+    if(timestamp + RPC_MD5_CACHE_RACY_WINDOW < furi_hal_rtc_get_timestamp()) {
+        RpcMd5CacheEntry* entry = NULL;
+        if(index >= 0) {
+            entry = &cache->entries[index];
+        } else {
+            entry = rpc_md5_cache_add(cache, name);
+        }
+
+        if(entry) {
+            entry->size = file_info.size;
+            entry->timestamp = timestamp;
+            memcpy(entry->md5, md5, RPC_MD5_CACHE_HASH_SIZE);
+            cache->is_dirty = true;
+        }
+    }
+
+    return true;
+}
+
+void rpc_md5_cache_invalidate(RpcMd5Cache* cache, const char* path) {
+    furi_check(cache);
+    furi_check(path);
+
+    // Manifests of other directories are checked against file size and timestamp on use
+    path_extract_dirname(path, cache->name);
+    if(!furi_string_equal(cache->dir, cache->name)) return;
+
+    path_extract_basename(path, cache->name);
+    int32_t index = rpc_md5_cache_find(cache, furi_string_get_cstr(cache->name));
+    if(index >= 0) {
+        rpc_md5_cache_remove(cache, index);
+    }
+}
+
+void rpc_md5_cache_invalidate_dir(RpcMd5Cache* cache, const char* path) {
+    furi_check(cache);
+    furi_check(path);
+
+    // Entries of the directory or of one inside it must not be saved again under the old path
+    size_t path_length = strlen(path);
+    if(furi_string_start_with_str(cache->dir, path) &&
+       (furi_string_size(cache->dir) == path_length ||
+        furi_string_get_char(cache->dir, path_length) == '/')) {
+        rpc_md5_cache_clear(cache);
+        furi_string_reset(cache->dir);
+    }
+
+    // Manifests of subdirectories are left for the prune once manifests add up
+    rpc_md5_cache_get_manifest_path(path, cache->name);
+    storage_common_remove(cache->storage, furi_string_get_cstr(cache->name));
+}
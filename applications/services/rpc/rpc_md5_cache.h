@@ -0,0 +1,54 @@
+#pragma once
+
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * MD5 digests of files on the SD card, kept in a manifest per directory.
+ * A digest is reused as long as the file size and timestamp stay the same.
+ * Manifests of directories that no longer exist are removed once manifests add up.
+ */
+typedef struct RpcMd5Cache RpcMd5Cache;
+
+RpcMd5Cache* rpc_md5_cache_alloc(Storage* storage);
+
+/** Save pending manifest changes and free the cache */
+void rpc_md5_cache_free(RpcMd5Cache* cache);
+
+/**
+ * @brief Get MD5 of a file as a hex string, from the manifest if the file is unchanged
+ *
+ * @param cache pointer to the RpcMd5Cache instance
+ * @param path path to the file
+ * @param output output hex string
+ * @param file_error error of the file operation, may be NULL
+ * @return true on success
+ */
+bool rpc_md5_cache_get(
+    RpcMd5Cache* cache,
+    const char* path,
+    FuriString* output,
+    FS_Error* file_error);
+
+/**
+ * @brief Forget the digest of a file that was changed, removed or renamed
+ *
+ * @param cache pointer to the RpcMd5Cache instance
+ * @param path path to the file
+ */
+void rpc_md5_cache_invalidate(RpcMd5Cache* cache, const char* path);
+
+/**
+ * @brief Forget the digests of a directory that was removed or renamed
+ *
+ * @param cache pointer to the RpcMd5Cache instance
+ * @param path path to the directory
+ */
+void rpc_md5_cache_invalidate_dir(RpcMd5Cache* cache, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
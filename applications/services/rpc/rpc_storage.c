@@ -5,11 +5,12 @@
 #include <rpc/rpc_i.h>
 #include <storage/filesystem_api_defines.h>
 #include <storage/storage.h>
-#include <lib/toolbox/md5_calc.h>
 #include <lib/toolbox/path.h>
 #include <update_util/int_backup.h>
 #include <toolbox/tar/tar_archive.h>
 
+#include "rpc_md5_cache.h"
+
 #include <pb_decode.h>
 #include <storage.pb.h>
 #include <flipper.pb.h>
@@ -18,6 +19,17 @@
 
 #define MAX_NAME_LENGTH 255
 
+// Files are read ahead in blocks of several messages, while the previous ones are being sent
+#define READ_BLOCK_SIZE   (2048U)
+#define READ_WINDOW       (3U)
+#define WRITE_BUFFER_SIZE (4096U)
+
+// Reading "<dir>.ths", when there is no such file, streams the directory as compressed tar.
+// The schema has no archive request, so the read path is the only in-band way to ask for it.
+// There is no streamed counterpart for uploads: written .ths files are stored as they are,
+// since clients also upload real ones, and have to be unpacked with tar_extract afterwards.
+#define ARCHIVE_READ_EXTENSION ".ths"
+
 static const size_t MAX_DATA_SIZE = 512;
 
 typedef enum {
@@ -31,8 +43,37 @@ typedef struct {
     File* file;
     RpcStorageState state;
     uint32_t current_command_id;
+    RpcMd5Cache* md5_cache;
+    uint8_t* write_buffer;
+    size_t write_buffer_size;
 } RpcStorageSystem;
 
+typedef struct {
+    uint8_t* data;
+    size_t size;
+} RpcStorageReadBlock;
+
+typedef struct {
+    RpcSession* session;
+    PB_Main* response;
+} RpcStorageArchiveStream;
+
+typedef struct {
+    File* file;
+    size_t size;
+    FuriMessageQueue* free_blocks;
+    FuriMessageQueue* filled_blocks;
+    RpcStorageReadBlock blocks[READ_WINDOW];
+} RpcStorageReadAhead;
+
+static bool rpc_system_storage_write_flush(RpcStorageSystem* rpc_storage) {
+    size_t size = rpc_storage->write_buffer_size;
+    if(size == 0) return true;
+    rpc_storage->write_buffer_size = 0;
+
+    return storage_file_write(rpc_storage->file, rpc_storage->write_buffer, size) == size;
+}
+
 static void rpc_system_storage_reset_state(
     RpcStorageSystem* rpc_storage,
     RpcSession* session,
@@ -49,6 +90,10 @@ static void rpc_system_storage_reset_state(
         }
 
         if(rpc_storage->state == RpcStorageStateWriting) {
+            // Data received before the interruption is kept, as it would be without buffering
+            rpc_system_storage_write_flush(rpc_storage);
+            free(rpc_storage->write_buffer);
+            rpc_storage->write_buffer = NULL;
             storage_file_close(rpc_storage->file);
             storage_file_free(rpc_storage->file);
         }
@@ -282,7 +327,6 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     bool include_md5 = list_request->include_md5;
     FuriString* md5 = furi_string_alloc();
     FuriString* md5_path = furi_string_alloc();
-    File* file = storage_file_alloc(rpc_storage->api);
 
     bool finish = false;
     int i = 0;
@@ -313,7 +357,8 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
                 if(include_md5 && !file_info_is_dir(&fileinfo)) {
                     furi_string_printf(md5_path, "%s/%s", list_request->path, name); //-V576
 
-                    if(md5_string_calc_file(file, furi_string_get_cstr(md5_path), md5, NULL)) {
+                    if(rpc_md5_cache_get(
+                           rpc_storage->md5_cache, furi_string_get_cstr(md5_path), md5, NULL)) {
                         char* md5sum = list->file[i].md5sum;
                         size_t md5sum_size = sizeof(list->file[i].md5sum);
                         snprintf(md5sum, md5sum_size, "%s", furi_string_get_cstr(md5));
@@ -338,7 +383,193 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
     furi_string_free(md5_path);
     storage_dir_close(dir);
     storage_file_free(dir);
-    storage_file_free(file);
+}
+
+static void rpc_system_storage_read_send(
+    RpcSession* session,
+    PB_Main* response,
+    const uint8_t* data,
+    size_t size,
+    bool is_last) {
+    pb_bytes_array_t* chunk = response->content.storage_read_response.file.data;
+
+    do {
+        chunk->size = MIN(size, MAX_DATA_SIZE);
+        memcpy(chunk->bytes, data, chunk->size);
+        data += chunk->size;
+        size -= chunk->size;
+
+        response->has_next = !is_last || (size > 0);
+        rpc_send(session, response);
+    } while(size > 0);
+}
+
+static int32_t rpc_system_storage_read_ahead_worker(void* context) {
+    RpcStorageReadAhead* read_ahead = context;
+    size_t size_left = read_ahead->size;
+
+    while(size_left > 0) {
+        RpcStorageReadBlock* block;
+        furi_check(
+            furi_message_queue_get(read_ahead->free_blocks, &block, FuriWaitForever) ==
+            FuriStatusOk);
+
+        size_t read_size = MIN(size_left, READ_BLOCK_SIZE);
+        block->size = storage_file_read(read_ahead->file, block->data, read_size);
+
+        furi_check(
+            furi_message_queue_put(read_ahead->filled_blocks, &block, FuriWaitForever) ==
+            FuriStatusOk);
+
+        // Short block tells the sender about the error
+        if(block->size != read_size) break;
+        size_left -= read_size;
+    }
+
+    return 0;
+}
+
+static bool rpc_system_storage_read_pipelined(
+    RpcSession* session,
+    PB_Main* response,
+    File* file,
+    size_t size) {
+    RpcStorageReadAhead* read_ahead = malloc(sizeof(RpcStorageReadAhead));
+    read_ahead->file = file;
+    read_ahead->size = size;
+    read_ahead->free_blocks = furi_message_queue_alloc(READ_WINDOW, sizeof(RpcStorageReadBlock*));
+    read_ahead->filled_blocks =
+        furi_message_queue_alloc(READ_WINDOW, sizeof(RpcStorageReadBlock*));
+
+    for(size_t i = 0; i < READ_WINDOW; i++) {
+        RpcStorageReadBlock* block = &read_ahead->blocks[i];
+        block->data = malloc(READ_BLOCK_SIZE);
+        furi_message_queue_put(read_ahead->free_blocks, &block, 0);
+    }
+
+    FuriThread* thread = furi_thread_alloc_ex(
+        "RpcStorageReadAhead", 1024, rpc_system_storage_read_ahead_worker, read_ahead);
+    furi_thread_start(thread);
+
+    bool success = true;
+    size_t size_left = size;
+
+    while(size_left > 0) {
+        RpcStorageReadBlock* block;
+        furi_check(
+            furi_message_queue_get(read_ahead->filled_blocks, &block, FuriWaitForever) ==
+            FuriStatusOk);
+
+        size_t block_size = MIN(size_left, READ_BLOCK_SIZE);
+        if(block->size != block_size) {
+            success = false;
+            break;
+        }
+        size_left -= block_size;
+
+        rpc_system_storage_read_send(session, response, block->data, block_size, size_left == 0);
+        furi_message_queue_put(read_ahead->free_blocks, &block, 0);
+    }
+
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    for(size_t i = 0; i < READ_WINDOW; i++) {
+        free(read_ahead->blocks[i].data);
+    }
+    furi_message_queue_free(read_ahead->filled_blocks);
+    furi_message_queue_free(read_ahead->free_blocks);
+    free(read_ahead);
+
+    return success;
+}
+
+static PB_Main* rpc_system_storage_read_response_alloc(uint32_t command_id) {
+    PB_Main* response = malloc(sizeof(PB_Main));
+    response->command_id = command_id;
+    response->which_content = PB_Main_storage_read_response_tag;
+    response->command_status = PB_CommandStatus_OK;
+    response->content.storage_read_response.has_file = true;
+    response->content.storage_read_response.file.data =
+        malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MAX_DATA_SIZE));
+    response->content.storage_read_response.file.data->size = 0;
+
+    return response;
+}
+
+static void rpc_system_storage_read_response_free(PB_Main* response) {
+    free(response->content.storage_read_response.file.data);
+    free(response);
+}
+
+static int32_t rpc_system_storage_archive_write_cb(void* context, uint8_t* buffer, size_t size) {
+    RpcStorageArchiveStream* stream = context;
+    pb_bytes_array_t* chunk = stream->response->content.storage_read_response.file.data;
+
+    for(size_t size_left = size; size_left > 0;) {
+        size_t copy_size = MIN(size_left, MAX_DATA_SIZE - chunk->size);
+        memcpy(&chunk->bytes[chunk->size], buffer, copy_size);
+        chunk->size += copy_size;
+        buffer += copy_size;
+        size_left -= copy_size;
+
+        if(chunk->size == MAX_DATA_SIZE) {
+            stream->response->has_next = true;
+            rpc_send(stream->session, stream->response);
+            chunk->size = 0;
+        }
+    }
+
+    return size;
+}
+
+/* Get directory to send as archive for a virtual "<dir>.ths" read path */
+static bool rpc_system_storage_get_archive_dir(Storage* fs_api, const char* path, FuriString* dir) {
+    size_t path_len = strlen(path);
+    size_t ext_len = strlen(ARCHIVE_READ_EXTENSION);
+    if(path_len <= ext_len || strcmp(&path[path_len - ext_len], ARCHIVE_READ_EXTENSION) != 0) {
+        return false;
+    }
+
+    // Existing .ths files are read as they are
+    if(storage_common_exists(fs_api, path)) {
+        return false;
+    }
+
+    furi_string_set_strn(dir, path, path_len - ext_len);
+
+    FileInfo fileinfo;
+    return storage_common_stat(fs_api, furi_string_get_cstr(dir), &fileinfo) == FSE_OK &&
+           file_info_is_dir(&fileinfo);
+}
+
+/* Directory is sent as heatshrink compressed tar, packed while it is being sent */
+static void rpc_system_storage_read_dir(
+    RpcStorageSystem* rpc_storage,
+    const char* path,
+    uint32_t command_id) {
+    RpcSession* session = rpc_storage->session;
+    RpcStorageArchiveStream stream = {
+        .session = session,
+        .response = rpc_system_storage_read_response_alloc(command_id),
+    };
+
+    TarArchive* archive = tar_archive_alloc(rpc_storage->api);
+    bool success =
+        tar_archive_open_write_stream(archive, rpc_system_storage_archive_write_cb, &stream) &&
+        tar_archive_add_dir(archive, path, "") && tar_archive_finalize(archive);
+    // Compressor flushes the rest of the data on close
+    success = tar_archive_close(archive) && success;
+    tar_archive_free(archive);
+
+    if(success) {
+        stream.response->has_next = false;
+        rpc_send(session, stream.response);
+    } else {
+        rpc_send_and_release_empty(session, command_id, PB_CommandStatus_ERROR_STORAGE_INTERNAL);
+    }
+
+    rpc_system_storage_read_response_free(stream.response);
 }
 
 static void rpc_system_storage_read_process(const PB_Main* request, void* context) {
@@ -354,48 +585,38 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
-    /* use same message memory to send response */
-    PB_Main* response = malloc(sizeof(PB_Main));
     const char* path = request->content.storage_read_request.path;
+
+    FuriString* archive_dir = furi_string_alloc();
+    bool is_archive = rpc_system_storage_get_archive_dir(rpc_storage->api, path, archive_dir);
+    if(is_archive) {
+        rpc_system_storage_read_dir(
+            rpc_storage, furi_string_get_cstr(archive_dir), request->command_id);
+    }
+    furi_string_free(archive_dir);
+    if(is_archive) return;
+
     File* file = storage_file_alloc(rpc_storage->api);
     bool fs_operation_success = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
 
     if(fs_operation_success) {
-        size_t size_left = storage_file_size(file);
-        do {
-            response->command_id = request->command_id;
-            response->which_content = PB_Main_storage_read_response_tag;
-            response->command_status = PB_CommandStatus_OK;
-
-            size_t read_size = MIN(size_left, MAX_DATA_SIZE);
-            if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
-
-                response->has_next = fs_operation_success && (size_left > 0);
-            } else {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Warray-bounds"
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-#pragma GCC diagnostic pop
-                response->content.storage_read_response.has_file = true;
-                response->has_next = false;
-                fs_operation_success = true;
-            }
+        /* use same message and data memory for every chunk */
+        PB_Main* response = rpc_system_storage_read_response_alloc(request->command_id);
 
+        size_t size = storage_file_size(file);
+        if(size > READ_BLOCK_SIZE) {
+            fs_operation_success =
+                rpc_system_storage_read_pipelined(session, response, file, size);
+        } else {
+            uint8_t* buffer = malloc(READ_BLOCK_SIZE);
+            fs_operation_success = (storage_file_read(file, buffer, size) == size);
             if(fs_operation_success) {
-                rpc_send_and_release(session, response);
+                rpc_system_storage_read_send(session, response, buffer, size, true);
             }
-        } while((size_left != 0) && fs_operation_success);
+            free(buffer);
+        }
+
+        rpc_system_storage_read_response_free(response);
     }
 
     if(!fs_operation_success) {
@@ -403,7 +624,6 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
             session, request->command_id, rpc_system_storage_get_file_error(file));
     }
 
-    free(response);
     storage_file_close(file);
     storage_file_free(file);
 }
@@ -436,9 +656,12 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
 
     if(rpc_storage->state != RpcStorageStateWriting) {
         rpc_storage->file = storage_file_alloc(rpc_storage->api);
+        rpc_storage->write_buffer = malloc(WRITE_BUFFER_SIZE);
+        rpc_storage->write_buffer_size = 0;
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
         const char* path = request->content.storage_write_request.path;
+        rpc_md5_cache_invalidate(rpc_storage->md5_cache, path);
         fs_operation_success =
             storage_file_open(rpc_storage->file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS);
     }
@@ -452,8 +675,27 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
            request->content.storage_write_request.file.data->size) {
             uint8_t* buffer = request->content.storage_write_request.file.data->bytes;
             size_t buffer_size = request->content.storage_write_request.file.data->size;
-            size_t written_size = storage_file_write(file, buffer, buffer_size);
-            fs_operation_success = (written_size == buffer_size);
+
+            // Chunks are gathered into bigger writes, the client does not wait for them anyway
+            while(buffer_size > 0 && fs_operation_success) {
+                size_t copy_size =
+                    MIN(buffer_size, WRITE_BUFFER_SIZE - rpc_storage->write_buffer_size);
+                memcpy(
+                    &rpc_storage->write_buffer[rpc_storage->write_buffer_size],
+                    buffer,
+                    copy_size);
+                rpc_storage->write_buffer_size += copy_size;
+                buffer += copy_size;
+                buffer_size -= copy_size;
+
+                if(rpc_storage->write_buffer_size == WRITE_BUFFER_SIZE) {
+                    fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
+                }
+            }
+        }
+
+        if(fs_operation_success && !request->has_next) {
+            fs_operation_success = rpc_system_storage_write_flush(rpc_storage);
         }
 
         send_response = !request->has_next;
@@ -519,6 +761,8 @@ static void rpc_system_storage_delete_process(const PB_Main* request, void* cont
     if(!path) {
         status = PB_CommandStatus_ERROR_INVALID_PARAMETERS;
     } else {
+        rpc_md5_cache_invalidate(rpc_storage->md5_cache, path);
+        rpc_md5_cache_invalidate_dir(rpc_storage->md5_cache, path);
         FS_Error error_remove = storage_common_remove(rpc_storage->api, path);
         // FSE_DENIED is for empty directory, but not only for this
         // that's why we have to check it
@@ -588,11 +832,10 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
         return;
     }
 
-    File* file = storage_file_alloc(rpc_storage->api);
     FuriString* md5 = furi_string_alloc();
     FS_Error file_error;
 
-    if(md5_string_calc_file(file, filename, md5, &file_error)) {
+    if(rpc_md5_cache_get(rpc_storage->md5_cache, filename, md5, &file_error)) {
         PB_Main response = {
             .command_id = request->command_id,
             .command_status = PB_CommandStatus_OK,
@@ -611,7 +854,6 @@ static void rpc_system_storage_md5sum_process(const PB_Main* request, void* cont
     }
 
     furi_string_free(md5);
-    storage_file_free(file);
 }
 
 static void rpc_system_storage_rename_process(const PB_Main* request, void* context) {
@@ -629,6 +871,12 @@ static void rpc_system_storage_rename_process(const PB_Main* request, void* cont
     rpc_system_storage_reset_state(rpc_storage, session, true);
 
     if(path_contains_only_ascii(request->content.storage_rename_request.new_path)) {
+        rpc_md5_cache_invalidate(
+            rpc_storage->md5_cache, request->content.storage_rename_request.old_path);
+        rpc_md5_cache_invalidate_dir(
+            rpc_storage->md5_cache, request->content.storage_rename_request.old_path);
+        rpc_md5_cache_invalidate(
+            rpc_storage->md5_cache, request->content.storage_rename_request.new_path);
         FS_Error error = storage_common_rename(
             rpc_storage->api,
             request->content.storage_rename_request.old_path,
@@ -731,6 +979,7 @@ void* rpc_system_storage_alloc(RpcSession* session) {
     rpc_storage->api = furi_record_open(RECORD_STORAGE);
     rpc_storage->session = session;
     rpc_storage->state = RpcStorageStateIdle;
+    rpc_storage->md5_cache = rpc_md5_cache_alloc(rpc_storage->api);
 
     RpcHandler rpc_handler = {
         .message_handler = NULL,
@@ -787,6 +1036,7 @@ void rpc_system_storage_free(void* context) {
     furi_assert(session);
 
     rpc_system_storage_reset_state(rpc_storage, session, false);
+    rpc_md5_cache_free(rpc_storage->md5_cache);
 
     furi_record_close(RECORD_STORAGE);
     rpc_storage->api = NULL;
@@ -64,6 +64,19 @@ static void storage_cli_info(PipeSide* pipe, FuriString* path, FuriString* args)
                 sd_info.product_serial_number,
                 sd_info.manufacturing_month,
                 sd_info.manufacturing_year);
+
+            FuriHalSdCacheStats cache_stats;
+            furi_hal_sd_cache_get_stats(&cache_stats);
+            uint32_t lookups = cache_stats.hits + cache_stats.misses;
+            printf(
+                "Cache: %lu sectors, %lu hits, %lu misses, %lu%% hit rate\r\n"
+                "%lu evicted, %lu read ahead\r\n",
+                cache_stats.capacity,
+                cache_stats.hits,
+                cache_stats.misses,
+                lookups ? (uint32_t)((uint64_t)cache_stats.hits * 100 / lookups) : 0UL,
+                cache_stats.evictions,
+                cache_stats.readahead);
         }
     } else {
         storage_cli_print_usage();
@@ -27,6 +27,18 @@ static FS_Error storage_ext_parse_error(SDError error);
 
 /******************* Core Functions *******************/
 
+static void sd_cache_pin_fat(FATFS* fs) {
+    uint32_t start_sector = fs->fatbase;
+    uint32_t end_sector = fs->fatbase + fs->fsize * fs->n_fats - 1;
+
+    // FAT12/16 root directory is not a cluster chain and sits right after the FAT
+    if(fs->fs_type == FS_FAT12 || fs->fs_type == FS_FAT16) {
+        end_sector = fs->database - 1;
+    }
+
+    furi_hal_sd_cache_pin_range(start_sector, end_sector);
+}
+
 static bool sd_mount_card_internal(StorageData* storage, bool notify) {
     bool result = false;
     uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -53,6 +65,10 @@ static bool sd_mount_card_internal(StorageData* storage, bool notify) {
         } else {
             SDError status = f_mount(sd_data->fs, sd_data->path, 1);
 
+            if(status == FR_OK) {
+                sd_cache_pin_fat(sd_data->fs);
+            }
+
             if(status == FR_OK || status == FR_NO_FILESYSTEM) {
 #ifndef FURI_RAM_EXEC
                 FATFS* fs;
@@ -226,6 +242,7 @@ FS_Error sd_format_card(StorageData* storage) {
         storage->status = StorageStatusNotMounted;
         error = f_mount(sd_data->fs, sd_data->path, 1);
         if(error != FR_OK) break;
+        sd_cache_pin_fat(sd_data->fs);
         storage->status = StorageStatusOK;
     } while(false);
 
@@ -184,6 +184,33 @@ void* js_module_get(JsModules* modules, const char* name) {
     return module_inst ? module_inst->context : NULL;
 }
 
+uint8_t* js_array_buf_get_range(
+    struct mjs* mjs,
+    mjs_val_t buf,
+    int32_t offset,
+    int32_t length,
+    size_t* range_len) {
+    furi_check(range_len);
+
+    if(mjs_is_data_view(buf)) {
+        buf = mjs_dataview_get_buf(mjs, buf);
+    }
+    if(!mjs_is_array_buf(buf)) return NULL;
+
+    size_t buf_len = 0;
+    uint8_t* data = (uint8_t*)mjs_array_buf_get_ptr(mjs, buf, &buf_len);
+    if(!data || offset < 0 || (size_t)offset > buf_len) return NULL;
+
+    if(length < 0) {
+        length = buf_len - offset;
+    } else if((size_t)length > buf_len - offset) {
+        return NULL;
+    }
+
+    *range_len = length;
+    return data + offset;
+}
+
 typedef enum {
     JsSdkCompatStatusCompatible,
     JsSdkCompatStatusFirmwareTooOld,
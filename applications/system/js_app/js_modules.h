@@ -16,7 +16,7 @@ extern "C" {
 
 #define JS_SDK_VENDOR "flipperdevices"
 #define JS_SDK_MAJOR  1
-#define JS_SDK_MINOR  0
+#define JS_SDK_MINOR  1
 
 /**
  * @brief Returns the foreign pointer in `obj["_"]`
@@ -118,6 +118,28 @@ mjs_val_t js_module_require(JsModules* modules, const char* name, size_t name_le
  */
 void* js_module_get(JsModules* modules, const char* name);
 
+/**
+ * @brief Gets a byte range of the backing store of an ArrayBuffer or typed
+ * array, to read or write it in place
+ *
+ * The pointer is only valid until the next ArrayBuffer is allocated, which may
+ * move the storage of all buffers.
+ *
+ * @param[in]  mjs       mJS instance pointer
+ * @param[in]  buf       ArrayBuffer or typed array
+ * @param[in]  offset    Byte offset of the range
+ * @param[in]  length    Byte length of the range, negative for up to the end
+ * @param[out] range_len Byte length of the range
+ * @returns Pointer to the start of the range, NULL if `buf` is not a buffer or
+ *          the range does not fit in it
+ */
+uint8_t* js_array_buf_get_range(
+    struct mjs* mjs,
+    mjs_val_t buf,
+    int32_t offset,
+    int32_t length,
+    size_t* range_len);
+
 /**
  * @brief `sdkCompatibilityStatus` function
  */
@@ -1,7 +1,10 @@
 #include <common/cs_dbg.h>
+#include <common/cs_file.h>
+#include <mjs_gc_public.h>
 #include <toolbox/path.h>
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/strint.h>
+#include <toolbox/version.h>
 #include <loader/firmware_api/firmware_api.h>
 #include <flipper_application/api_hashtable/api_hashtable.h>
 #include <flipper_application/plugins/composite_resolver.h>
@@ -13,6 +16,27 @@
 
 #define TAG "JS"
 
+#define JS_BCODE_CACHE_PATH        EXT_PATH(".js_cache")
+#define JS_BCODE_CACHE_MAGIC       (0x43534A4DUL) // "MJSC"
+#define JS_BCODE_CACHE_VERSION     (2U)
+#define JS_BCODE_CACHE_ENTRIES_MAX (16U)
+#define JS_BCODE_CACHE_NAME_LENGTH (16U)
+
+// GC work per slice in idle time, more than between instructions since nothing waits for it
+#define JS_GC_IDLE_BUDGET (256U)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t bcode_version;
+    uint16_t api_version_major;
+    uint16_t api_version_minor;
+    uint32_t firmware_hash; // Build the bcode was compiled by
+    uint32_t source_size;
+    uint32_t source_hash;
+    uint32_t bcode_size;
+} FURI_PACKED JsBcodeCacheHeader;
+
 struct JsThread {
     FuriThread* thread;
     FuriString* path;
@@ -101,6 +125,17 @@ static void js_exit_flag_poll(struct mjs* mjs) {
     }
 }
 
+bool js_gc_idle(struct mjs* mjs, uint32_t timeout) {
+    uint32_t start = furi_get_tick();
+    bool pending;
+
+    do {
+        pending = mjs_gc_step(mjs, JS_GC_IDLE_BUDGET);
+    } while(pending && furi_get_tick() - start < timeout);
+
+    return pending;
+}
+
 bool js_delay_with_flags(struct mjs* mjs, uint32_t time) {
     uint32_t flags =
         furi_thread_flags_wait(ThreadEventStop, FuriFlagWaitAny | FuriFlagNoClear, time);
@@ -156,6 +191,13 @@ static void js_delay(struct mjs* mjs) {
         mjs_return(mjs, MJS_UNDEFINED);
         return;
     }
+    // Nothing is held by a native here, so garbage is collected while the script waits
+    if(ms > 0) {
+        uint32_t start = furi_get_tick();
+        js_gc_idle(mjs, ms);
+        uint32_t elapsed = furi_get_tick() - start;
+        ms = (elapsed < (uint32_t)ms) ? ms - elapsed : 0;
+    }
     js_delay_with_flags(mjs, ms);
     mjs_return(mjs, MJS_UNDEFINED);
 }
@@ -233,6 +275,163 @@ static void js_dump_write_callback(void* ctx, const char* format, ...) {
 }
 #endif
 
+static uint32_t js_source_hash(const char* data, size_t size) {
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ (uint8_t)data[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+static uint32_t js_bcode_cache_firmware_hash(void) {
+    FuriString* build = furi_string_alloc_printf(
+        "%s %s", version_get_githash(NULL), version_get_builddate(NULL));
+    uint32_t hash = js_source_hash(furi_string_get_cstr(build), furi_string_size(build));
+    furi_string_free(build);
+    return hash;
+}
+
+static char* js_bcode_cache_load(File* file, const char* path, JsBcodeCacheHeader* expected) {
+    char* bcode = NULL;
+
+    do {
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        JsBcodeCacheHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        expected->bcode_size = header.bcode_size;
+        if(memcmp(&header, expected, sizeof(header)) != 0) break;
+        if(header.bcode_size > storage_file_size(file) - sizeof(header)) break;
+
+        bcode = malloc(header.bcode_size);
+        if(storage_file_read(file, bcode, header.bcode_size) != header.bcode_size) {
+            free(bcode);
+            bcode = NULL;
+        }
+    } while(false);
+
+    storage_file_close(file);
+    return bcode;
+}
+
+/* Entries of removed, moved or edited scripts are never read again, the oldest make room */
+static void js_bcode_cache_evict(Storage* storage, const char* keep_path) {
+    File* dir = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FuriString* oldest_path = furi_string_alloc();
+    char name[JS_BCODE_CACHE_NAME_LENGTH];
+    uint32_t oldest_timestamp = UINT32_MAX;
+    size_t entries_count = 0;
+
+    if(storage_dir_open(dir, JS_BCODE_CACHE_PATH)) {
+        while(storage_dir_read(dir, NULL, name, sizeof(name))) {
+            furi_string_printf(path, "%s/%s", JS_BCODE_CACHE_PATH, name);
+            // Entry of this script is overwritten anyway
+            if(furi_string_equal(path, keep_path)) continue;
+            entries_count++;
+
+            uint32_t timestamp;
+            if(storage_common_timestamp(storage, furi_string_get_cstr(path), &timestamp) ==
+                   FSE_OK &&
+               timestamp < oldest_timestamp) {
+                oldest_timestamp = timestamp;
+                furi_string_set(oldest_path, path);
+            }
+        }
+    }
+    storage_dir_close(dir);
+    storage_file_free(dir);
+
+    if(entries_count >= JS_BCODE_CACHE_ENTRIES_MAX && !furi_string_empty(oldest_path)) {
+        storage_simply_remove(storage, furi_string_get_cstr(oldest_path));
+    }
+
+    furi_string_free(oldest_path);
+    furi_string_free(path);
+}
+
+static void js_bcode_cache_save(
+    Storage* storage,
+    File* file,
+    const char* path,
+    const JsBcodeCacheHeader* header,
+    const char* bcode) {
+    storage_simply_mkdir(storage, JS_BCODE_CACHE_PATH);
+    js_bcode_cache_evict(storage, path);
+
+    bool success = storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, header, sizeof(*header)) == sizeof(*header) &&
+                   storage_file_write(file, bcode, header->bcode_size) == header->bcode_size;
+    storage_file_close(file);
+
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to save %s", path);
+        storage_simply_remove(storage, path);
+    }
+}
+
+/*
+ * Runs the script from the bcode saved on the previous launch, if the source
+ * and the firmware build are unchanged. Otherwise parses the source and saves its bcode. Bcode is kept
+ * in a cache directory, in a file named by the hash of the script path.
+ */
+static mjs_err_t js_exec_file_cached(struct mjs* mjs, const char* path) {
+    size_t source_size = 0;
+    char* source = cs_read_file(path, &source_size);
+    if(source == NULL) {
+        // Reports the error
+        return mjs_exec_file(mjs, path, NULL);
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* cache_path = furi_string_alloc_printf(
+        "%s/%08lX.jsc", JS_BCODE_CACHE_PATH, js_source_hash(path, strlen(path)));
+
+    JsBcodeCacheHeader header = {
+        .magic = JS_BCODE_CACHE_MAGIC,
+        .version = JS_BCODE_CACHE_VERSION,
+        .bcode_version = MJS_BCODE_VERSION,
+        .api_version_major = firmware_api_interface->api_version_major,
+        .api_version_minor = firmware_api_interface->api_version_minor,
+        .firmware_hash = js_bcode_cache_firmware_hash(),
+        .source_size = source_size,
+        .source_hash = js_source_hash(source, source_size),
+    };
+
+    mjs_err_t err = MJS_OK;
+    char* cached = js_bcode_cache_load(file, furi_string_get_cstr(cache_path), &header);
+    if(cached) {
+        err = mjs_load_bcode(mjs, cached, header.bcode_size);
+        if(err != MJS_OK) {
+            FURI_LOG_W(TAG, "Bcode cache is broken");
+        }
+    }
+
+    if(!cached || err != MJS_OK) {
+        const char* bcode = NULL;
+        size_t bcode_size = 0;
+        err = mjs_compile(mjs, path, source, &bcode, &bcode_size);
+        if(err == MJS_OK) {
+            header.bcode_size = bcode_size;
+            js_bcode_cache_save(
+                storage, file, furi_string_get_cstr(cache_path), &header, bcode);
+        }
+    }
+
+    free(source);
+    furi_string_free(cache_path);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(err == MJS_OK) {
+        err = mjs_exec_bcode(mjs, NULL);
+    }
+
+    return err;
+}
+
 static int32_t js_thread(void* arg) {
     JsThread* worker = arg;
     worker->resolver = composite_api_resolver_alloc();
@@ -289,7 +488,7 @@ static int32_t js_thread(void* arg) {
 
     mjs_set_exec_flags_poller(mjs, js_exit_flag_poll);
 
-    mjs_err_t err = mjs_exec_file(mjs, furi_string_get_cstr(worker->path), NULL);
+    mjs_err_t err = js_exec_file_cached(mjs, furi_string_get_cstr(worker->path));
 
 #ifdef JS_DEBUG
     if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug)) {
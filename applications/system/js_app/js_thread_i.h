@@ -22,6 +22,15 @@ typedef enum {
     ThreadEventCustomDataRx = (1 << 1),
 } WorkerEventFlags;
 
+/**
+ * @brief Runs pending garbage collection in slices while the script waits
+ *
+ * @param mjs mJS instance
+ * @param timeout time to spend at most, in ticks; at least one slice is run
+ * @return true if the collection is not finished yet
+ */
+bool js_gc_idle(struct mjs* mjs, uint32_t timeout);
+
 bool js_delay_with_flags(struct mjs* mjs, uint32_t time);
 
 void js_flags_set(struct mjs* mjs, uint32_t flags);
@@ -0,0 +1,463 @@
+#include "../js_modules.h" // IWYU pragma: keep
+#include <bit_lib/bit_lib.h>
+#include <toolbox/crc32_calc.h>
+
+/**
+ * @brief Resolves a byte range of a buffer argument, or prepends an error and
+ * returns from the C function
+ * @warning This macro executes `return;` by design
+ */
+#define JS_BYTES_GET_RANGE_OR_RETURN(mjs, arg_index, buf, offset, length, range, range_len) \
+    do {                                                                                   \
+        range = js_array_buf_get_range(mjs, buf, offset, length, range_len);               \
+        if(!range) {                                                                       \
+            JS_ERROR_AND_RETURN(                                                           \
+                mjs,                                                                       \
+                MJS_BAD_ARGS_ERROR,                                                        \
+                "argument %d: expected ArrayBuffer or typed array range",                  \
+                arg_index);                                                                \
+        }                                                                                  \
+    } while(0)
+
+// ==========================
+// Common argument signatures
+// ==========================
+
+static const JsValueDeclaration js_bytes_range_arg_list[] = {
+    JS_VALUE_SIMPLE(JsValueTypeAny),
+    JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+    JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+};
+static const JsValueArguments js_bytes_range_args = JS_VALUE_ARGS(js_bytes_range_arg_list);
+
+// =================
+// Memory operations
+// =================
+
+static void js_bytes_fill(struct mjs* mjs) {
+    static const JsValueDeclaration js_bytes_fill_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE(JsValueTypeInt32),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+    };
+    static const JsValueArguments js_bytes_fill_args = JS_VALUE_ARGS(js_bytes_fill_arg_list);
+
+    mjs_val_t buf;
+    int32_t value, offset, length;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_bytes_fill_args, &buf, &value, &offset, &length);
+
+    uint8_t* range;
+    size_t range_len;
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 0, buf, offset, length, range, &range_len);
+
+    memset(range, value, range_len);
+    mjs_return(mjs, MJS_UNDEFINED);
+}
+
+static void js_bytes_copy(struct mjs* mjs) {
+    static const JsValueDeclaration js_bytes_copy_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+    };
+    static const JsValueArguments js_bytes_copy_args = JS_VALUE_ARGS(js_bytes_copy_arg_list);
+
+    mjs_val_t dst, src;
+    int32_t dst_offset, src_offset, length;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(
+        mjs, &js_bytes_copy_args, &dst, &src, &dst_offset, &src_offset, &length);
+
+    uint8_t *src_range, *dst_range;
+    size_t src_len, dst_len;
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 1, src, src_offset, length, src_range, &src_len);
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 0, dst, dst_offset, src_len, dst_range, &dst_len);
+
+    // Both buffers may be views of the same storage
+    memmove(dst_range, src_range, src_len);
+    mjs_return(mjs, mjs_mk_number(mjs, src_len));
+}
+
+static void js_bytes_compare(struct mjs* mjs) {
+    static const JsValueDeclaration js_bytes_compare_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+    };
+    static const JsValueArguments js_bytes_compare_args =
+        JS_VALUE_ARGS(js_bytes_compare_arg_list);
+
+    mjs_val_t a, b;
+    int32_t length;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_bytes_compare_args, &a, &b, &length);
+
+    uint8_t *a_range, *b_range;
+    size_t a_len, b_len;
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 0, a, 0, length, a_range, &a_len);
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 1, b, 0, length, b_range, &b_len);
+
+    int result = memcmp(a_range, b_range, MIN(a_len, b_len));
+    if(result == 0) result = (a_len > b_len) - (a_len < b_len);
+    mjs_return(mjs, mjs_mk_number(mjs, (result > 0) - (result < 0)));
+}
+
+static void js_bytes_xor(struct mjs* mjs) {
+    static const JsValueDeclaration js_bytes_xor_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+    };
+    static const JsValueArguments js_bytes_xor_args = JS_VALUE_ARGS(js_bytes_xor_arg_list);
+
+    mjs_val_t buf, key;
+    int32_t offset, length;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_bytes_xor_args, &buf, &key, &offset, &length);
+
+    uint8_t *range, *key_range;
+    size_t range_len, key_len;
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 0, buf, offset, length, range, &range_len);
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 1, key, 0, -1, key_range, &key_len);
+    if(key_len == 0) JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "argument 1: empty key");
+
+    // The key repeats over the range
+    for(size_t i = 0, k = 0; i < range_len; i++) {
+        range[i] ^= key_range[k];
+        if(++k == key_len) k = 0;
+    }
+    mjs_return(mjs, MJS_UNDEFINED);
+}
+
+// =========
+// Checksums
+// =========
+
+static void js_bytes_crc8(struct mjs* mjs) {
+    static const JsValueDeclaration js_bytes_crc8_poly =
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0x07);
+    static const JsValueDeclaration js_bytes_crc_int_zero =
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0);
+    static const JsValueDeclaration js_bytes_crc_bool_false =
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeBool, bool_val, false);
+    static const JsValueObjectField js_bytes_crc8_fields[] = {
+        {"poly", &js_bytes_crc8_poly},
+        {"init", &js_bytes_crc_int_zero},
+        {"refIn", &js_bytes_crc_bool_false},
+        {"refOut", &js_bytes_crc_bool_false},
+        {"xorOut", &js_bytes_crc_int_zero},
+    };
+    static const JsValueDeclaration js_bytes_crc8_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_OBJECT_W_DEFAULTS(js_bytes_crc8_fields),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+    };
+    static const JsValueArguments js_bytes_crc8_args = JS_VALUE_ARGS(js_bytes_crc8_arg_list);
+
+    mjs_val_t buf;
+    int32_t poly = 0x07, init = 0, xor_out = 0, offset, length;
+    bool ref_in = false, ref_out = false;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(
+        mjs,
+        &js_bytes_crc8_args,
+        &buf,
+        &poly,
+        &init,
+        &ref_in,
+        &ref_out,
+        &xor_out,
+        &offset,
+        &length);
+
+    uint8_t* range;
+    size_t range_len;
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 0, buf, offset, length, range, &range_len);
+
+    uint8_t crc = bit_lib_crc8(range, range_len, poly, init, ref_in, ref_out, xor_out);
+    mjs_return(mjs, mjs_mk_number(mjs, crc));
+}
+
+static void js_bytes_crc16(struct mjs* mjs) {
+    static const JsValueDeclaration js_bytes_crc16_poly =
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0x1021);
+    static const JsValueDeclaration js_bytes_crc16_init =
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0xFFFF);
+    static const JsValueDeclaration js_bytes_crc_int_zero =
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0);
+    static const JsValueDeclaration js_bytes_crc_bool_false =
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeBool, bool_val, false);
+    static const JsValueObjectField js_bytes_crc16_fields[] = {
+        {"poly", &js_bytes_crc16_poly},
+        {"init", &js_bytes_crc16_init},
+        {"refIn", &js_bytes_crc_bool_false},
+        {"refOut", &js_bytes_crc_bool_false},
+        {"xorOut", &js_bytes_crc_int_zero},
+    };
+    static const JsValueDeclaration js_bytes_crc16_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_OBJECT_W_DEFAULTS(js_bytes_crc16_fields),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+    };
+    static const JsValueArguments js_bytes_crc16_args = JS_VALUE_ARGS(js_bytes_crc16_arg_list);
+
+    mjs_val_t buf;
+    int32_t poly = 0x1021, init = 0xFFFF, xor_out = 0, offset, length;
+    bool ref_in = false, ref_out = false;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(
+        mjs,
+        &js_bytes_crc16_args,
+        &buf,
+        &poly,
+        &init,
+        &ref_in,
+        &ref_out,
+        &xor_out,
+        &offset,
+        &length);
+
+    uint8_t* range;
+    size_t range_len;
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 0, buf, offset, length, range, &range_len);
+
+    uint16_t crc = bit_lib_crc16(range, range_len, poly, init, ref_in, ref_out, xor_out);
+    mjs_return(mjs, mjs_mk_number(mjs, crc));
+}
+
+static void js_bytes_crc32(struct mjs* mjs) {
+    static const JsValueDeclaration js_bytes_crc32_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeDouble, double_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+    };
+    static const JsValueArguments js_bytes_crc32_args = JS_VALUE_ARGS(js_bytes_crc32_arg_list);
+
+    mjs_val_t buf;
+    double prev_crc;
+    int32_t offset, length;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_bytes_crc32_args, &buf, &prev_crc, &offset, &length);
+
+    uint8_t* range;
+    size_t range_len;
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 0, buf, offset, length, range, &range_len);
+
+    // Doubles hold the whole uint32_t range, unlike int32 arguments
+    uint32_t crc = crc32_calc_buffer((uint32_t)(int64_t)prev_crc, range, range_len);
+    mjs_return(mjs, mjs_mk_number(mjs, crc));
+}
+
+// ==============
+// Bit operations
+// ==============
+
+static bool js_bytes_bit_range_fits(size_t byte_len, int32_t position, int32_t count) {
+    return position >= 0 && count >= 0 && (uint64_t)position + count <= (uint64_t)byte_len * 8;
+}
+
+static void js_bytes_get_bits(struct mjs* mjs) {
+    static const JsValueDeclaration js_bytes_get_bits_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE(JsValueTypeInt32),
+        JS_VALUE_SIMPLE(JsValueTypeInt32),
+    };
+    static const JsValueArguments js_bytes_get_bits_args =
+        JS_VALUE_ARGS(js_bytes_get_bits_arg_list);
+
+    mjs_val_t buf;
+    int32_t position, count;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_bytes_get_bits_args, &buf, &position, &count);
+
+    uint8_t* range;
+    size_t range_len;
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 0, buf, 0, -1, range, &range_len);
+    if(count < 1 || count > 32 || !js_bytes_bit_range_fits(range_len, position, count))
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "1 to 32 bits must fit in the buffer");
+
+    mjs_return(mjs, mjs_mk_number(mjs, bit_lib_get_bits_32(range, position, count)));
+}
+
+static void js_bytes_copy_bits(struct mjs* mjs) {
+    static const JsValueDeclaration js_bytes_copy_bits_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE(JsValueTypeInt32),
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE(JsValueTypeInt32),
+        JS_VALUE_SIMPLE(JsValueTypeInt32),
+    };
+    static const JsValueArguments js_bytes_copy_bits_args =
+        JS_VALUE_ARGS(js_bytes_copy_bits_arg_list);
+
+    mjs_val_t dst, src;
+    int32_t dst_position, src_position, count;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(
+        mjs, &js_bytes_copy_bits_args, &dst, &dst_position, &src, &src_position, &count);
+
+    uint8_t *dst_range, *src_range;
+    size_t dst_len, src_len;
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 0, dst, 0, -1, dst_range, &dst_len);
+    JS_BYTES_GET_RANGE_OR_RETURN(mjs, 2, src, 0, -1, src_range, &src_len);
+    if(!js_bytes_bit_range_fits(dst_len, dst_position, count) ||
+       !js_bytes_bit_range_fits(src_len, src_position, count))
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "bits must fit in both buffers");
+
+    bit_lib_copy_bits(dst_range, dst_position, count, src_range, src_position);
+    mjs_return(mjs, MJS_UNDEFINED);
+}
+
+// ==========
+// Reductions
+// ==========
+
+typedef enum {
+    JsBytesReduceMin,
+    JsBytesReduceMax,
+    JsBytesReduceSum,
+} JsBytesReduce;
+
+static size_t js_bytes_element_size(mjs_dataview_type_t type) {
+    switch(type) {
+    case MJS_DATAVIEW_U16:
+    case MJS_DATAVIEW_I16:
+        return 2;
+    case MJS_DATAVIEW_U32:
+    case MJS_DATAVIEW_I32:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+static int64_t js_bytes_get_element(const uint8_t* data, mjs_dataview_type_t type) {
+    // Elements following the buffer header are not necessarily aligned
+    switch(type) {
+    case MJS_DATAVIEW_I8:
+        return (int8_t)data[0];
+    case MJS_DATAVIEW_U16: {
+        uint16_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    case MJS_DATAVIEW_I16: {
+        int16_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    case MJS_DATAVIEW_U32: {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    case MJS_DATAVIEW_I32: {
+        int32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    default:
+        return data[0];
+    }
+}
+
+static void js_bytes_reduce(struct mjs* mjs, JsBytesReduce reduce) {
+    mjs_val_t buf;
+    int32_t offset, count;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_bytes_range_args, &buf, &offset, &count);
+
+    // Offset and count are in elements of the typed array
+    mjs_dataview_type_t type = mjs_dataview_get_type(mjs, buf);
+    size_t element_size = js_bytes_element_size(type);
+    if(offset > INT32_MAX / 4 || count > INT32_MAX / 4)
+        JS_ERROR_AND_RETURN(mjs, MJS_BAD_ARGS_ERROR, "range out of bounds");
+
+    uint8_t* range;
+    size_t range_len;
+    int32_t length = (count < 0) ? -1 : count * (int32_t)element_size;
+    JS_BYTES_GET_RANGE_OR_RETURN(
+        mjs, 0, buf, offset * (int32_t)element_size, length, range, &range_len);
+
+    size_t n_elements = range_len / element_size;
+    if(n_elements == 0) {
+        mjs_return(mjs, (reduce == JsBytesReduceSum) ? mjs_mk_number(mjs, 0) : MJS_UNDEFINED);
+        return;
+    }
+
+    int64_t result = js_bytes_get_element(range, type);
+    for(size_t i = 1; i < n_elements; i++) {
+        int64_t value = js_bytes_get_element(&range[i * element_size], type);
+        if(reduce == JsBytesReduceMin) {
+            if(value < result) result = value;
+        } else if(reduce == JsBytesReduceMax) {
+            if(value > result) result = value;
+        } else {
+            result += value;
+        }
+    }
+
+    mjs_return(mjs, mjs_mk_number(mjs, result));
+}
+
+static void js_bytes_min(struct mjs* mjs) {
+    js_bytes_reduce(mjs, JsBytesReduceMin);
+}
+
+static void js_bytes_max(struct mjs* mjs) {
+    js_bytes_reduce(mjs, JsBytesReduceMax);
+}
+
+static void js_bytes_sum(struct mjs* mjs) {
+    js_bytes_reduce(mjs, JsBytesReduceSum);
+}
+
+// ==================
+// Module ctor & dtor
+// ==================
+
+static void* js_bytes_create(struct mjs* mjs, mjs_val_t* object, JsModules* modules) {
+    UNUSED(modules);
+    *object = mjs_mk_object(mjs);
+    JS_ASSIGN_MULTI(mjs, *object) {
+        // memory ops
+        JS_FIELD("fill", MJS_MK_FN(js_bytes_fill));
+        JS_FIELD("copy", MJS_MK_FN(js_bytes_copy));
+        JS_FIELD("compare", MJS_MK_FN(js_bytes_compare));
+        JS_FIELD("xor", MJS_MK_FN(js_bytes_xor));
+
+        // checksums
+        JS_FIELD("crc8", MJS_MK_FN(js_bytes_crc8));
+        JS_FIELD("crc16", MJS_MK_FN(js_bytes_crc16));
+        JS_FIELD("crc32", MJS_MK_FN(js_bytes_crc32));
+
+        // bit ops
+        JS_FIELD("getBits", MJS_MK_FN(js_bytes_get_bits));
+        JS_FIELD("copyBits", MJS_MK_FN(js_bytes_copy_bits));
+
+        // reductions
+        JS_FIELD("min", MJS_MK_FN(js_bytes_min));
+        JS_FIELD("max", MJS_MK_FN(js_bytes_max));
+        JS_FIELD("sum", MJS_MK_FN(js_bytes_sum));
+    }
+    return NULL;
+}
+
+// ===========
+// Boilerplate
+// ===========
+
+static const JsModuleDescriptor js_bytes_desc = {
+    "bytes",
+    js_bytes_create,
+    NULL,
+    NULL,
+};
+
+static const FlipperAppPluginDescriptor plugin_descriptor = {
+    .appid = PLUGIN_APP_ID,
+    .ep_api_version = PLUGIN_API_VERSION,
+    .entry_point = &js_bytes_desc,
+};
+
+const FlipperAppPluginDescriptor* js_bytes_ep(void) {
+    return &plugin_descriptor;
+}
@@ -8,6 +8,12 @@
  */
 #define SYSTEM_ARGS 2
 
+/**
+ * @brief Idle time after which pending garbage collection runs, and the time it may take then
+ */
+#define GC_IDLE_INTERVAL 50
+#define GC_IDLE_SLICE    5
+
 /**
  * @brief Context passed to the generic event callback
  */
@@ -44,6 +50,7 @@ ARRAY_DEF(ContractArray, JsEventLoopContract*, M_PTR_OPLIST); //-V575
  * @brief Per-module instance control structure
  */
 struct JsEventLoop {
+    struct mjs* mjs;
     FuriEventLoop* loop;
     SubscriptionArray_t subscriptions;
     ContractArray_t owned_contracts; //<! Contracts that were produced by this module
@@ -227,6 +234,14 @@ static void js_event_loop_subscribe(struct mjs* mjs) {
     mjs_return(mjs, subscription_obj);
 }
 
+/**
+ * @brief Tick callback, collects garbage left by the JS callbacks while there are no events
+ */
+static void js_event_loop_tick(void* param) {
+    JsEventLoop* module = param;
+    js_gc_idle(module->mjs, GC_IDLE_SLICE);
+}
+
 /**
  * @brief Runs the event loop until it is stopped
  */
@@ -362,7 +377,9 @@ static void* js_event_loop_create(struct mjs* mjs, mjs_val_t* object, JsModules*
     UNUSED(modules);
     mjs_val_t event_loop_obj = mjs_mk_object(mjs);
     JsEventLoop* module = malloc(sizeof(JsEventLoop));
+    module->mjs = mjs;
     module->loop = furi_event_loop_alloc();
+    furi_event_loop_tick_set(module->loop, GC_IDLE_INTERVAL, js_event_loop_tick, module);
     SubscriptionArray_init(module->subscriptions);
     ContractArray_init(module->owned_contracts);
 
@@ -307,6 +307,66 @@ static void js_serial_read_bytes(struct mjs* mjs) {
     free(read_buf);
 }
 
+static void js_serial_read_into(struct mjs* mjs) {
+    JsSerialInst* serial = JS_GET_CONTEXT(mjs);
+    furi_assert(serial);
+    if(!serial->setup_done)
+        JS_ERROR_AND_RETURN(mjs, MJS_INTERNAL_ERROR, "Serial is not configured");
+
+    static const JsValueDeclaration js_serial_read_into_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, INT32_MAX),
+    };
+    static const JsValueArguments js_serial_read_into_args =
+        JS_VALUE_ARGS(js_serial_read_into_arg_list);
+
+    mjs_val_t buf;
+    int32_t offset, length, timeout;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(
+        mjs, &js_serial_read_into_args, &buf, &offset, &length, &timeout);
+
+    size_t range_len;
+    uint8_t* range = js_array_buf_get_range(mjs, buf, offset, length, &range_len);
+    if(!range) {
+        JS_ERROR_AND_RETURN(
+            mjs, MJS_BAD_ARGS_ERROR, "argument 0: expected ArrayBuffer or typed array range");
+    }
+
+    size_t bytes_read = js_serial_receive(serial, (char*)range, range_len, timeout);
+    mjs_return(mjs, mjs_mk_number(mjs, bytes_read));
+}
+
+static void js_serial_write_from(struct mjs* mjs) {
+    JsSerialInst* serial = JS_GET_CONTEXT(mjs);
+    furi_assert(serial);
+    if(!serial->setup_done)
+        JS_ERROR_AND_RETURN(mjs, MJS_INTERNAL_ERROR, "Serial is not configured");
+
+    static const JsValueDeclaration js_serial_write_from_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+        JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+    };
+    static const JsValueArguments js_serial_write_from_args =
+        JS_VALUE_ARGS(js_serial_write_from_arg_list);
+
+    mjs_val_t buf;
+    int32_t offset, length;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_serial_write_from_args, &buf, &offset, &length);
+
+    size_t range_len;
+    uint8_t* range = js_array_buf_get_range(mjs, buf, offset, length, &range_len);
+    if(!range) {
+        JS_ERROR_AND_RETURN(
+            mjs, MJS_BAD_ARGS_ERROR, "argument 0: expected ArrayBuffer or typed array range");
+    }
+
+    furi_hal_serial_tx(serial->serial_handle, range, range_len);
+    mjs_return(mjs, mjs_mk_number(mjs, range_len));
+}
+
 static char* js_serial_receive_any(JsSerialInst* serial, size_t* len, uint32_t timeout) {
     uint32_t flags = ThreadEventCustomDataRx;
     if(furi_stream_buffer_is_empty(serial->rx_stream)) {
@@ -590,6 +650,8 @@ static void* js_serial_create(struct mjs* mjs, mjs_val_t* object, JsModules* mod
         JS_FIELD("readln", MJS_MK_FN(js_serial_readln));
         JS_FIELD("readBytes", MJS_MK_FN(js_serial_read_bytes));
         JS_FIELD("readAny", MJS_MK_FN(js_serial_read_any));
+        JS_FIELD("readInto", MJS_MK_FN(js_serial_read_into));
+        JS_FIELD("writeFrom", MJS_MK_FN(js_serial_write_from));
         JS_FIELD("expect", MJS_MK_FN(js_serial_expect));
     }
     *object = serial_obj;
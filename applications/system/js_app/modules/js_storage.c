@@ -21,6 +21,14 @@ static const JsValueDeclaration js_storage_2_str_arg_list[] = {
 };
 static const JsValueArguments js_storage_2_str_args = JS_VALUE_ARGS(js_storage_2_str_arg_list);
 
+static const JsValueDeclaration js_storage_buf_range_arg_list[] = {
+    JS_VALUE_SIMPLE(JsValueTypeAny),
+    JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, 0),
+    JS_VALUE_SIMPLE_W_DEFAULT(JsValueTypeInt32, int32_val, -1),
+};
+static const JsValueArguments js_storage_buf_range_args =
+    JS_VALUE_ARGS(js_storage_buf_range_arg_list);
+
 // ======================
 // File object operations
 // ======================
@@ -55,13 +63,97 @@ static void js_storage_file_read(struct mjs* mjs) {
     JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_storage_read_args, &read_mode, &length);
 
     File* file = JS_GET_CONTEXT(mjs);
-    char buffer[length];
-    size_t actually_read = storage_file_read(file, buffer, length);
+    // Don't reserve more than what is left in the file
+    uint64_t size = storage_file_size(file), position = storage_file_tell(file);
+    uint64_t remaining = (size > position) ? size - position : 0;
+    if(length < 0) length = 0;
+    if((uint64_t)length > remaining) length = remaining;
+
     if(read_mode == JsStorageReadModeAscii) {
+        char* buffer = malloc(length);
+        size_t actually_read = storage_file_read(file, buffer, length);
         mjs_return(mjs, mjs_mk_string(mjs, buffer, actually_read, true));
+        free(buffer);
     } else if(read_mode == JsStorageReadModeBinary) {
-        mjs_return(mjs, mjs_mk_array_buf(mjs, buffer, actually_read));
+        mjs_val_t array_buf = mjs_mk_array_buf(mjs, NULL, length);
+        char* buffer = mjs_array_buf_get_ptr(mjs, array_buf, NULL);
+        size_t actually_read = storage_file_read(file, buffer, length);
+        if(actually_read != (size_t)length) {
+            array_buf = mjs_mk_array_buf(mjs, buffer, actually_read);
+        }
+        mjs_return(mjs, array_buf);
+    }
+}
+
+static void js_storage_file_read_into(struct mjs* mjs) {
+    mjs_val_t buf;
+    int32_t offset, length;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_storage_buf_range_args, &buf, &offset, &length);
+
+    size_t range_len;
+    uint8_t* range = js_array_buf_get_range(mjs, buf, offset, length, &range_len);
+    if(!range) {
+        JS_ERROR_AND_RETURN(
+            mjs, MJS_BAD_ARGS_ERROR, "argument 0: expected ArrayBuffer or typed array range");
+    }
+
+    File* file = JS_GET_CONTEXT(mjs);
+    mjs_return(mjs, mjs_mk_number(mjs, storage_file_read(file, range, range_len)));
+}
+
+static void js_storage_file_write_from(struct mjs* mjs) {
+    mjs_val_t buf;
+    int32_t offset, length;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_storage_buf_range_args, &buf, &offset, &length);
+
+    size_t range_len;
+    uint8_t* range = js_array_buf_get_range(mjs, buf, offset, length, &range_len);
+    if(!range) {
+        JS_ERROR_AND_RETURN(
+            mjs, MJS_BAD_ARGS_ERROR, "argument 0: expected ArrayBuffer or typed array range");
     }
+
+    File* file = JS_GET_CONTEXT(mjs);
+    mjs_return(mjs, mjs_mk_number(mjs, storage_file_write(file, range, range_len)));
+}
+
+static void js_storage_file_for_each_chunk(struct mjs* mjs) {
+    static const JsValueDeclaration js_storage_for_each_chunk_arg_list[] = {
+        JS_VALUE_SIMPLE(JsValueTypeAny),
+        JS_VALUE_SIMPLE(JsValueTypeFunction),
+    };
+    static const JsValueArguments js_storage_for_each_chunk_args =
+        JS_VALUE_ARGS(js_storage_for_each_chunk_arg_list);
+
+    mjs_val_t buf, callback;
+    JS_VALUE_PARSE_ARGS_OR_RETURN(mjs, &js_storage_for_each_chunk_args, &buf, &callback);
+
+    size_t chunk_len;
+    if(!js_array_buf_get_range(mjs, buf, 0, -1, &chunk_len) || chunk_len == 0) {
+        JS_ERROR_AND_RETURN(
+            mjs, MJS_BAD_ARGS_ERROR, "argument 0: expected non-empty ArrayBuffer or typed array");
+    }
+
+    File* file = JS_GET_CONTEXT(mjs);
+    uint64_t total = 0;
+
+    while(true) {
+        // The callback may allocate buffers and move the storage, look it up every time
+        uint8_t* chunk = js_array_buf_get_range(mjs, buf, 0, -1, &chunk_len);
+        size_t actually_read = storage_file_read(file, chunk, chunk_len);
+        if(actually_read == 0) break;
+        total += actually_read;
+
+        mjs_val_t result = MJS_UNDEFINED;
+        mjs_val_t args[] = {buf, mjs_mk_number(mjs, actually_read)};
+        if(mjs_apply(mjs, &result, callback, MJS_UNDEFINED, COUNT_OF(args), args) != MJS_OK) {
+            return;
+        }
+        if(mjs_is_boolean(result) && !mjs_get_bool(mjs, result)) break;
+        if(actually_read < chunk_len) break;
+    }
+
+    mjs_return(mjs, mjs_mk_number(mjs, total));
 }
 
 static void js_storage_file_write(struct mjs* mjs) {
@@ -192,6 +284,9 @@ static void js_storage_open_file(struct mjs* mjs) {
         JS_FIELD("isOpen", MJS_MK_FN(js_storage_file_is_open));
         JS_FIELD("read", MJS_MK_FN(js_storage_file_read));
         JS_FIELD("write", MJS_MK_FN(js_storage_file_write));
+        JS_FIELD("readInto", MJS_MK_FN(js_storage_file_read_into));
+        JS_FIELD("writeFrom", MJS_MK_FN(js_storage_file_write_from));
+        JS_FIELD("forEachChunk", MJS_MK_FN(js_storage_file_for_each_chunk));
         JS_FIELD("seekRelative", MJS_MK_FN(js_storage_file_seek_relative));
         JS_FIELD("seekAbsolute", MJS_MK_FN(js_storage_file_seek_absolute));
         JS_FIELD("tell", MJS_MK_FN(js_storage_file_tell));
@@ -0,0 +1,140 @@
+/**
+ * Native bulk operations on `ArrayBuffer`s and typed arrays
+ *
+ * Unless stated otherwise, offsets and lengths are counted in bytes, even for
+ * typed arrays with wider elements. An unset length covers the buffer up to
+ * its end.
+ *
+ * @version Added in JS SDK 1.1
+ * @module
+ */
+
+export type Buffer = ArrayBuffer | TypedArray<ElementType>;
+
+/**
+ * CRC parameters, see the "Catalogue of parametrised CRC algorithms" for the
+ * values of well-known variants
+ * @version Added in JS SDK 1.1
+ */
+export interface CrcParams {
+    /** Polynomial, without the top bit */
+    poly?: number;
+    /** Initial register value */
+    init?: number;
+    /** Whether input bytes are reflected (LSB first) */
+    refIn?: boolean;
+    /** Whether the result is reflected */
+    refOut?: boolean;
+    /** Value to XOR the result with */
+    xorOut?: number;
+}
+
+/**
+ * @brief Sets every byte of a range to a value
+ * @param buffer Buffer to fill
+ * @param value Byte value
+ * @param offset Offset of the range, 0 if unset
+ * @param length Length of the range
+ * @version Added in JS SDK 1.1
+ */
+export declare function fill(buffer: Buffer, value: number, offset?: number, length?: number): void;
+
+/**
+ * @brief Copies a range of one buffer into another. The ranges may overlap.
+ * @param dest Buffer to copy into
+ * @param src Buffer to copy from
+ * @param destOffset Offset in `dest`, 0 if unset
+ * @param srcOffset Offset in `src`, 0 if unset
+ * @param length The number of bytes to copy, up to the end of `src` if unset
+ * @returns The number of bytes copied
+ * @version Added in JS SDK 1.1
+ */
+export declare function copy(dest: Buffer, src: Buffer, destOffset?: number, srcOffset?: number, length?: number): number;
+
+/**
+ * @brief Compares two buffers byte by byte
+ * @param length The number of bytes to compare, both buffers if unset
+ * @returns -1, 0 or 1 if `a` orders before, the same as, or after `b`. A
+ *          buffer that is a prefix of the other one orders before it.
+ * @version Added in JS SDK 1.1
+ */
+export declare function compare(a: Buffer, b: Buffer, length?: number): -1 | 0 | 1;
+
+/**
+ * @brief XORs a range of a buffer with a key, in place
+ * @param buffer Buffer to modify
+ * @param key Key bytes, repeated over the range if it is shorter
+ * @param offset Offset of the range, 0 if unset
+ * @param length Length of the range
+ * @version Added in JS SDK 1.1
+ */
+export declare function xor(buffer: Buffer, key: Buffer, offset?: number, length?: number): void;
+
+/**
+ * @brief Calculates a CRC-8, CRC-8/SMBUS (`poly: 0x07`) by default
+ * @version Added in JS SDK 1.1
+ */
+export declare function crc8(buffer: Buffer, params?: CrcParams, offset?: number, length?: number): number;
+
+/**
+ * @brief Calculates a CRC-16, CRC-16/CCITT-FALSE (`poly: 0x1021`,
+ * `init: 0xFFFF`) by default
+ * @version Added in JS SDK 1.1
+ */
+export declare function crc16(buffer: Buffer, params?: CrcParams, offset?: number, length?: number): number;
+
+/**
+ * @brief Calculates the CRC-32 used by zip and Ethernet
+ * @param crc CRC of the preceding data, to calculate the CRC of data
+ *            split into several buffers. 0 if unset.
+ * @version Added in JS SDK 1.1
+ */
+export declare function crc32(buffer: Buffer, crc?: number, offset?: number, length?: number): number;
+
+/**
+ * @brief Reads an unsigned number from a bit field
+ *
+ * Bits are numbered from the most significant bit of the first byte.
+ *
+ * @param position Bit position of the field
+ * @param count Width of the field, 1 to 32 bits
+ * @version Added in JS SDK 1.1
+ */
+export declare function getBits(buffer: Buffer, position: number, count: number): number;
+
+/**
+ * @brief Copies bits from one buffer to another, numbered like in `getBits`
+ * @param dest Buffer to copy into
+ * @param destPosition Bit position in `dest`
+ * @param src Buffer to copy from
+ * @param srcPosition Bit position in `src`
+ * @param count The number of bits to copy
+ * @version Added in JS SDK 1.1
+ */
+export declare function copyBits(dest: Buffer, destPosition: number, src: Buffer, srcPosition: number, count: number): void;
+
+/**
+ * @brief Finds the smallest element. `ArrayBuffer`s are read as bytes.
+ * @param offset Index of the first element, 0 if unset
+ * @param count The number of elements, up to the end if unset
+ * @returns The smallest element, or `undefined` if there are none
+ * @version Added in JS SDK 1.1
+ */
+export declare function min(array: Buffer, offset?: number, count?: number): number | undefined;
+
+/**
+ * @brief Finds the largest element. `ArrayBuffer`s are read as bytes.
+ * @param offset Index of the first element, 0 if unset
+ * @param count The number of elements, up to the end if unset
+ * @returns The largest element, or `undefined` if there are none
+ * @version Added in JS SDK 1.1
+ */
+export declare function max(array: Buffer, offset?: number, count?: number): number | undefined;
+
+/**
+ * @brief Adds the elements up. `ArrayBuffer`s are read as bytes.
+ * @param offset Index of the first element, 0 if unset
+ * @param count The number of elements, up to the end if unset
+ * @version Added in JS SDK 1.1
+ */
+export declare function sum(array: Buffer, offset?: number, count?: number): number;
@@ -99,6 +99,34 @@ export declare function readAny(timeout?: number): string | undefined;
  */
 export declare function readBytes(length: number, timeout?: number): ArrayBuffer;
 
+/**
+ * @brief Reads data from the serial port straight into an existing buffer,
+ * without allocating a new one
+ * @param buffer The buffer to read into. For typed arrays, offsets and lengths
+ *               are still counted in bytes
+ * @param offset Byte offset in the buffer to start writing at, 0 if unset
+ * @param length The number of bytes to read, up to the end of the buffer if
+ *               unset
+ * @param timeout The number of time, in milliseconds, after which this function
+ *                will give up and return what it read up to that point. If
+ *                unset, the function will wait forever.
+ * @returns The number of bytes read
+ * @version Added in JS SDK 1.1
+ */
+export declare function readInto<E extends ElementType>(buffer: ArrayBuffer | TypedArray<E>, offset?: number, length?: number, timeout?: number): number;
+
+/**
+ * @brief Writes a range of an existing buffer to the serial port
+ * @param buffer The buffer to write from. For typed arrays, offsets and lengths
+ *               are still counted in bytes
+ * @param offset Byte offset in the buffer to start reading at, 0 if unset
+ * @param length The number of bytes to write, up to the end of the buffer if
+ *               unset
+ * @returns The number of bytes written
+ * @version Added in JS SDK 1.1
+ */
+export declare function writeFrom<E extends ElementType>(buffer: ArrayBuffer | TypedArray<E>, offset?: number, length?: number): number;
+
 /**
  * @brief Reads data from the serial port, trying to match it to a pattern
  * @param patterns A single pattern or an array of patterns:
@@ -113,6 +113,40 @@ export declare class File {
      * @version Added in JS SDK 0.1
      */
     write(data: ArrayBuffer | string): number;
+    /**
+     * Reads bytes from a file straight into an existing buffer, without
+     * allocating a new one
+     * @param buffer The buffer to read into. For typed arrays, offsets and
+     *               lengths are still counted in bytes
+     * @param offset Byte offset in the buffer to start writing at, 0 if unset
+     * @param length How many bytes to read, up to the end of the buffer if
+     *               unset
+     * @returns the amount of bytes that was actually read
+     * @version Added in JS SDK 1.1
+     */
+    readInto<E extends ElementType>(buffer: ArrayBuffer | TypedArray<E>, offset?: number, length?: number): number;
+    /**
+     * Writes bytes to a file straight from an existing buffer
+     * @param buffer The buffer to write from. For typed arrays, offsets and
+     *               lengths are still counted in bytes
+     * @param offset Byte offset in the buffer to start reading at, 0 if unset
+     * @param length How many bytes to write, up to the end of the buffer if
+     *               unset
+     * @returns the amount of bytes that was actually written
+     * @version Added in JS SDK 1.1
+     */
+    writeFrom<E extends ElementType>(buffer: ArrayBuffer | TypedArray<E>, offset?: number, length?: number): number;
+    /**
+     * Streams the file from the R/W pointer to its end through one buffer,
+     * chunk after chunk
+     * @param buffer The buffer every chunk is read into. Its contents are
+     *               overwritten by the next chunk once the callback returns.
+     * @param callback Called with the buffer and the amount of bytes read
+     *                 into it. Returning `false` stops the iteration.
+     * @returns the total amount of bytes read
+     * @version Added in JS SDK 1.1
+     */
+    forEachChunk<B extends ArrayBuffer | TypedArray<ElementType>>(buffer: B, callback: (buffer: B, bytes: number) => boolean | void): number;
     /**
      * Moves the R/W pointer forward
      * @param bytes How many bytes to move the pointer forward by
@@ -6,9 +6,14 @@
  * TBD: automatically generate this table from app's header files
  */
 static constexpr auto app_api_table = sort(create_array_t<sym_entry>(
+    API_METHOD(
+        js_array_buf_get_range,
+        uint8_t*,
+        (struct mjs*, mjs_val_t, int32_t, int32_t, size_t*)),
     API_METHOD(js_delay_with_flags, bool, (struct mjs*, uint32_t)),
     API_METHOD(js_flags_set, void, (struct mjs*, uint32_t)),
     API_METHOD(js_flags_wait, uint32_t, (struct mjs*, uint32_t, uint32_t)),
+    API_METHOD(js_gc_idle, bool, (struct mjs*, uint32_t)),
     API_METHOD(js_module_get, void*, (JsModules*, const char*)),
     API_METHOD(js_value_buffer_size, size_t, (const JsValueParseDeclaration declaration)),
     API_METHOD(
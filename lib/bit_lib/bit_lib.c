@@ -2,6 +2,89 @@
 #include <core/check.h>
 #include <stdio.h>
 
+// Bits are numbered MSB first: bit 0 is the most significant bit of data[0].
+// The kernels below move up to 32 bits at once and only touch the bytes that hold them.
+
+static const uint8_t bit_lib_reverse_table[256] = {
+    0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0,
+    0x30, 0xB0, 0x70, 0xF0, 0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8,
+    0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8, 0x04, 0x84, 0x44, 0xC4,
+    0x24, 0xA4, 0x64, 0xE4, 0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
+    0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC, 0x1C, 0x9C, 0x5C, 0xDC,
+    0x3C, 0xBC, 0x7C, 0xFC, 0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2,
+    0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2, 0x0A, 0x8A, 0x4A, 0xCA,
+    0x2A, 0xAA, 0x6A, 0xEA, 0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
+    0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6, 0x16, 0x96, 0x56, 0xD6,
+    0x36, 0xB6, 0x76, 0xF6, 0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE,
+    0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE, 0x01, 0x81, 0x41, 0xC1,
+    0x21, 0xA1, 0x61, 0xE1, 0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
+    0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9, 0x19, 0x99, 0x59, 0xD9,
+    0x39, 0xB9, 0x79, 0xF9, 0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5,
+    0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5, 0x0D, 0x8D, 0x4D, 0xCD,
+    0x2D, 0xAD, 0x6D, 0xED, 0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
+    0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3, 0x13, 0x93, 0x53, 0xD3,
+    0x33, 0xB3, 0x73, 0xF3, 0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB,
+    0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB, 0x07, 0x87, 0x47, 0xC7,
+    0x27, 0xA7, 0x67, 0xE7, 0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
+    0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF, 0x1F, 0x9F, 0x5F, 0xDF,
+    0x3F, 0xBF, 0x7F, 0xFF,
+};
+
+static inline uint32_t bit_lib_mask_32(uint8_t length) {
+    return (length >= 32) ? UINT32_MAX : ((1UL << length) - 1);
+}
+
+static inline uint32_t bit_lib_reverse_32(uint32_t value) {
+    return ((uint32_t)bit_lib_reverse_table[value & 0xFF] << 24) |
+           ((uint32_t)bit_lib_reverse_table[(value >> 8) & 0xFF] << 16) |
+           ((uint32_t)bit_lib_reverse_table[(value >> 16) & 0xFF] << 8) |
+           ((uint32_t)bit_lib_reverse_table[value >> 24]);
+}
+
+static uint32_t bit_lib_load_bits(const uint8_t* data, size_t position, uint8_t length) {
+    furi_assert(length <= 32);
+    if(length == 0) return 0;
+
+    const uint8_t* src = &data[position / 8];
+    const uint8_t shift = position % 8;
+    const size_t bytes_num = (shift + length + 7) / 8;
+
+    uint32_t word = 0;
+    const size_t word_bytes_num = (bytes_num > 4) ? 4 : bytes_num;
+    for(size_t i = 0; i < word_bytes_num; i++) {
+        word = (word << 8) | src[i];
+    }
+
+    if(bytes_num > 4) {
+        // The bits span five bytes, drop the leading bits and pull in the tail
+        word = (word << shift) | (src[4] >> (8 - shift));
+        word >>= 32 - length;
+    } else {
+        word >>= word_bytes_num * 8 - shift - length;
+    }
+
+    return word & bit_lib_mask_32(length);
+}
+
+static void bit_lib_store_bits(uint8_t* data, size_t position, uint32_t value, uint8_t length) {
+    furi_assert(length <= 32);
+    if(length == 0) return;
+
+    uint8_t* dst = &data[position / 8];
+    const uint8_t shift = position % 8;
+    const size_t bytes_num = (shift + length + 7) / 8;
+    const uint8_t tail = bytes_num * 8 - shift - length;
+
+    const uint64_t mask = (uint64_t)bit_lib_mask_32(length) << tail;
+    const uint64_t bits = ((uint64_t)value << tail) & mask;
+
+    for(size_t i = 0; i < bytes_num; i++) {
+        const uint8_t byte_shift = (bytes_num - 1 - i) * 8;
+        const uint8_t byte_mask = mask >> byte_shift;
+        dst[i] = (dst[i] & ~byte_mask) | (uint8_t)(bits >> byte_shift);
+    }
+}
+
 void bit_lib_push_bit(uint8_t* data, size_t data_size, bool bit) {
     size_t last_index = data_size - 1;
 
@@ -23,10 +106,7 @@ void bit_lib_set_bits(uint8_t* data, size_t position, uint8_t byte, uint8_t leng
     furi_check(length <= 8);
     furi_check(length > 0);
 
-    for(uint8_t i = 0; i < length; ++i) {
-        uint8_t shift = (length - 1) - i;
-        bit_lib_set_bit(data, position + i, (byte >> shift) & 1); //-V610
-    }
+    bit_lib_store_bits(data, position, byte & bit_lib_mask_32(length), length);
 }
 
 bool bit_lib_get_bit(const uint8_t* data, size_t position) {
@@ -34,114 +114,44 @@ bool bit_lib_get_bit(const uint8_t* data, size_t position) {
 }
 
 uint8_t bit_lib_get_bits(const uint8_t* data, size_t position, uint8_t length) {
-    uint8_t shift = position % 8;
-    if(shift == 0) {
-        return data[position / 8] >> (8 - length);
-    } else {
-        // TODO FL-3534: fix read out of bounds
-        uint8_t value = (data[position / 8] << (shift));
-        value |= data[position / 8 + 1] >> (8 - shift);
-        value = value >> (8 - length);
-        return value;
-    }
+    return bit_lib_load_bits(data, position, length);
 }
 
 uint16_t bit_lib_get_bits_16(const uint8_t* data, size_t position, uint8_t length) {
-    uint16_t value = 0;
-    if(length <= 8) {
-        value = bit_lib_get_bits(data, position, length);
-    } else {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, length - 8);
-    }
-    return value;
+    return bit_lib_load_bits(data, position, length);
 }
 
 uint32_t bit_lib_get_bits_32(const uint8_t* data, size_t position, uint8_t length) {
-    uint32_t value = 0;
-    if(length <= 8) {
-        value = bit_lib_get_bits(data, position, length);
-    } else if(length <= 16) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, length - 8);
-    } else if(length <= 24) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= bit_lib_get_bits(data, position + 16, length - 16);
-    } else {
-        value = (uint32_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint32_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint32_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= bit_lib_get_bits(data, position + 24, length - 24);
-    }
-
-    return value;
+    return bit_lib_load_bits(data, position, length);
 }
 
 uint64_t bit_lib_get_bits_64(const uint8_t* data, size_t position, uint8_t length) {
     uint64_t value = 0;
-    if(length <= 8) {
-        value = bit_lib_get_bits(data, position, length);
-    } else if(length <= 16) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, length - 8);
-    } else if(length <= 24) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= bit_lib_get_bits(data, position + 16, length - 16);
-    } else if(length <= 32) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= bit_lib_get_bits(data, position + 24, length - 24);
-    } else if(length <= 40) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= bit_lib_get_bits(data, position + 32, length - 32);
-    } else if(length <= 48) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 32, 8) << (length - 40);
-        value |= bit_lib_get_bits(data, position + 40, length - 40);
-    } else if(length <= 56) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 32, 8) << (length - 40);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 40, 8) << (length - 48);
-        value |= bit_lib_get_bits(data, position + 48, length - 48);
+    if(length <= 32) {
+        value = bit_lib_load_bits(data, position, length);
     } else {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 32, 8) << (length - 40);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 40, 8) << (length - 48);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 48, 8) << (length - 56);
-        value |= bit_lib_get_bits(data, position + 56, length - 56);
+        value = (uint64_t)bit_lib_load_bits(data, position, length - 32) << 32;
+        value |= bit_lib_load_bits(data, position + length - 32, 32);
     }
 
     return value;
 }
 
 bool bit_lib_test_parity_32(uint32_t bits, BitLibParity parity) {
-#if !defined __GNUC__
-#error Please, implement parity test for non-GCC compilers
-#else
+    // Fold the word into a nibble, 0x6996 is the parity table of all nibble values
+    bits ^= bits >> 16;
+    bits ^= bits >> 8;
+    bits ^= bits >> 4;
+    const bool odd_ones = (0x6996U >> (bits & 0xFU)) & 1U;
+
     switch(parity) {
     case BitLibParityEven:
-        return __builtin_parity(bits);
+        return odd_ones;
     case BitLibParityOdd:
-        return !__builtin_parity(bits);
+        return !odd_ones;
     default:
         furi_crash("Unknown parity");
     }
-#endif
 }
 
 bool bit_lib_test_parity(
@@ -191,11 +201,14 @@ size_t bit_lib_add_parity(
     uint32_t parity_word = 0;
     size_t j = 0, bit_count = 0;
     for(int word = 0; word < source_length; word += parity_length - 1) {
-        for(int bit = 0; bit < parity_length - 1; bit++) {
-            parity_word = (parity_word << 1) | bit_lib_get_bit(data, position + word + bit);
-            bit_lib_set_bit(
-                dest, dest_position + j++, bit_lib_get_bit(data, position + word + bit));
-        }
+        const uint8_t data_length = parity_length - 1;
+        // Only the last 32 bits of a longer word ever made it into the parity
+        const uint8_t parity_word_length = (data_length > 32) ? 32 : data_length;
+        parity_word = bit_lib_get_bits_32(
+            data, position + word + data_length - parity_word_length, parity_word_length);
+        bit_lib_copy_bits(dest, dest_position + j, data_length, data, position + word);
+        j += data_length;
+
         // if parity fails then return 0
         switch(parity) {
         case BitLibParityAlways0:
@@ -253,21 +266,42 @@ void bit_lib_copy_bits(
     size_t length,
     const uint8_t* source,
     size_t source_position) {
-    for(size_t i = 0; i < length; ++i) {
-        bit_lib_set_bit(data, position + i, bit_lib_get_bit(source, source_position + i));
+    while(length > 0) {
+        const uint8_t chunk = (length > 32) ? 32 : length;
+        const uint32_t word = bit_lib_load_bits(source, source_position, chunk);
+        bit_lib_store_bits(data, position, word, chunk);
+
+        position += chunk;
+        source_position += chunk;
+        length -= chunk;
     }
 }
 
 void bit_lib_reverse_bits(uint8_t* data, size_t position, uint8_t length) {
-    size_t i = 0;
-    size_t j = length - 1;
-
-    while(i < j) {
-        bool tmp = bit_lib_get_bit(data, position + i);
-        bit_lib_set_bit(data, position + i, bit_lib_get_bit(data, position + j));
-        bit_lib_set_bit(data, position + j, tmp);
-        i++;
-        j--;
+    size_t head = position;
+    size_t tail = position + length;
+
+    // Swap reversed words from both ends until at most two words are left in the middle
+    while(tail - head > 64) {
+        const uint32_t head_word = bit_lib_load_bits(data, head, 32);
+        const uint32_t tail_word = bit_lib_load_bits(data, tail - 32, 32);
+        bit_lib_store_bits(data, head, bit_lib_reverse_32(tail_word), 32);
+        bit_lib_store_bits(data, tail - 32, bit_lib_reverse_32(head_word), 32);
+        head += 32;
+        tail -= 32;
+    }
+
+    const uint8_t rest = tail - head;
+    if(rest > 32) {
+        const uint8_t low_length = rest - 32;
+        const uint32_t high_word = bit_lib_load_bits(data, head, 32);
+        const uint32_t low_word = bit_lib_load_bits(data, head + 32, low_length);
+        bit_lib_store_bits(
+            data, head, bit_lib_reverse_32(low_word) >> (32 - low_length), low_length);
+        bit_lib_store_bits(data, head + low_length, bit_lib_reverse_32(high_word), 32);
+    } else if(rest > 1) {
+        const uint32_t word = bit_lib_load_bits(data, head, rest);
+        bit_lib_store_bits(data, head, bit_lib_reverse_32(word) >> (32 - rest), rest);
     }
 }
 
@@ -332,31 +366,11 @@ void bit_lib_print_regions(
 }
 
 uint16_t bit_lib_reverse_16_fast(uint16_t data) {
-    uint16_t result = 0;
-    result |= (data & 0x8000) >> 15;
-    result |= (data & 0x4000) >> 13;
-    result |= (data & 0x2000) >> 11;
-    result |= (data & 0x1000) >> 9;
-    result |= (data & 0x0800) >> 7;
-    result |= (data & 0x0400) >> 5;
-    result |= (data & 0x0200) >> 3;
-    result |= (data & 0x0100) >> 1;
-    result |= (data & 0x0080) << 1;
-    result |= (data & 0x0040) << 3;
-    result |= (data & 0x0020) << 5;
-    result |= (data & 0x0010) << 7;
-    result |= (data & 0x0008) << 9;
-    result |= (data & 0x0004) << 11;
-    result |= (data & 0x0002) << 13;
-    result |= (data & 0x0001) << 15;
-    return result;
+    return ((uint16_t)bit_lib_reverse_table[data & 0xFF] << 8) | bit_lib_reverse_table[data >> 8];
 }
 
 uint8_t bit_lib_reverse_8_fast(uint8_t byte) {
-    byte = (byte & 0xF0) >> 4 | (byte & 0x0F) << 4;
-    byte = (byte & 0xCC) >> 2 | (byte & 0x33) << 2;
-    byte = (byte & 0xAA) >> 1 | (byte & 0x55) << 1;
-    return byte;
+    return bit_lib_reverse_table[byte];
 }
 
 uint16_t bit_lib_crc8(
@@ -371,7 +385,7 @@ uint16_t bit_lib_crc8(
 
     for(size_t i = 0; i < data_size; ++i) {
         uint8_t byte = data[i];
-        if(ref_in) bit_lib_reverse_bits(&byte, 0, 8);
+        if(ref_in) byte = bit_lib_reverse_8_fast(byte);
         crc ^= byte;
 
         for(size_t j = 8; j > 0; --j) {
@@ -383,7 +397,7 @@ uint16_t bit_lib_crc8(
         }
     }
 
-    if(ref_out) bit_lib_reverse_bits(&crc, 0, 8);
+    if(ref_out) crc = bit_lib_reverse_8_fast(crc);
     crc ^= xor_out;
 
     return crc;
@@ -401,7 +415,7 @@ uint16_t bit_lib_crc16(
 
     for(size_t i = 0; i < data_size; ++i) {
         uint8_t byte = data[i];
-        if(ref_in) byte = bit_lib_reverse_16_fast(byte) >> 8;
+        if(ref_in) byte = bit_lib_reverse_8_fast(byte);
 
         for(size_t j = 0; j < 8; ++j) {
             bool c15 = (crc >> 15 & 1);
@@ -2,13 +2,13 @@
 #include "elf_file_i.h"
 
 #include <storage/storage.h>
+#include <toolbox/stream/buffered_file_stream.h>
 #include <elf.h>
 #include "elf_api_interface.h"
 #include "../api_hashtable/api_hashtable.h"
 
 #define TAG "Elf"
 
-#define ELF_NAME_BUFFER_LEN        32
 #define SECTION_OFFSET(e, n)       ((e)->section_table + (n) * sizeof(Elf32_Shdr))
 #define IS_FLAGS_SET(v, m)         (((v) & (m)) == (m))
 #define RESOLVER_THREAD_YIELD_STEP 30
@@ -55,11 +55,84 @@ static void address_cache_put(AddressCache_t cache, int symEntry, Elf32_Addr sym
     AddressCache_set_at(cache, symEntry, symAddr);
 }
 
+/* Relocation reads symbols, names and relocation entries from all over the file, a few
+   bytes at a time. Blocks of the file are kept around to serve these reads from memory. */
+
+static ELFFileCacheBlock* elf_file_cache_get(ELFFile* elf, off_t offset) {
+    off_t block_offset = offset - offset % ELF_FILE_CACHE_BLOCK_SIZE;
+    ELFFileCacheBlock* victim = &elf->cache[0];
+    elf->cache_tick++;
+
+    for(size_t i = 0; i < ELF_FILE_CACHE_BLOCKS; i++) {
+        ELFFileCacheBlock* block = &elf->cache[i];
+        if(block->size && block->offset == block_offset) {
+            block->last_used = elf->cache_tick;
+            // Short block is the end of the file
+            return (offset < block_offset + (off_t)block->size) ? block : NULL;
+        }
+        if(block->last_used < victim->last_used) {
+            victim = block;
+        }
+    }
+
+    if(!victim->data) {
+        victim->data = malloc(ELF_FILE_CACHE_BLOCK_SIZE);
+    }
+    victim->size = 0;
+    victim->last_used = elf->cache_tick;
+    victim->offset = block_offset;
+
+    if(!storage_file_seek(elf->fd, block_offset, true)) {
+        return NULL;
+    }
+    victim->size = storage_file_read(elf->fd, victim->data, ELF_FILE_CACHE_BLOCK_SIZE);
+
+    return (offset < block_offset + (off_t)victim->size) ? victim : NULL;
+}
+
+static void elf_file_cache_clear(ELFFile* elf) {
+    for(size_t i = 0; i < ELF_FILE_CACHE_BLOCKS; i++) {
+        free(elf->cache[i].data);
+        elf->cache[i].data = NULL;
+        elf->cache[i].size = 0;
+        elf->cache[i].last_used = 0;
+    }
+}
+
+static bool elf_file_cache_read(ELFFile* elf, off_t offset, void* data, size_t size) {
+    if(size >= ELF_FILE_CACHE_BLOCK_SIZE) {
+        return storage_file_seek(elf->fd, offset, true) &&
+               storage_file_read(elf->fd, data, size) == size;
+    }
+
+    uint8_t* output = data;
+    while(size) {
+        ELFFileCacheBlock* block = elf_file_cache_get(elf, offset);
+        if(!block) {
+            return false;
+        }
+
+        size_t block_position = offset - block->offset;
+        size_t chunk_size = MIN(size, block->size - block_position);
+        memcpy(output, &block->data[block_position], chunk_size);
+
+        output += chunk_size;
+        offset += chunk_size;
+        size -= chunk_size;
+    }
+
+    return true;
+}
+
 /**************************************************************************************************/
 /********************************************** ELF ***********************************************/
 /**************************************************************************************************/
 
 static void elf_file_maybe_release_fd(ELFFile* elf) {
+    elf_file_cache_clear(elf);
+    free(elf->section_index);
+    elf->section_index = NULL;
+
     if(elf->fd) {
         storage_file_free(elf->fd);
         elf->fd = NULL;
@@ -91,31 +164,28 @@ static ELFSection* elf_file_get_or_put_section(ELFFile* elf, const char* name) {
 }
 
 static bool elf_read_string_from_offset(ELFFile* elf, off_t offset, FuriString* name) {
-    bool result = false;
-
-    off_t old = storage_file_tell(elf->fd);
-
-    do {
-        if(!storage_file_seek(elf->fd, offset, true)) break;
+    while(true) {
+        ELFFileCacheBlock* block = elf_file_cache_get(elf, offset);
+        if(!block) {
+            return false;
+        }
 
-        char buffer[ELF_NAME_BUFFER_LEN + 1];
-        buffer[ELF_NAME_BUFFER_LEN] = 0;
+        size_t block_position = offset - block->offset;
+        const char* chunk = (const char*)&block->data[block_position];
+        size_t chunk_size = block->size - block_position;
 
-        while(true) {
-            size_t read = storage_file_read(elf->fd, buffer, ELF_NAME_BUFFER_LEN);
-            furi_string_cat(name, buffer);
-            if(strlen(buffer) < ELF_NAME_BUFFER_LEN) {
-                result = true;
-                break;
-            }
-
-            if(storage_file_get_error(elf->fd) != FSE_OK || read == 0) break;
+        size_t length = strnlen(chunk, chunk_size);
+        if(length < chunk_size) {
+            furi_string_cat_str(name, chunk);
+            return true;
         }
 
-    } while(false);
-    storage_file_seek(elf->fd, old, true);
-
-    return result;
+        // String continues in the next block
+        for(size_t i = 0; i < chunk_size; i++) {
+            furi_string_push_back(name, chunk[i]);
+        }
+        offset += chunk_size;
+    }
 }
 
 static bool elf_read_section_name(ELFFile* elf, off_t offset, FuriString* name) {
@@ -128,8 +198,7 @@ static bool elf_read_symbol_name(ELFFile* elf, off_t offset, FuriString* name) {
 
 static bool elf_read_section_header(ELFFile* elf, size_t section_idx, Elf32_Shdr* section_header) {
     off_t offset = SECTION_OFFSET(elf, section_idx);
-    return storage_file_seek(elf->fd, offset, true) &&
-           storage_file_read(elf->fd, section_header, sizeof(Elf32_Shdr)) == sizeof(Elf32_Shdr);
+    return elf_file_cache_read(elf, offset, section_header, sizeof(Elf32_Shdr));
 }
 
 static bool elf_read_section(
@@ -150,10 +219,8 @@ static bool elf_read_section(
 
 static bool elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym, FuriString* name) {
     bool success = false;
-    off_t old = storage_file_tell(elf->fd);
     off_t pos = elf->symbol_table + n * sizeof(Elf32_Sym);
-    if(storage_file_seek(elf->fd, pos, true) &&
-       storage_file_read(elf->fd, sym, sizeof(Elf32_Sym)) == sizeof(Elf32_Sym)) {
+    if(elf_file_cache_read(elf, pos, sym, sizeof(Elf32_Sym))) {
         if(sym->st_name)
             success = elf_read_symbol_name(elf, sym->st_name, name);
         else {
@@ -161,11 +228,28 @@ static bool elf_read_symbol(ELFFile* elf, int n, Elf32_Sym* sym, FuriString* nam
             success = elf_read_section(elf, sym->st_shndx, &shdr, name);
         }
     }
-    storage_file_seek(elf->fd, old, true);
     return success;
 }
 
+static void elf_build_section_index(ELFFile* elf) {
+    free(elf->section_index);
+    elf->section_index = malloc(elf->sections_count * sizeof(ELFSection*));
+
+    ELFSectionDict_it_t it;
+    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
+        ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
+        // Sections known only by their relocations keep index 0 and are never referenced
+        if(itref->value.sec_idx != 0 && itref->value.sec_idx < elf->sections_count) {
+            elf->section_index[itref->value.sec_idx] = &itref->value;
+        }
+    }
+}
+
 static ELFSection* elf_section_of(ELFFile* elf, int index) {
+    if(elf->section_index && index > 0 && (size_t)index < elf->sections_count) {
+        return elf->section_index[index];
+    }
+
     ELFSectionDict_it_t it;
     for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
         ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
@@ -323,6 +407,22 @@ static void elf_relocate_mov(Elf32_Addr relAddr, int type, Elf32_Addr symAddr) {
                               | (addr & 0x00FF); /* imm8 */
 }
 
+static bool elf_relocation_type_is_supported(int type) {
+    switch(type) {
+    case R_ARM_TARGET1:
+    case R_ARM_ABS32:
+    case R_ARM_REL32:
+    case R_ARM_THM_PC22:
+    case R_ARM_CALL:
+    case R_ARM_THM_JUMP24:
+    case R_ARM_THM_MOVW_ABS_NC:
+    case R_ARM_THM_MOVT_ABS:
+        return true;
+    default:
+        return false;
+    }
+}
+
 static bool elf_relocate_symbol(ELFFile* elf, Elf32_Addr relAddr, int type, Elf32_Addr symAddr) {
     switch(type) {
     case R_ARM_TARGET1:
@@ -356,12 +456,334 @@ static bool elf_relocate_symbol(ELFFile* elf, Elf32_Addr relAddr, int type, Elf3
     return true;
 }
 
+/**************************************************************************************************/
+/***************************************** Prelink cache ******************************************/
+/**************************************************************************************************/
+
+/* Relocations of a FAP are the same on every launch, as long as the file and the API stay the
+   same. They are recorded on the first launch, with symbols already looked up: imports by name
+   hash and local symbols by section, so later launches skip symbol and string tables. Fast
+   relocations are recorded the same way, and are only loaded when the cache doesn't match or
+   turns out to be broken. */
+
+#define PRELINK_PATH        EXT_PATH(".fap_cache")
+#define PRELINK_MAGIC       (0x4B4E4C50UL) // "PLNK"
+#define PRELINK_VERSION     (2U)
+#define PRELINK_ENTRIES_MAX (32U)
+#define PRELINK_NAME_LENGTH (16U)
+
+// Fast relocation records have no symbol table entry, they are numbered apart from symbols
+#define PRELINK_FAST_SYMBOL (0x80000000UL)
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    ELFPrelinkKey key;
+    uint32_t relocations_count;
+    uint32_t symbols_count; // Symbols follow relocations
+} FURI_PACKED ELFPrelinkHeader;
+
+typedef struct {
+    uint32_t offset; // Offset in the relocated section
+    uint32_t sym_entry;
+    uint16_t section; // Index of the relocated section
+    uint8_t type;
+    uint8_t reserved;
+} FURI_PACKED ELFPrelinkRelocation;
+
+typedef enum {
+    ELFPrelinkResultMiss,
+    ELFPrelinkResultApplied,
+    ELFPrelinkResultError,
+} ELFPrelinkResult;
+
+static void elf_prelink_init(ELFFile* elf, const char* path) {
+    if(strncmp(path, STORAGE_EXT_PATH_PREFIX "/", strlen(STORAGE_EXT_PATH_PREFIX) + 1) != 0 ||
+       storage_common_timestamp(elf->storage, path, &elf->prelink_key.file_timestamp) != FSE_OK) {
+        return;
+    }
+
+    elf->prelink_key.path_hash = elf_symbolname_hash(path);
+    elf->prelink_key.file_size = storage_file_size(elf->fd);
+    elf->prelink_key.api_version_major = elf->api_interface->api_version_major;
+    elf->prelink_key.api_version_minor = elf->api_interface->api_version_minor;
+
+    // FNV-1a, a different hash than the one in the key
+    uint32_t name_hash = 2166136261UL;
+    for(const char* c = path; *c; c++) {
+        name_hash = (name_hash ^ (uint8_t)*c) * 16777619UL;
+    }
+    elf->prelink_path = furi_string_alloc_printf("%s/%08lX", PRELINK_PATH, name_hash);
+}
+
+static bool elf_prelink_read_header(ELFFile* elf, Stream* stream, ELFPrelinkHeader* header) {
+    return buffered_file_stream_open(
+               stream, furi_string_get_cstr(elf->prelink_path), FSAM_READ, FSOM_OPEN_EXISTING) &&
+           stream_read(stream, (uint8_t*)header, sizeof(ELFPrelinkHeader)) ==
+               sizeof(ELFPrelinkHeader) &&
+           header->magic == PRELINK_MAGIC && header->version == PRELINK_VERSION &&
+           memcmp(&header->key, &elf->prelink_key, sizeof(ELFPrelinkKey)) == 0;
+}
+
+static void elf_prelink_probe(ELFFile* elf) {
+    if(!elf->prelink_path) return;
+
+    Stream* stream = buffered_file_stream_alloc(elf->storage);
+    ELFPrelinkHeader header;
+    elf->prelink_hit = elf_prelink_read_header(elf, stream, &header);
+    buffered_file_stream_close(stream);
+    stream_free(stream);
+}
+
+/* Entries of removed, moved or updated FAPs are never matched again, the oldest make room */
+static void elf_prelink_evict(ELFFile* elf) {
+    File* dir = storage_file_alloc(elf->storage);
+    FuriString* path = furi_string_alloc();
+    FuriString* oldest_path = furi_string_alloc();
+    char name[PRELINK_NAME_LENGTH];
+    uint32_t oldest_timestamp = UINT32_MAX;
+    size_t entries_count = 0;
+
+    if(storage_dir_open(dir, PRELINK_PATH)) {
+        while(storage_dir_read(dir, NULL, name, sizeof(name))) {
+            furi_string_printf(path, "%s/%s", PRELINK_PATH, name);
+            // Entry of this file is overwritten anyway
+            if(furi_string_equal(path, elf->prelink_path)) continue;
+            entries_count++;
+
+            uint32_t timestamp;
+            if(storage_common_timestamp(elf->storage, furi_string_get_cstr(path), &timestamp) ==
+                   FSE_OK &&
+               timestamp < oldest_timestamp) {
+                oldest_timestamp = timestamp;
+                furi_string_set(oldest_path, path);
+            }
+        }
+    }
+    storage_dir_close(dir);
+    storage_file_free(dir);
+
+    if(entries_count >= PRELINK_ENTRIES_MAX && !furi_string_empty(oldest_path)) {
+        FURI_LOG_D(TAG, "Evicting %s", furi_string_get_cstr(oldest_path));
+        storage_simply_remove(elf->storage, furi_string_get_cstr(oldest_path));
+    }
+
+    furi_string_free(oldest_path);
+    furi_string_free(path);
+}
+
+static void elf_prelink_begin(ELFFile* elf) {
+    if(!elf->prelink_path) return;
+
+    storage_simply_mkdir(elf->storage, PRELINK_PATH);
+    elf_prelink_evict(elf);
+
+    Stream* stream = buffered_file_stream_alloc(elf->storage);
+    ELFPrelinkHeader header = {0};
+    if(buffered_file_stream_open(
+           stream, furi_string_get_cstr(elf->prelink_path), FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+       stream_write(stream, (uint8_t*)&header, sizeof(header)) == sizeof(header)) {
+        elf->prelink_stream = stream;
+        elf->prelink_relocations_count = 0;
+    } else {
+        buffered_file_stream_close(stream);
+        stream_free(stream);
+    }
+}
+
+static void elf_prelink_end(ELFFile* elf, bool success) {
+    Stream* stream = elf->prelink_stream;
+    if(!stream) return;
+    elf->prelink_stream = NULL;
+
+    if(success) {
+        ELFPrelinkHeader header = {
+            .magic = PRELINK_MAGIC,
+            .version = PRELINK_VERSION,
+            .key = elf->prelink_key,
+            .relocations_count = elf->prelink_relocations_count,
+            .symbols_count = elf->prelink_symbols_count,
+        };
+        size_t symbols_size = elf->prelink_symbols_count * sizeof(ELFPrelinkSymbol);
+
+        success = stream_write(stream, (uint8_t*)elf->prelink_symbols, symbols_size) ==
+                      symbols_size &&
+                  stream_seek(stream, 0, StreamOffsetFromStart) &&
+                  stream_write(stream, (uint8_t*)&header, sizeof(header)) == sizeof(header);
+    }
+
+    success = buffered_file_stream_close(stream) && success;
+    stream_free(stream);
+
+    free(elf->prelink_symbols);
+    elf->prelink_symbols = NULL;
+    elf->prelink_symbols_count = 0;
+    elf->prelink_symbols_capacity = 0;
+
+    if(!success) {
+        storage_simply_remove(elf->storage, furi_string_get_cstr(elf->prelink_path));
+    }
+}
+
+static void elf_prelink_add_symbol(
+    ELFFile* elf,
+    uint32_t sym_entry,
+    uint16_t section,
+    uint32_t value) {
+    if(!elf->prelink_stream) return;
+
+    if(elf->prelink_symbols_count == elf->prelink_symbols_capacity) {
+        elf->prelink_symbols_capacity =
+            elf->prelink_symbols_capacity ? elf->prelink_symbols_capacity * 2 : 32;
+        elf->prelink_symbols = realloc( //-V701
+            elf->prelink_symbols,
+            elf->prelink_symbols_capacity * sizeof(ELFPrelinkSymbol));
+    }
+
+    ELFPrelinkSymbol* symbol = &elf->prelink_symbols[elf->prelink_symbols_count++];
+    symbol->sym_entry = sym_entry;
+    symbol->section = section;
+    symbol->value = value;
+    symbol->reserved = 0;
+}
+
+static void elf_prelink_add_relocation(
+    ELFFile* elf,
+    ELFSection* s,
+    uint32_t offset,
+    uint32_t sym_entry,
+    uint8_t type) {
+    if(!elf->prelink_stream) return;
+
+    ELFPrelinkRelocation relocation = {
+        .offset = offset,
+        .sym_entry = sym_entry,
+        .section = s->sec_idx,
+        .type = type,
+        .reserved = 0,
+    };
+
+    if(stream_write(elf->prelink_stream, (uint8_t*)&relocation, sizeof(relocation)) !=
+       sizeof(relocation)) {
+        elf_prelink_end(elf, false);
+        return;
+    }
+    elf->prelink_relocations_count++;
+}
+
+/* Reads a cached relocation and checks that it can be applied to the loaded sections */
+static bool elf_prelink_read_relocation(
+    ELFFile* elf,
+    Stream* stream,
+    ELFPrelinkRelocation* relocation,
+    Elf32_Addr* relAddr,
+    Elf32_Addr* symAddr) {
+    if(stream_read(stream, (uint8_t*)relocation, sizeof(ELFPrelinkRelocation)) !=
+       sizeof(ELFPrelinkRelocation))
+        return false;
+
+    ELFSection* section = elf_section_of(elf, relocation->section);
+    if(!section || !section->data || section->size < sizeof(uint32_t) ||
+       relocation->offset > section->size - sizeof(uint32_t))
+        return false;
+    if(!elf_relocation_type_is_supported(relocation->type)) return false;
+    if(!address_cache_get(elf->relocation_cache, relocation->sym_entry, symAddr)) return false;
+
+    *relAddr = ((Elf32_Addr)section->data) + relocation->offset;
+    return true;
+}
+
+static ELFPrelinkResult elf_prelink_apply(ELFFile* elf) {
+    if(!elf->prelink_path) return ELFPrelinkResultMiss;
+
+    Stream* stream = buffered_file_stream_alloc(elf->storage);
+    ELFPrelinkResult result = ELFPrelinkResultMiss;
+    ELFPrelinkHeader header;
+
+    do {
+        if(!elf_prelink_read_header(elf, stream, &header)) break;
+
+        size_t symbols_offset =
+            sizeof(header) + header.relocations_count * sizeof(ELFPrelinkRelocation);
+        if(!stream_seek(stream, symbols_offset, StreamOffsetFromStart)) break;
+
+        size_t i = 0;
+        for(; i < header.symbols_count; i++) {
+            ELFPrelinkSymbol symbol;
+            if(stream_read(stream, (uint8_t*)&symbol, sizeof(symbol)) != sizeof(symbol)) break;
+
+            Elf32_Addr address = ELF_INVALID_ADDRESS;
+            if(symbol.section == SHN_UNDEF) {
+                if(!elf->api_interface->resolver_callback(
+                       elf->api_interface, symbol.value, &address)) {
+                    address = ELF_INVALID_ADDRESS;
+                }
+            } else {
+                ELFSection* symSec = elf_section_of(elf, symbol.section);
+                if(symSec) {
+                    address = ((Elf32_Addr)symSec->data) + symbol.value;
+                }
+            }
+
+            if(address == ELF_INVALID_ADDRESS) break;
+            address_cache_put(elf->relocation_cache, symbol.sym_entry, address);
+        }
+        if(i != header.symbols_count) break;
+
+        // Relocations are applied in place, so all of them are checked before the first one
+        if(!stream_seek(stream, sizeof(header), StreamOffsetFromStart)) break;
+
+        ELFPrelinkRelocation relocation;
+        Elf32_Addr relAddr, symAddr;
+        for(i = 0; i < header.relocations_count; i++) {
+            if(!elf_prelink_read_relocation(elf, stream, &relocation, &relAddr, &symAddr)) break;
+        }
+        if(i != header.relocations_count) break;
+
+        // Only a read error can stop it from here, with some relocations already applied
+        result = ELFPrelinkResultError;
+        if(!stream_seek(stream, sizeof(header), StreamOffsetFromStart)) break;
+
+        for(i = 0; i < header.relocations_count; i++) {
+            if(i % RESOLVER_THREAD_YIELD_STEP == 0) {
+                furi_thread_yield();
+            }
+
+            if(!elf_prelink_read_relocation(elf, stream, &relocation, &relAddr, &symAddr)) break;
+            elf_relocate_symbol(elf, relAddr, relocation.type, symAddr);
+        }
+
+        if(i == header.relocations_count) {
+            result = ELFPrelinkResultApplied;
+        }
+    } while(false);
+
+    buffered_file_stream_close(stream);
+    stream_free(stream);
+
+    if(result == ELFPrelinkResultMiss) {
+        AddressCache_reset(elf->relocation_cache);
+        // Matching entry that can't be applied is replaced by the regular relocation
+        if(elf->prelink_hit) {
+            FURI_LOG_W(TAG, "Prelink cache is broken, relocating");
+            storage_simply_remove(elf->storage, furi_string_get_cstr(elf->prelink_path));
+        }
+    } else if(result == ELFPrelinkResultError) {
+        FURI_LOG_E(TAG, "Failed to read prelink cache, removing");
+        storage_simply_remove(elf->storage, furi_string_get_cstr(elf->prelink_path));
+    } else {
+        FURI_LOG_D(TAG, "Applied %lu cached relocations", header.relocations_count);
+    }
+
+    return result;
+}
+
 static bool elf_relocate(ELFFile* elf, ELFSection* s) {
     if(s->data) {
         Elf32_Rel rel;
         size_t relEntries = s->rel_count;
         size_t relCount;
-        (void)storage_file_seek(elf->fd, s->rel_offset, true);
         FURI_LOG_D(TAG, " Offset   Info     Type             Name");
 
         int relocate_result = true;
@@ -374,7 +796,8 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                 furi_delay_tick(1);
             }
 
-            if(storage_file_read(elf->fd, &rel, sizeof(Elf32_Rel)) != sizeof(Elf32_Rel)) {
+            off_t rel_offset = s->rel_offset + relCount * sizeof(Elf32_Rel);
+            if(!elf_file_cache_read(elf, rel_offset, &rel, sizeof(Elf32_Rel))) {
                 FURI_LOG_E(TAG, "  reloc read fail");
                 furi_string_free(symbol_name);
                 return false;
@@ -385,6 +808,7 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
             int symEntry = ELF32_R_SYM(rel.r_info);
             int relType = ELF32_R_TYPE(rel.r_info);
             Elf32_Addr relAddr = ((Elf32_Addr)s->data) + rel.r_offset;
+            elf_prelink_add_relocation(elf, s, rel.r_offset, symEntry, relType);
 
             if(!address_cache_get(elf->relocation_cache, symEntry, &symAddr)) {
                 Elf32_Sym sym;
@@ -405,6 +829,13 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
 
                 symAddr = elf_address_of(elf, &sym, furi_string_get_cstr(symbol_name));
                 address_cache_put(elf->relocation_cache, symEntry, symAddr);
+                elf_prelink_add_symbol(
+                    elf,
+                    symEntry,
+                    sym.st_shndx,
+                    (sym.st_shndx == SHN_UNDEF) ?
+                        elf_symbolname_hash(furi_string_get_cstr(symbol_name)) :
+                        sym.st_value);
             }
 
             if(symAddr != ELF_INVALID_ADDRESS) {
@@ -506,6 +937,52 @@ static ELFLoadSectionResult
     return ELFLoadSectionResultSuccess;
 }
 
+static ELFLoadSectionResult
+    elf_load_fast_rel_section(ELFFile* elf, const char* name, Elf32_Shdr* section_header) {
+    name = name + strlen(".fast.rel");
+    ELFSection* section_p = elf_file_get_or_put_section(elf, name);
+    section_p->fast_rel = malloc(sizeof(ELFSection));
+
+    ELFLoadSectionResult result = elf_load_section_data(elf, section_p->fast_rel, section_header);
+
+    if(result != ELFLoadSectionResultSuccess) {
+        FURI_LOG_E(TAG, "Error loading section '%s'", name);
+    } else {
+        FURI_LOG_D(TAG, "Loaded fast rel section for '%s'", name);
+    }
+
+    return result;
+}
+
+/* Fast relocations skipped on load for a prelink cache that turned out to be broken */
+static bool elf_load_fast_rel_sections(ELFFile* elf) {
+    FuriString* name = furi_string_alloc();
+    bool success = true;
+
+    for(size_t section_idx = 1; success && section_idx < elf->sections_count; section_idx++) {
+        Elf32_Shdr section_header;
+
+        furi_string_reset(name);
+        if(!elf_read_section(elf, section_idx, &section_header, name)) {
+            success = false;
+        } else if(
+            furi_string_start_with_str(name, ".fast.rel") &&
+            !furi_string_start_with_str(name, ".fast.rel.ARM.")) {
+            success = elf_load_fast_rel_section(
+                          elf, furi_string_get_cstr(name), &section_header) ==
+                      ELFLoadSectionResultSuccess;
+        }
+    }
+
+    furi_string_free(name);
+
+    elf->prelink_hit = false;
+    // Sections may have been added
+    elf_build_section_index(elf);
+
+    return success;
+}
+
 static SectionTypeInfo elf_preload_section(
     ELFFile* elf,
     size_t section_idx,
@@ -601,17 +1078,12 @@ static SectionTypeInfo elf_preload_section(
 
     // Load fast rel section
     if(str_prefix(name, ".fast.rel")) {
-        name = name + strlen(".fast.rel");
-        ELFSection* section_p = elf_file_get_or_put_section(elf, name);
-        section_p->fast_rel = malloc(sizeof(ELFSection));
-
         info.type = SectionTypeFastRelData;
-        info.result = elf_load_section_data(elf, section_p->fast_rel, section_header);
-
-        if(info.result != ELFLoadSectionResultSuccess) {
-            FURI_LOG_E(TAG, "Error loading section '%s'", name);
+        // Relocations are applied from the prelink cache
+        if(elf->prelink_hit) {
+            info.result = ELFLoadSectionResultSuccess;
         } else {
-            FURI_LOG_D(TAG, "Loaded fast rel section for '%s'", name);
+            info.result = elf_load_fast_rel_section(elf, name, section_header);
         }
 
         return info;
@@ -755,11 +1227,19 @@ static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
             no_errors = false;
             start += 3 * offsets_count;
         } else {
+            uint32_t prelink_entry = PRELINK_FAST_SYMBOL | elf->prelink_symbols_count;
+            elf_prelink_add_symbol(
+                elf,
+                prelink_entry,
+                is_section ? hash_or_section_index : SHN_UNDEF,
+                is_section ? section_value : hash_or_section_index);
+
             for(uint32_t j = 0; j < offsets_count; j++) {
                 uint32_t offset = *((uint32_t*)start) & 0x00FFFFFF;
                 start += 3;
                 Elf32_Addr relAddr = ((Elf32_Addr)s->data) + offset;
                 elf_relocate_symbol(elf, relAddr, type, address);
+                elf_prelink_add_relocation(elf, s, offset, prelink_entry, type);
             }
         }
     }
@@ -809,6 +1289,7 @@ static void elf_file_call_section_list(ELFSection* section, bool reverse_order)
 
 ELFFile* elf_file_alloc(Storage* storage, const ElfApiInterface* api_interface) {
     ELFFile* elf = malloc(sizeof(ELFFile));
+    elf->storage = storage;
     elf->fd = storage_file_alloc(storage);
     elf->api_interface = api_interface;
     ELFSectionDict_init(elf->sections);
@@ -857,6 +1338,10 @@ void elf_file_free(ELFFile* elf) {
         free(elf->debug_link_info.debug_link);
     }
 
+    if(elf->prelink_path) {
+        furi_string_free(elf->prelink_path);
+    }
+
     elf_file_maybe_release_fd(elf);
     free(elf);
 }
@@ -877,6 +1362,7 @@ bool elf_file_open(ELFFile* elf, const char* path) {
     elf->sections_count = h.e_shnum;
     elf->section_table = h.e_shoff;
     elf->section_table_strings = sH.sh_offset;
+    elf_prelink_init(elf, path);
     return true;
 }
 
@@ -886,6 +1372,7 @@ ElfLoadSectionTableResult elf_file_load_section_table(ELFFile* elf) {
     ElfLoadSectionTableResult result = ElfLoadSectionTableResultSuccess;
 
     FURI_LOG_D(TAG, "Scan ELF indexs...");
+    elf_prelink_probe(elf);
 
     for(size_t section_idx = 1; section_idx < elf->sections_count; section_idx++) {
         Elf32_Shdr section_header;
@@ -974,14 +1461,30 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
     ELFSectionDict_it_t it;
 
     AddressCache_init(elf->relocation_cache);
+    elf_build_section_index(elf);
 
-    for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it); ELFSectionDict_next(it)) {
-        ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
-        FURI_LOG_D(TAG, "Relocating section '%s'", itref->key);
-        if(!elf_relocate_section(elf, &itref->value)) {
-            FURI_LOG_E(TAG, "Error relocating section '%s'", itref->key);
-            status = ELFFileLoadStatusMissingImports;
+    ELFPrelinkResult prelink_result = elf_prelink_apply(elf);
+    if(prelink_result == ELFPrelinkResultMiss && elf->prelink_hit &&
+       !elf_load_fast_rel_sections(elf)) {
+        prelink_result = ELFPrelinkResultError;
+    }
+
+    if(prelink_result == ELFPrelinkResultError) {
+        status = ELFFileLoadStatusUnspecifiedError;
+    } else if(prelink_result == ELFPrelinkResultMiss) {
+        elf_prelink_begin(elf);
+
+        for(ELFSectionDict_it(it, elf->sections); !ELFSectionDict_end_p(it);
+            ELFSectionDict_next(it)) {
+            ELFSectionDict_itref_t* itref = ELFSectionDict_ref(it);
+            FURI_LOG_D(TAG, "Relocating section '%s'", itref->key);
+            if(!elf_relocate_section(elf, &itref->value)) {
+                FURI_LOG_E(TAG, "Error relocating section '%s'", itref->key);
+                status = ELFFileLoadStatusMissingImports;
+            }
         }
+
+        elf_prelink_end(elf, status == ELFFileLoadStatusSuccess);
     }
 
     /* Fixing up entry point */
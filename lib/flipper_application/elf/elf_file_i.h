@@ -1,6 +1,7 @@
 #pragma once
 #include "elf_file.h"
 #include <m-dict.h>
+#include <toolbox/stream/stream.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,7 +29,43 @@ struct ELFSection {
 
 DICT_DEF2(ELFSectionDict, const char*, M_CSTR_OPLIST, ELFSection, M_POD_OPLIST)
 
+#define ELF_FILE_CACHE_BLOCK_SIZE 1024
+#define ELF_FILE_CACHE_BLOCKS     3
+
+/**
+ * Aligned window of the ELF file, used for small reads of tables and strings
+ */
+typedef struct {
+    off_t offset;
+    size_t size; // 0 - block holds no data
+    uint32_t last_used;
+    uint8_t* data;
+} ELFFileCacheBlock;
+
+/**
+ * Identity of the file and the API its relocations were resolved against
+ */
+typedef struct {
+    uint32_t path_hash;
+    uint32_t file_size;
+    uint32_t file_timestamp;
+    uint16_t api_version_major;
+    uint16_t api_version_minor;
+} ELFPrelinkKey;
+
+/**
+ * Symbol referenced by relocations, as stored in the prelink cache
+ */
+typedef struct {
+    uint32_t sym_entry;
+    uint32_t value; // Name hash for imports, offset in section otherwise
+    uint16_t section; // SHN_UNDEF for imports
+    uint16_t reserved;
+} FURI_PACKED ELFPrelinkSymbol;
+
 struct ELFFile {
+    Storage* storage;
+
     size_t sections_count;
     off_t section_table;
     off_t section_table_strings;
@@ -43,6 +80,19 @@ struct ELFFile {
     AddressCache_t trampoline_cache;
 
     File* fd;
+    ELFFileCacheBlock cache[ELF_FILE_CACHE_BLOCKS];
+    uint32_t cache_tick;
+
+    ELFSection** section_index; // Loaded sections by section number, built for relocation
+
+    FuriString* prelink_path; // NULL if relocations of the file are not cached
+    ELFPrelinkKey prelink_key;
+    bool prelink_hit; // Cached relocations match the file, fast relocations are not loaded
+    Stream* prelink_stream; // Open while relocations are recorded
+    ELFPrelinkSymbol* prelink_symbols;
+    size_t prelink_symbols_count;
+    size_t prelink_symbols_capacity;
+    uint32_t prelink_relocations_count;
     const ElfApiInterface* api_interface;
     ELFDebugLinkInfo debug_link_info;
 
@@ -194,6 +194,14 @@ bool flipper_format_get_value_count(
         flipper_format->stream, key, count, flipper_format->strict_mode);
 }
 
+bool flipper_format_read_next_string(
+    FlipperFormat* flipper_format,
+    FuriString* key,
+    FuriString* data) {
+    furi_check(flipper_format);
+    return flipper_format_stream_read_next_line(flipper_format->stream, key, data);
+}
+
 bool flipper_format_read_string(FlipperFormat* flipper_format, const char* key, FuriString* data) {
     furi_check(flipper_format);
     return flipper_format_stream_read_value_line(
@@ -311,6 +311,24 @@ bool flipper_format_get_value_count(
     const char* key,
     uint32_t* count);
 
+/** Read the next key and its string value
+ *
+ * Reads the key/value line following the current position, without searching
+ * for a particular key. Comments are skipped. Use it to walk a file with a
+ * known layout sequentially, falling back to the keyed read when the next key
+ * is not the expected one.
+ *
+ * @param      flipper_format  Pointer to a FlipperFormat instance
+ * @param      key             Key
+ * @param      data            Value
+ *
+ * @return     True on success
+ */
+bool flipper_format_read_next_string(
+    FlipperFormat* flipper_format,
+    FuriString* key,
+    FuriString* data);
+
 /** Read a string by key
  *
  * @param      flipper_format  Pointer to a FlipperFormat instance
@@ -340,6 +340,19 @@ bool flipper_format_stream_write_value_line(Stream* stream, FlipperStreamWriteDa
     return result;
 }
 
+bool flipper_format_stream_read_next_line(Stream* stream, FuriString* key, FuriString* value) {
+    bool result = false;
+
+    do {
+        if(!flipper_format_stream_read_valid_key(stream, key)) break;
+        if(!stream_seek(stream, 2, StreamOffsetFromCurrent)) break;
+        if(!flipper_format_stream_read_line(stream, value)) break;
+        result = true;
+    } while(false);
+
+    return result;
+}
+
 bool flipper_format_stream_read_value_line(
     Stream* stream,
     const char* key,
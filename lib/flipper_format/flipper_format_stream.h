@@ -53,6 +53,16 @@ bool flipper_format_stream_read_value_line(
     size_t data_size,
     bool strict_mode);
 
+/**
+ * Reads the next key and its string value from a stream, skipping comments.
+ * @param stream 
+ * @param key 
+ * @param value 
+ * @return true 
+ * @return false 
+ */
+bool flipper_format_stream_read_next_line(Stream* stream, FuriString* key, FuriString* value);
+
 /**
  * Get the count of values by key from a stream.
  * @param stream 
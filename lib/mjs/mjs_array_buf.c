@@ -178,6 +178,11 @@ mjs_val_t mjs_dataview_get_buf(struct mjs* mjs, mjs_val_t obj) {
     return mjs_get(mjs, obj, "buffer", -1);
 }
 
+mjs_dataview_type_t mjs_dataview_get_type(struct mjs* mjs, mjs_val_t obj) {
+    if(!mjs_is_data_view(obj)) return MJS_DATAVIEW_U8;
+    return mjs_get_int(mjs, mjs_get(mjs, obj, "_t", -1));
+}
+
 mjs_val_t mjs_dataview_get_len(struct mjs* mjs, mjs_val_t obj) {
     size_t bytelen = 0;
     mjs_array_buf_get_ptr(mjs, mjs_dataview_get_buf(mjs, obj), &bytelen);
@@ -32,6 +32,12 @@ char* mjs_array_buf_get_ptr(struct mjs* mjs, mjs_val_t buf, size_t* bytelen);
 
 mjs_val_t mjs_dataview_get_buf(struct mjs* mjs, mjs_val_t obj);
 
+/*
+ * Returns the element type of a typed array. Plain ArrayBuffers are
+ * reported as MJS_DATAVIEW_U8.
+ */
+mjs_dataview_type_t mjs_dataview_get_type(struct mjs* mjs, mjs_val_t obj);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -61,6 +61,7 @@ void mjs_destroy(struct mjs* mjs) {
     mbuf_free(&mjs->loop_addresses);
     mbuf_free(&mjs->json_visited_stack);
     mbuf_free(&mjs->array_buffers);
+    mbuf_free(&mjs->gc.gray);
     free(mjs->error_msg);
     free(mjs->stack_trace);
     mjs_ffi_args_free_list(mjs);
@@ -86,6 +87,8 @@ struct mjs* mjs_create(void* context) {
     mbuf_init(&mjs->loop_addresses, 0);
     mbuf_init(&mjs->json_visited_stack, 0);
     mbuf_init(&mjs->array_buffers, 0);
+    mbuf_init(&mjs->gc.gray, 0);
+    mjs->gc.step_budget = MJS_GC_STEP_BUDGET;
 
     mjs->bcode_len = 0;
 
@@ -60,6 +60,19 @@ struct mjs_bcode_part {
     unsigned in_rom : 1;
 };
 
+/*
+ * Result of a lookup made by the instruction at `site`. Entries are flushed
+ * whenever cached objects or properties may go away: on GC and on delete.
+ */
+struct mjs_icache_entry {
+    size_t site; /* Global bcode offset + 1, 0 if the entry is free */
+    size_t scope_depth; /* OP_FIND_SCOPE: size of the scope stack */
+    size_t scope_idx; /* OP_FIND_SCOPE: index of the scope holding the key */
+    mjs_val_t key;
+    mjs_val_t obj; /* Object holding the key */
+    struct mjs_property* prop; /* OP_GET: own property of `obj` */
+};
+
 struct mjs {
     struct mbuf bcode_gen;
     struct mbuf bcode_parts;
@@ -85,12 +98,16 @@ struct mjs {
     mjs_flags_poller_t exec_flags_poller;
     void* context;
 
+    struct mjs_icache_entry icache[MJS_ICACHE_SIZE];
+
     struct gc_arena object_arena;
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
+    struct gc_state gc;
 
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
+    unsigned need_gc_strings : 1; /* Owned strings are due for compaction */
     unsigned generate_jsc : 1;
 };
 
@@ -77,12 +77,62 @@ static size_t call_stack_restore_frame(struct mjs* mjs) {
     return return_address;
 }
 
-static mjs_val_t mjs_find_scope(struct mjs* mjs, mjs_val_t key) {
+MJS_PRIVATE void mjs_icache_flush(struct mjs* mjs) {
+    memset(mjs->icache, 0, sizeof(mjs->icache));
+}
+
+static struct mjs_icache_entry* mjs_icache_get(struct mjs* mjs, size_t site, mjs_val_t key) {
+    struct mjs_icache_entry* entry = &mjs->icache[site % MJS_ICACHE_SIZE];
+    size_t a_len, b_len;
+    const char *a, *b;
+
+    if(entry->site != site + 1) return NULL;
+    if(entry->key == key) return entry;
+
+    /* Strings longer than 5 chars are created anew by every OP_PUSH_STR */
+    if(!mjs_is_string(key) || !mjs_is_string(entry->key)) return NULL;
+    a = mjs_get_string(mjs, &entry->key, &a_len);
+    b = mjs_get_string(mjs, &key, &b_len);
+    return (a_len == b_len && memcmp(a, b, a_len) == 0) ? entry : NULL;
+}
+
+static struct mjs_icache_entry*
+    mjs_icache_put(struct mjs* mjs, size_t site, mjs_val_t key, mjs_val_t obj) {
+    struct mjs_icache_entry* entry = &mjs->icache[site % MJS_ICACHE_SIZE];
+    memset(entry, 0, sizeof(*entry));
+    entry->site = site + 1;
+    entry->key = key;
+    entry->obj = obj;
+    return entry;
+}
+
+/*
+ * Finds the innermost scope which has `key`. `site` is the global bcode offset
+ * of the instruction, the scope found last time from there is checked first.
+ */
+static mjs_val_t mjs_find_scope(struct mjs* mjs, size_t site, mjs_val_t key) {
     size_t num_scopes = mjs_stack_size(&mjs->scopes);
+    struct mjs_icache_entry* entry = mjs_icache_get(mjs, site, key);
+
+    if(entry != NULL && entry->scope_depth == num_scopes &&
+       *vptr(&mjs->scopes, entry->scope_idx) == entry->obj) {
+        /* Inner scopes might have declared the same name since */
+        size_t i = entry->scope_idx + 1;
+        while(i < num_scopes && mjs_get_own_property_v(mjs, *vptr(&mjs->scopes, i), key) == NULL) {
+            i++;
+        }
+        if(i == num_scopes) return entry->obj;
+    }
+
     while(num_scopes > 0) {
         mjs_val_t scope = *vptr(&mjs->scopes, num_scopes - 1);
         num_scopes--;
-        if(mjs_get_own_property_v(mjs, scope, key) != NULL) return scope;
+        if(mjs_get_own_property_v(mjs, scope, key) != NULL) {
+            entry = mjs_icache_put(mjs, site, key, scope);
+            entry->scope_depth = mjs_stack_size(&mjs->scopes);
+            entry->scope_idx = num_scopes;
+            return scope;
+        }
     }
     mjs_set_errorf(mjs, MJS_REFERENCE_ERROR, "[%s] is not defined", mjs_get_cstring(mjs, &key));
     return MJS_UNDEFINED;
@@ -655,9 +705,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
         mjs->cur_bcode_offset = i;
 
         if(mjs->need_gc) {
-            if(maybe_gc(mjs)) {
-                mjs->need_gc = 0;
-            }
+            gc_step(mjs, mjs->gc.step_budget, 1);
         }
 #if MJS_AGGRESSIVE_GC
         maybe_gc(mjs);
@@ -742,7 +790,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
         }
         case OP_FIND_SCOPE: {
             mjs_val_t key = vtop(&mjs->stack);
-            mjs_push(mjs, mjs_find_scope(mjs, key));
+            mjs_push(mjs, mjs_find_scope(mjs, bp.start_idx + i, key));
             break;
         }
         case OP_CREATE: {
@@ -766,10 +814,23 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
             mjs_val_t obj = mjs_pop(mjs);
             mjs_val_t key = mjs_pop(mjs);
             mjs_val_t val = MJS_UNDEFINED;
+            struct mjs_icache_entry* entry = mjs_icache_get(mjs, bp.start_idx + i, key);
 
-            if(!getprop_builtin(mjs, obj, key, &val)) {
+            if(entry != NULL && entry->obj == obj) {
+                val = entry->prop->value;
+            } else if(!getprop_builtin(mjs, obj, key, &val)) {
                 if(mjs_is_object(obj)) {
-                    val = mjs_get_v_proto(mjs, obj, key);
+                    /* Own properties of plain objects are cached, anything else has builtins */
+                    struct mjs_property* p = NULL;
+                    if((obj & MJS_TAG_MASK) == MJS_TAG_OBJECT && mjs_is_string(key)) {
+                        p = mjs_get_own_property_v(mjs, obj, key);
+                    }
+                    if(p != NULL) {
+                        mjs_icache_put(mjs, bp.start_idx + i, key, obj)->prop = p;
+                        val = p->value;
+                    } else {
+                        val = mjs_get_v_proto(mjs, obj, key);
+                    }
                 } else if((mjs_is_data_view(obj) && (mjs_is_number(key)))) {
                     val = mjs_dataview_get_prop(mjs, obj, key);
                 } else {
@@ -840,7 +901,7 @@ MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res) {
                 mjs_val_t var_name = *vptr(&mjs->stack, -3);
                 mjs_val_t key = mjs_next(mjs, obj, iterator);
                 if(key != MJS_UNDEFINED) {
-                    mjs_val_t scope = mjs_find_scope(mjs, var_name);
+                    mjs_val_t scope = mjs_find_scope(mjs, bp.start_idx + i, var_name);
                     mjs_set_v(mjs, scope, var_name, key);
                 }
             } else {
@@ -1195,6 +1256,70 @@ clean:
     return error;
 }
 
+mjs_err_t mjs_compile(
+    struct mjs* mjs,
+    const char* path,
+    const char* src,
+    const char** bcode,
+    size_t* bcode_len) {
+    mjs->error = mjs_parse(path, src, mjs);
+    if(mjs->error == MJS_OK) {
+        struct mjs_bcode_part* bp = mjs_bcode_part_get(mjs, mjs_bcode_parts_cnt(mjs) - 1);
+        *bcode = bp->data.p;
+        *bcode_len = bp->data.len;
+    }
+    return mjs->error;
+}
+
+mjs_err_t mjs_load_bcode(struct mjs* mjs, char* bcode, size_t bcode_len) {
+    struct mjs_bcode_part bp;
+    mjs_header_item_t header[MJS_HDR_ITEMS_CNT];
+
+    /*
+   * Bcode only refers to itself by relative offsets, so it can be placed at
+   * any global offset. Check that the header at least makes sense.
+   */
+    if(bcode_len < 1 + sizeof(header) || (uint8_t)bcode[0] != OP_BCODE_HEADER) {
+        goto invalid;
+    }
+    memcpy(header, bcode + 1, sizeof(header));
+    if(header[MJS_HDR_ITEM_TOTAL_SIZE] != bcode_len - 1 ||
+       header[MJS_HDR_ITEM_BCODE_OFFSET] <= sizeof(header) ||
+       header[MJS_HDR_ITEM_BCODE_OFFSET] >= header[MJS_HDR_ITEM_TOTAL_SIZE] ||
+       header[MJS_HDR_ITEM_MAP_OFFSET] >= header[MJS_HDR_ITEM_TOTAL_SIZE] ||
+       bcode[header[MJS_HDR_ITEM_BCODE_OFFSET]] != '\0' /* End of the file name */) {
+        goto invalid;
+    }
+
+    memset(&bp, 0, sizeof(bp));
+    bp.data.p = bcode;
+    bp.data.len = bcode_len;
+    bp.start_idx = mjs->bcode_len;
+    bp.exec_res = MJS_ERRS_CNT;
+
+    mjs_bcode_part_add(mjs, &bp);
+    mjs->bcode_len += bp.data.len;
+
+    return MJS_OK;
+
+invalid:
+    free(bcode);
+    return mjs_set_errorf(mjs, MJS_INTERNAL_ERROR, "invalid bcode");
+}
+
+mjs_err_t mjs_exec_bcode(struct mjs* mjs, mjs_val_t* res) {
+    mjs_val_t r = MJS_UNDEFINED;
+    int parts_cnt = mjs_bcode_parts_cnt(mjs);
+
+    if(parts_cnt == 0) {
+        return mjs_set_errorf(mjs, MJS_INTERNAL_ERROR, "no bcode");
+    }
+
+    mjs_execute(mjs, mjs_bcode_part_get(mjs, parts_cnt - 1)->start_idx, &r);
+    if(res != NULL) *res = r;
+    return mjs->error;
+}
+
 mjs_err_t
     mjs_call(struct mjs* mjs, mjs_val_t* res, mjs_val_t func, mjs_val_t this_val, int nargs, ...) {
     va_list ap;
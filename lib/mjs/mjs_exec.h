@@ -20,6 +20,12 @@ extern "C" {
 
 MJS_PRIVATE mjs_err_t mjs_execute(struct mjs* mjs, size_t off, mjs_val_t* res);
 
+/*
+ * Forgets all cached lookups; must be called when objects or properties are
+ * freed or removed.
+ */
+MJS_PRIVATE void mjs_icache_flush(struct mjs* mjs);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
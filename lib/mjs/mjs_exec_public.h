@@ -16,6 +16,36 @@ extern "C" {
 mjs_err_t mjs_exec(struct mjs*, const char* src, mjs_val_t* res);
 
 mjs_err_t mjs_exec_file(struct mjs* mjs, const char* path, mjs_val_t* res);
+
+/*
+ * Version of the bcode format, bcode saved by another version can't be loaded
+ */
+#define MJS_BCODE_VERSION 1
+
+/*
+ * Parses `src` into a new bcode part without executing it. On success,
+ * `bcode` points to the part data, which is self-contained and can be saved
+ * and passed to `mjs_load_bcode()` later. It stays valid until the instance
+ * is destroyed.
+ */
+mjs_err_t mjs_compile(
+    struct mjs* mjs,
+    const char* path,
+    const char* src,
+    const char** bcode,
+    size_t* bcode_len);
+
+/*
+ * Adds a bcode part produced by `mjs_compile()`, skipping the parser. Takes
+ * ownership of `bcode`, which must be allocated with `malloc()`, even if the
+ * data turns out to be invalid.
+ */
+mjs_err_t mjs_load_bcode(struct mjs* mjs, char* bcode, size_t bcode_len);
+
+/*
+ * Executes the bcode part added last by `mjs_compile()` or `mjs_load_bcode()`
+ */
+mjs_err_t mjs_exec_bcode(struct mjs* mjs, mjs_val_t* res);
 mjs_err_t mjs_apply(
     struct mjs* mjs,
     mjs_val_t* res,
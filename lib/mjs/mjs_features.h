@@ -30,4 +30,30 @@
 #endif
 #endif
 
+/*
+ * MJS_ICACHE_SIZE: number of inline cache entries. Scope and property lookups
+ * remember their result per bcode offset, so that the same instruction run
+ * again (e.g. in a loop) doesn't walk the scopes and property lists.
+ */
+#if !defined(MJS_ICACHE_SIZE)
+#define MJS_ICACHE_SIZE 32
+#endif
+
+/*
+ * MJS_OBJECT_INDEX_THRESHOLD: objects with more properties than that get a
+ * hash index, so that property lookup doesn't walk the whole list.
+ */
+#if !defined(MJS_OBJECT_INDEX_THRESHOLD)
+#define MJS_OBJECT_INDEX_THRESHOLD 8
+#endif
+
+/*
+ * MJS_GC_STEP_BUDGET: work done by the garbage collector between two
+ * instructions once a collection is due, in properties scanned and cells
+ * swept. Bounds the GC pause; 0 collects everything at once.
+ */
+#if !defined(MJS_GC_STEP_BUDGET)
+#define MJS_GC_STEP_BUDGET 64
+#endif
+
 #endif /* MJS_FEATURES_H_ */
@@ -9,6 +9,7 @@
 #include "common/mbuf.h"
 
 #include "mjs_core.h"
+#include "mjs_exec.h"
 #include "mjs_ffi.h"
 #include "mjs_gc.h"
 #include "mjs_internal.h"
@@ -17,29 +18,25 @@
 #include "mjs_string.h"
 
 /*
- * Macros for marking reachable things: use bit 0.
- */
-#define MARK(p) (((struct gc_cell*)(p))->head.word |= 1)
-#define UNMARK(p) (((struct gc_cell*)(p))->head.word &= ~1)
-#define MARKED(p) (((struct gc_cell*)(p))->head.word & 1)
-
-/*
- * Similar to `MARK()` / `UNMARK()` / `MARKED()`, but `.._FREE` counterparts
- * are intended to mark free cells (as opposed to used ones), so they use
- * bit 1.
+ * Free cells are tagged with bit 1 of their first word, which holds the link
+ * to the next free cell. Used cells always have a pointer there, so the two
+ * LSBs are clear. Reachable cells are marked in the `marks` bitmap of their
+ * block instead, since the first word of a used cell belongs to the mutator
+ * while marking is in progress.
  */
 #define MARK_FREE(p) (((struct gc_cell*)(p))->head.word |= 2)
-#define UNMARK_FREE(p) (((struct gc_cell*)(p))->head.word &= ~2)
 #define MARKED_FREE(p) (((struct gc_cell*)(p))->head.word & 2)
+#define FREE_NEXT(p) ((struct gc_cell*)(((struct gc_cell*)(p))->head.word & ~(uintptr_t)2))
 
 /*
  * When each arena has that or less free cells, GC will be scheduled
  */
 #define GC_ARENA_CELLS_RESERVE 2
 
+typedef void (*gc_mark_fn_t)(struct mjs* mjs, mjs_val_t* v);
+
 static struct gc_block* gc_new_block(struct gc_arena* a, size_t size);
 static void gc_free_block(struct gc_block* b);
-static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf);
 
 MJS_PRIVATE struct mjs_object* new_object(struct mjs* mjs) {
     return (struct mjs_object*)gc_alloc_cell(mjs, &mjs->object_arena);
@@ -64,31 +61,64 @@ MJS_PRIVATE void gc_arena_init(
     memset(a, 0, sizeof(*a));
     a->cell_size = cell_size;
     a->size_increment = size_increment;
-    a->blocks = gc_new_block(a, initial_size);
+    gc_new_block(a, initial_size);
 }
 
 MJS_PRIVATE void gc_arena_destroy(struct mjs* mjs, struct gc_arena* a) {
     struct gc_block* b;
+    struct gc_cell* cur;
+
+    for(b = a->blocks; b != NULL;) {
+        struct gc_block* tmp;
 
-    if(a->blocks != NULL) {
-        gc_sweep(mjs, a, 0);
-        for(b = a->blocks; b != NULL;) {
-            struct gc_block* tmp;
-            tmp = b;
-            b = b->next;
-            gc_free_block(tmp);
+        if(a->destructor != NULL) {
+            for(cur = b->base; cur < GC_CELL_OP(a, b->base, +, b->size);
+                cur = GC_CELL_OP(a, cur, +, 1)) {
+                if(!MARKED_FREE(cur)) {
+                    a->destructor(mjs, cur);
+                }
+            }
         }
+
+        tmp = b;
+        b = b->next;
+        gc_free_block(tmp);
     }
+    a->blocks = NULL;
+
+    free(a->blocks_by_addr);
+    a->blocks_by_addr = NULL;
+    a->blocks_cnt = 0;
 }
 
 static void gc_free_block(struct gc_block* b) {
+    free(b->marks);
     free(b->base);
     free(b);
 }
 
+/*
+ * Returns the index of the first block in `blocks_by_addr` with the base
+ * above `p`
+ */
+static size_t gc_blocks_upper_bound(const struct gc_arena* a, const void* p) {
+    size_t lo = 0, hi = a->blocks_cnt;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if((uintptr_t)a->blocks_by_addr[mid]->base <= (uintptr_t)p) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* Adds a new block in front of the arena blocks list */
 static struct gc_block* gc_new_block(struct gc_arena* a, size_t size) {
     struct gc_cell* cur;
     struct gc_block* b;
+    size_t pos;
 
     b = (struct gc_block*)calloc(1, sizeof(*b));
     if(b == NULL) abort();
@@ -96,16 +126,73 @@ static struct gc_block* gc_new_block(struct gc_arena* a, size_t size) {
     b->size = size;
     b->base = (struct gc_cell*)calloc(a->cell_size, b->size);
     if(b->base == NULL) abort();
+    b->marks = (uint8_t*)calloc(1, (b->size + 7) / 8);
+    if(b->marks == NULL) abort();
 
     for(cur = GC_CELL_OP(a, b->base, +, 0); cur < GC_CELL_OP(a, b->base, +, b->size);
         cur = GC_CELL_OP(a, cur, +, 1)) {
         cur->head.link = a->free;
+        MARK_FREE(cur);
         a->free = cur;
     }
 
+    b->next = a->blocks;
+    a->blocks = b;
+
+    a->blocks_by_addr = (struct gc_block**)realloc( //-V701
+        a->blocks_by_addr,
+        (a->blocks_cnt + 1) * sizeof(*a->blocks_by_addr));
+    if(a->blocks_by_addr == NULL) abort();
+    pos = gc_blocks_upper_bound(a, b->base);
+    memmove(
+        &a->blocks_by_addr[pos + 1],
+        &a->blocks_by_addr[pos],
+        (a->blocks_cnt - pos) * sizeof(*a->blocks_by_addr));
+    a->blocks_by_addr[pos] = b;
+    a->blocks_cnt++;
+
+    return b;
+}
+
+/*
+ * Returns the block holding the cell `p` and the cell index in it, or NULL
+ * if `p` isn't a cell of the arena
+ */
+static struct gc_block* gc_find_block(const struct gc_arena* a, const void* p, size_t* idx) {
+    size_t pos = gc_blocks_upper_bound(a, p);
+    struct gc_block* b;
+
+    if(pos == 0) return NULL;
+    b = a->blocks_by_addr[pos - 1];
+    if((uintptr_t)p >= (uintptr_t)GC_CELL_OP(a, b->base, +, b->size)) return NULL;
+
+    *idx = ((uintptr_t)p - (uintptr_t)b->base) / a->cell_size;
     return b;
 }
 
+/* Marks the cell `p`, returns whether it wasn't marked before */
+static int gc_mark_cell(const struct gc_arena* a, const void* p) {
+    size_t idx = 0;
+    struct gc_block* b = gc_find_block(a, p, &idx);
+    uint8_t bit;
+
+    if(b == NULL) {
+        abort();
+    }
+
+    bit = 1 << (idx % 8);
+    if(b->marks[idx / 8] & bit) return 0;
+    b->marks[idx / 8] |= bit;
+    return 1;
+}
+
+static void gc_clear_marks(struct gc_arena* a) {
+    struct gc_block* b;
+    for(b = a->blocks; b != NULL; b = b->next) {
+        memset(b->marks, 0, (b->size + 7) / 8);
+    }
+}
+
 /*
  * Returns whether the given arena has GC_ARENA_CELLS_RESERVE or less free
  * cells
@@ -114,7 +201,7 @@ static int gc_arena_is_gc_needed(struct gc_arena* a) {
     struct gc_cell* r = a->free;
     int i;
 
-    for(i = 0; i <= GC_ARENA_CELLS_RESERVE; i++, r = r->head.link) {
+    for(i = 0; i <= GC_ARENA_CELLS_RESERVE; i++, r = FREE_NEXT(r)) {
         if(r == NULL) {
             return 1;
         }
@@ -132,15 +219,11 @@ MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
     struct gc_cell* r;
 
     if(a->free == NULL) {
-        struct gc_block* b = gc_new_block(a, a->size_increment);
-        b->next = a->blocks;
-        a->blocks = b;
+        gc_new_block(a, a->size_increment);
     }
     r = a->free;
 
-    UNMARK(r);
-
-    a->free = r->head.link;
+    a->free = FREE_NEXT(r);
 
 #if MJS_MEMORY_STATS
     a->allocations++;
@@ -157,165 +240,38 @@ MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
    * are overwritten downstream, but not worth the yak shave time
    * when fields are added to GC-able structures */
     memset(r, 0, a->cell_size);
-    return (void*)r;
-}
-
-/*
- * Scans the arena and add all unmarked cells to the free list.
- *
- * Empty blocks get deallocated. The head of the free list will contais cells
- * from the last (oldest) block. Cells will thus be allocated in block order.
- */
-void gc_sweep(struct mjs* mjs, struct gc_arena* a, size_t start) {
-    struct gc_block* b;
-    struct gc_cell* cur;
-    struct gc_block** prevp = &a->blocks;
-#if MJS_MEMORY_STATS
-    a->alive = 0;
-#endif
 
     /*
-   * Before we sweep, we should mark all free cells in a way that is
-   * distinguishable from marked used cells.
+   * Cells allocated during a collection survive it: the mutator didn't get to
+   * store them anywhere yet, so they'd otherwise look like garbage
    */
-    {
-        struct gc_cell* next;
-        for(cur = a->free; cur != NULL; cur = next) {
-            next = cur->head.link;
-            MARK_FREE(cur);
-        }
+    if(mjs->gc.phase != GC_PHASE_IDLE) {
+        gc_mark_cell(a, r);
     }
+    return (void*)r;
+}
 
-    /*
-   * We'll rebuild the whole `free` list, so initially we just reset it
-   */
-    a->free = NULL;
-
-    for(b = a->blocks; b != NULL;) {
-        size_t freed_in_block = 0;
-        /*
-     * if it turns out that this block is 100% garbage
-     * we can release the whole block, but the addition
-     * of it's cells to the free list has to be undone.
-     */
-        struct gc_cell* prev_free = a->free;
-
-        for(cur = GC_CELL_OP(a, b->base, +, start); cur < GC_CELL_OP(a, b->base, +, b->size);
-            cur = GC_CELL_OP(a, cur, +, 1)) {
-            if(MARKED(cur)) {
-                /* The cell is used and marked  */
-                UNMARK(cur);
-#if MJS_MEMORY_STATS
-                a->alive++;
-#endif
+/* Takes cells of the block off the free list, before the block is released */
+static size_t gc_unlink_free_cells(struct gc_arena* a, struct gc_block* b) {
+    struct gc_cell* prev = NULL;
+    struct gc_cell *cur, *next;
+    size_t work = 0;
+
+    for(cur = a->free; cur != NULL; cur = next, work++) {
+        next = FREE_NEXT(cur);
+        if(cur >= b->base && cur < GC_CELL_OP(a, b->base, +, b->size)) {
+            if(prev == NULL) {
+                a->free = next;
             } else {
-                /*
-         * The cell is either:
-         * - free
-         * - garbage that's about to be freed
-         */
-
-                if(MARKED_FREE(cur)) {
-                    /* The cell is free, so, just unmark it */
-                    UNMARK_FREE(cur);
-                } else {
-                    /*
-           * The cell is used and should be freed: call the destructor and
-           * reset the memory
-           */
-                    if(a->destructor != NULL) {
-                        a->destructor(mjs, cur);
-                    }
-                    memset(cur, 0, a->cell_size);
-                }
-
-                /* Add this cell to the `free` list */
-                cur->head.link = a->free;
-                a->free = cur;
-                freed_in_block++;
-#if MJS_MEMORY_STATS
-                a->garbage++;
-#endif
+                prev->head.link = next;
+                MARK_FREE(prev);
             }
-        }
-
-        /*
-     * don't free the initial block, which is at the tail
-     * because it has a special size aimed at reducing waste
-     * and simplifying initial startup. TODO(mkm): improve
-     * */
-        if(b->next != NULL && freed_in_block == b->size) {
-            *prevp = b->next;
-            gc_free_block(b);
-            b = *prevp;
-            a->free = prev_free;
         } else {
-            prevp = &b->next;
-            b = b->next;
-        }
-    }
-}
-
-/* Mark an FFI signature */
-static void gc_mark_ffi_sig(struct mjs* mjs, mjs_val_t* v) {
-    struct mjs_ffi_sig* psig;
-
-    assert(mjs_is_ffi_sig(*v));
-
-    psig = mjs_get_ffi_sig_struct(*v);
-
-    /*
-   * we treat all object like things like objects but they might be functions,
-   * gc_check_val checks the appropriate arena per actual value type.
-   */
-    if(!gc_check_val(mjs, *v)) {
-        abort();
-    }
-
-    if(MARKED(psig)) return;
-
-    MARK(psig);
-}
-
-/* Mark an object */
-static void gc_mark_object(struct mjs* mjs, mjs_val_t* v) {
-    struct mjs_object* obj_base;
-    struct mjs_property* prop;
-    struct mjs_property* next;
-
-    assert(mjs_is_object_based(*v));
-
-    obj_base = get_object_struct(*v);
-
-    /*
-   * we treat all object like things like objects but they might be functions,
-   * gc_check_val checks the appropriate arena per actual value type.
-   */
-    if(!gc_check_val(mjs, *v)) {
-        abort();
-    }
-
-    if(MARKED(obj_base)) return;
-
-    /* mark object itself, and its properties */
-    for((prop = obj_base->properties), MARK(obj_base); prop != NULL; prop = next) {
-        if(!gc_check_ptr(&mjs->property_arena, prop)) {
-            abort();
+            prev = cur;
         }
-
-        gc_mark(mjs, &prop->name);
-        gc_mark(mjs, &prop->value);
-
-        next = prop->next;
-        MARK(prop);
     }
 
-    /* mark object's prototype */
-    /*
-   * We dropped support for object prototypes in MJS.
-   * If we ever bring it back, don't forget to mark it
-   */
-    /* gc_mark(mjs, mjs_get_proto(mjs, v)); */
+    return work;
 }
 
 /* Mark a string value */
@@ -366,15 +322,28 @@ static void gc_mark_string(struct mjs* mjs, mjs_val_t* v) {
     memcpy(v, &tmp, sizeof(tmp));
 }
 
+/* Marks a value if it's an owned string */
+static void gc_mark_string_val(struct mjs* mjs, mjs_val_t* v) {
+    if((*v & MJS_TAG_MASK) == MJS_TAG_STRING_O) {
+        gc_mark_string(mjs, v);
+    }
+}
+
 MJS_PRIVATE void gc_mark(struct mjs* mjs, mjs_val_t* v) {
     if(mjs_is_object_based(*v)) {
-        gc_mark_object(mjs, v);
+        struct mjs_object* obj = get_object_struct(*v);
+        if(gc_mark_cell(&mjs->object_arena, obj)) {
+            mbuf_append(&mjs->gc.gray, &obj, sizeof(obj));
+        }
     }
     if(mjs_is_ffi_sig(*v)) {
-        gc_mark_ffi_sig(mjs, v);
+        gc_mark_cell(&mjs->ffi_sig_arena, mjs_get_ffi_sig_struct(*v));
     }
-    if((*v & MJS_TAG_MASK) == MJS_TAG_STRING_O) {
-        gc_mark_string(mjs, v);
+}
+
+MJS_PRIVATE void gc_write_barrier(struct mjs* mjs, mjs_val_t v) {
+    if(mjs->gc.phase == GC_PHASE_MARK) {
+        gc_mark(mjs, &v);
     }
 }
 
@@ -452,53 +421,300 @@ MJS_PRIVATE int maybe_gc(struct mjs* mjs) {
 /*
  * mark an array of `mjs_val_t` values (*not pointers* to them)
  */
-static void gc_mark_val_array(struct mjs* mjs, mjs_val_t* vals, size_t len) {
+static void
+    gc_mark_val_array(struct mjs* mjs, mjs_val_t* vals, size_t len, gc_mark_fn_t mark) {
     mjs_val_t* vp;
     for(vp = vals; vp < vals + len; vp++) {
-        gc_mark(mjs, vp);
+        mark(mjs, vp);
     }
 }
 
 /*
  * mark an mbuf containing *pointers* to `mjs_val_t` values
  */
-static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf) {
+static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf, gc_mark_fn_t mark) {
     mjs_val_t** vp;
     for(vp = (mjs_val_t**)mbuf->buf; (char*)vp < mbuf->buf + mbuf->len; vp++) {
-        gc_mark(mjs, *vp);
+        mark(mjs, *vp);
     }
 }
 
 /*
  * mark an mbuf containing `mjs_val_t` values (*not pointers* to them)
  */
-static void gc_mark_mbuf_val(struct mjs* mjs, const struct mbuf* mbuf) {
-    gc_mark_val_array(mjs, (mjs_val_t*)mbuf->buf, mbuf->len / sizeof(mjs_val_t));
+static void gc_mark_mbuf_val(struct mjs* mjs, const struct mbuf* mbuf, gc_mark_fn_t mark) {
+    gc_mark_val_array(mjs, (mjs_val_t*)mbuf->buf, mbuf->len / sizeof(mjs_val_t), mark);
 }
 
-static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs) {
+static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs, gc_mark_fn_t mark) {
     for(; cbargs != NULL; cbargs = cbargs->next) {
-        gc_mark(mjs, &cbargs->func);
-        gc_mark(mjs, &cbargs->userdata);
+        mark(mjs, &cbargs->func);
+        mark(mjs, &cbargs->userdata);
+    }
+}
+
+static void gc_mark_roots(struct mjs* mjs, gc_mark_fn_t mark) {
+    gc_mark_val_array(
+        mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t), mark);
+
+    gc_mark_mbuf_pt(mjs, &mjs->owned_values, mark);
+    gc_mark_mbuf_val(mjs, &mjs->scopes, mark);
+    gc_mark_mbuf_val(mjs, &mjs->stack, mark);
+    gc_mark_mbuf_val(mjs, &mjs->call_stack, mark);
+
+    gc_mark_ffi_cbargs_list(mjs, mjs->ffi_cb_args, mark);
+}
+
+/* Mark owned strings referred to by the marked properties */
+static void gc_mark_property_strings(struct mjs* mjs) {
+    struct gc_arena* a = &mjs->property_arena;
+    struct gc_block* b;
+    size_t i;
+
+    for(b = a->blocks; b != NULL; b = b->next) {
+        for(i = 0; i < b->size; i++) {
+            if(b->marks[i / 8] & (1 << (i % 8))) {
+                struct mjs_property* prop = (struct mjs_property*)GC_CELL_OP(a, b->base, +, i);
+                gc_mark_string_val(mjs, &prop->name);
+                gc_mark_string_val(mjs, &prop->value);
+            }
+        }
+    }
+}
+
+/*
+ * Scans properties of gray objects, until there are none left or `budget`
+ * is spent. Returns the work done.
+ */
+static size_t gc_scan(struct mjs* mjs, size_t budget) {
+    struct gc_state* gc = &mjs->gc;
+    size_t work = 0;
+
+    while(work < budget) {
+        struct mjs_property* prop = gc->scan;
+
+        if(prop == NULL) {
+            struct mjs_object* obj;
+            if(gc->gray.len == 0) break;
+
+            gc->gray.len -= sizeof(obj);
+            memcpy(&obj, gc->gray.buf + gc->gray.len, sizeof(obj));
+            gc->scan = obj->properties;
+        } else {
+            /*
+       * A property deleted meanwhile keeps its `next`, and properties
+       * added meanwhile are marked on allocation, so the walk may go on
+       */
+            gc_mark_cell(&mjs->property_arena, prop);
+            gc_mark(mjs, &prop->name);
+            gc_mark(mjs, &prop->value);
+            gc->scan = prop->next;
+        }
+        work++;
+    }
+
+    return work;
+}
+
+static void gc_start(struct mjs* mjs) {
+    struct gc_state* gc = &mjs->gc;
+
+    gc_clear_marks(&mjs->object_arena);
+    gc_clear_marks(&mjs->property_arena);
+    gc_clear_marks(&mjs->ffi_sig_arena);
+
+    gc->gray.len = 0;
+    gc->scan = NULL;
+    gc->phase = GC_PHASE_MARK;
+
+    gc_mark_roots(mjs, gc_mark);
+}
+
+/*
+ * Ends the mark phase at once. Roots are marked again, since writes to them
+ * don't go through the write barrier. Owned strings, if due, are compacted
+ * here too: marking a string links together the values referring to it, so
+ * the mutator must not run until they are relocated.
+ */
+static void gc_finish_marking(struct mjs* mjs, int compact_strings) {
+    struct gc_state* gc = &mjs->gc;
+
+    gc_mark_roots(mjs, gc_mark);
+    gc_scan(mjs, ~(size_t)0);
+
+    mjs_icache_flush(mjs);
+
+    if(compact_strings) {
+        gc_mark_roots(mjs, gc_mark_string_val);
+        gc_mark_property_strings(mjs);
+        gc_compact_strings(mjs);
+        mjs->need_gc_strings = 0;
+    }
+
+    gc->phase = GC_PHASE_SWEEP;
+    gc->sweep_arena = &mjs->object_arena;
+    gc->sweep_block = gc->sweep_arena->blocks;
+    gc->sweep_cell = 0;
+}
+
+static int gc_block_is_free(struct gc_arena* a, struct gc_block* b) {
+    struct gc_cell* cur;
+    for(cur = b->base; cur < GC_CELL_OP(a, b->base, +, b->size); cur = GC_CELL_OP(a, cur, +, 1)) {
+        if(!MARKED_FREE(cur)) return 0;
+    }
+    return 1;
+}
+
+static size_t gc_release_block(struct gc_arena* a, struct gc_block* b) {
+    struct gc_block** prevp = &a->blocks;
+    size_t work = gc_unlink_free_cells(a, b);
+    size_t pos = gc_blocks_upper_bound(a, b->base) - 1;
+
+    while(*prevp != b) {
+        prevp = &(*prevp)->next;
+    }
+    *prevp = b->next;
+
+    a->blocks_cnt--;
+    memmove(
+        &a->blocks_by_addr[pos],
+        &a->blocks_by_addr[pos + 1],
+        (a->blocks_cnt - pos) * sizeof(*a->blocks_by_addr));
+
+    gc_free_block(b);
+
+    return work;
+}
+
+/*
+ * Frees unmarked cells, until all arenas are swept or `budget` is spent.
+ * Arenas are swept in order, so that object destructors still see the
+ * properties of the object. Returns the work done.
+ */
+static size_t gc_sweep(struct mjs* mjs, size_t budget) {
+    struct gc_state* gc = &mjs->gc;
+    size_t work = 0;
+
+    while(work < budget && gc->sweep_arena != NULL) {
+        struct gc_arena* a = gc->sweep_arena;
+        struct gc_block* b = gc->sweep_block;
+        struct gc_cell* cur;
+        uint8_t bit;
+
+        if(b == NULL) {
+            if(a == &mjs->object_arena) {
+                gc->sweep_arena = &mjs->property_arena;
+            } else if(a == &mjs->property_arena) {
+                gc->sweep_arena = &mjs->ffi_sig_arena;
+            } else {
+                gc->sweep_arena = NULL;
+                break;
+            }
+            gc->sweep_block = gc->sweep_arena->blocks;
+            gc->sweep_cell = 0;
+            continue;
+        }
+
+        cur = GC_CELL_OP(a, b->base, +, gc->sweep_cell);
+        bit = 1 << (gc->sweep_cell % 8);
+        if(b->marks[gc->sweep_cell / 8] & bit) {
+            /* The cell is used and marked */
+            b->marks[gc->sweep_cell / 8] &= ~bit;
+        } else if(!MARKED_FREE(cur)) {
+            /*
+       * The cell is garbage: call the destructor, reset the memory and add
+       * it to the `free` list
+       */
+            if(a->destructor != NULL) {
+                a->destructor(mjs, cur);
+            }
+            memset(cur, 0, a->cell_size);
+
+            cur->head.link = a->free;
+            MARK_FREE(cur);
+            a->free = cur;
+#if MJS_MEMORY_STATS
+            a->garbage++;
+            a->alive--;
+#endif
+        }
+        work++;
+
+        if(++gc->sweep_cell == b->size) {
+            gc->sweep_block = b->next;
+            gc->sweep_cell = 0;
+
+            /*
+       * don't free the initial block, which is at the tail
+       * because it has a special size aimed at reducing waste
+       * and simplifying initial startup. TODO(mkm): improve
+       * */
+            if(b->next != NULL && gc_block_is_free(a, b)) {
+                work += gc_release_block(a, b);
+            }
+        }
     }
+
+    return work;
+}
+
+MJS_PRIVATE int gc_step(struct mjs* mjs, size_t budget, int compact_strings) {
+    struct gc_state* gc = &mjs->gc;
+    size_t work = 0;
+
+    if(mjs->inhibit_gc) {
+        return mjs->need_gc;
+    }
+    if(budget == 0) {
+        budget = ~(size_t)0;
+    }
+
+    if(gc->phase == GC_PHASE_IDLE) {
+        if(!mjs->need_gc) return 0;
+        gc_start(mjs);
+    }
+
+    if(gc->phase == GC_PHASE_MARK) {
+        work = gc_scan(mjs, budget);
+        if(gc->scan != NULL || gc->gray.len != 0) return 1;
+        /* Compaction moves owned strings, so it waits for the interpreter */
+        if(mjs->need_gc_strings && !compact_strings) return 0;
+        gc_finish_marking(mjs, mjs->need_gc_strings);
+    }
+
+    if(work < budget) {
+        gc_sweep(mjs, budget - work);
+    }
+    if(gc->sweep_arena != NULL) return 1;
+
+    gc->phase = GC_PHASE_IDLE;
+    mjs->need_gc = 0;
+    return 0;
+}
+
+int mjs_gc_step(struct mjs* mjs, size_t budget) {
+    return gc_step(mjs, budget, 0);
+}
+
+void mjs_set_gc_step_budget(struct mjs* mjs, size_t budget) {
+    mjs->gc.step_budget = budget;
 }
 
 /* Perform garbage collection */
 void mjs_gc(struct mjs* mjs, int full) {
-    gc_mark_val_array(mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t));
-
-    gc_mark_mbuf_pt(mjs, &mjs->owned_values);
-    gc_mark_mbuf_val(mjs, &mjs->scopes);
-    gc_mark_mbuf_val(mjs, &mjs->stack);
-    gc_mark_mbuf_val(mjs, &mjs->call_stack);
+    struct gc_state* gc = &mjs->gc;
 
-    gc_mark_ffi_cbargs_list(mjs, mjs->ffi_cb_args);
+    /* Marking in progress may just start over, but sweeping has to complete */
+    if(gc->phase == GC_PHASE_SWEEP) {
+        gc_sweep(mjs, ~(size_t)0);
+    }
 
-    gc_compact_strings(mjs);
+    gc_start(mjs);
+    gc_finish_marking(mjs, 1);
+    gc_sweep(mjs, ~(size_t)0);
 
-    gc_sweep(mjs, &mjs->object_arena, 0);
-    gc_sweep(mjs, &mjs->property_arena, 0);
-    gc_sweep(mjs, &mjs->ffi_sig_arena, 0);
+    gc->phase = GC_PHASE_IDLE;
+    mjs->need_gc = 0;
 
     if(full) {
         /*
@@ -524,12 +740,6 @@ MJS_PRIVATE int gc_check_val(struct mjs* mjs, mjs_val_t v) {
 }
 
 MJS_PRIVATE int gc_check_ptr(const struct gc_arena* a, const void* ptr) {
-    const struct gc_cell* p = (const struct gc_cell*)ptr;
-    struct gc_block* b;
-    for(b = a->blocks; b != NULL; b = b->next) {
-        if(p >= b->base && p < GC_CELL_OP(a, b->base, +, b->size)) {
-            return 1;
-        }
-    }
-    return 0;
+    size_t idx;
+    return gc_find_block(a, ptr, &idx) != NULL;
 }
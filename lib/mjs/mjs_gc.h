@@ -31,6 +31,13 @@ struct gc_cell {
 
 MJS_PRIVATE int gc_strings_is_gc_needed(struct mjs* mjs);
 
+/*
+ * Incremental collection step, see `mjs_gc_step()`. Owned strings are only
+ * compacted if `compact_strings` is set: the caller must not hold pointers to
+ * them, as natives do while they run.
+ */
+MJS_PRIVATE int gc_step(struct mjs* mjs, size_t budget, int compact_strings);
+
 /* perform gc if not inhibited */
 MJS_PRIVATE int maybe_gc(struct mjs* mjs);
 
@@ -38,11 +45,20 @@ MJS_PRIVATE struct mjs_object* new_object(struct mjs*);
 MJS_PRIVATE struct mjs_property* new_property(struct mjs*);
 MJS_PRIVATE struct mjs_ffi_sig* new_ffi_sig(struct mjs* mjs);
 
+/*
+ * Marks the object or FFI signature the value refers to. Objects are queued
+ * for scanning of their properties.
+ */
 MJS_PRIVATE void gc_mark(struct mjs* mjs, mjs_val_t* val);
 
+/*
+ * Must be called for every value stored into an object property, so that
+ * marking in progress doesn't miss it
+ */
+MJS_PRIVATE void gc_write_barrier(struct mjs* mjs, mjs_val_t val);
+
 MJS_PRIVATE void gc_arena_init(struct gc_arena*, size_t, size_t, size_t);
 MJS_PRIVATE void gc_arena_destroy(struct mjs*, struct gc_arena* a);
-MJS_PRIVATE void gc_sweep(struct mjs*, struct gc_arena*, size_t);
 MJS_PRIVATE void* gc_alloc_cell(struct mjs*, struct gc_arena*);
 
 MJS_PRIVATE uint64_t gc_string_mjs_val_to_offset(mjs_val_t v);
@@ -18,6 +18,24 @@ extern "C" {
  */
 void mjs_gc(struct mjs* mjs, int full);
 
+/*
+ * Perform at most `budget` units of incremental garbage collection work, if
+ * a collection is due. A unit is a property scanned or a heap cell swept;
+ * 0 means no limit. The end of marking is done at once.
+ * Owned strings are never compacted here, so that natives may call it while
+ * holding string pointers. When the strings buffer is due for compaction, the
+ * end of marking is left to the interpreter, which compacts between
+ * instructions.
+ * Returns 1 if further steps have work left.
+ */
+int mjs_gc_step(struct mjs* mjs, size_t budget);
+
+/*
+ * Set the budget of the steps the interpreter takes between instructions
+ * while a collection is in progress. 0 makes every collection run at once.
+ */
+void mjs_set_gc_step_budget(struct mjs* mjs, size_t budget);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -6,6 +6,7 @@
 #ifndef MJS_MM_H_
 #define MJS_MM_H_
 
+#include "common/mbuf.h"
 #include "mjs_internal.h"
 
 #if defined(__cplusplus)
@@ -13,6 +14,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 struct mjs;
+struct mjs_property;
 
 typedef void (*gc_cell_destructor_t)(struct mjs* mjs, void*);
 
@@ -20,10 +22,13 @@ struct gc_block {
     struct gc_block* next;
     struct gc_cell* base;
     size_t size;
+    uint8_t* marks; /* Mark bits of the cells, one per cell */
 };
 
 struct gc_arena {
     struct gc_block* blocks;
+    struct gc_block** blocks_by_addr; /* Sorted by base, to find the block of a cell */
+    size_t blocks_cnt;
     size_t size_increment;
     struct gc_cell* free; /* head of free list */
     size_t cell_size;
@@ -37,6 +42,27 @@ struct gc_arena {
     gc_cell_destructor_t destructor;
 };
 
+enum gc_phase {
+    GC_PHASE_IDLE,
+    GC_PHASE_MARK,
+    GC_PHASE_SWEEP,
+};
+
+/*
+ * State of the incremental collection, see `mjs_gc_step()`. Marked objects
+ * are black once their properties are scanned, and gray until then. Cells
+ * allocated while a collection is in progress are marked right away.
+ */
+struct gc_state {
+    enum gc_phase phase;
+    struct mbuf gray; /* Gray objects, (struct mjs_object *) */
+    struct mjs_property* scan; /* Next property of the object being scanned */
+    struct gc_arena* sweep_arena;
+    struct gc_block* sweep_block;
+    size_t sweep_cell;
+    size_t step_budget; /* Work of a step taken between instructions */
+};
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -5,6 +5,7 @@
 
 #include "mjs_object.h"
 #include "mjs_core.h"
+#include "mjs_exec.h"
 #include "mjs_internal.h"
 #include "mjs_primitive.h"
 #include "mjs_string.h"
@@ -27,11 +28,126 @@ MJS_PRIVATE void mjs_obj_destructor(struct mjs* mjs, void* cell) {
 
     struct mjs_property* destructor = mjs_get_own_property(
         mjs, obj_val, MJS_DESTRUCTOR_PROP_NAME, strlen(MJS_DESTRUCTOR_PROP_NAME));
-    if(!destructor) return;
-    if(!mjs_is_foreign(destructor->value)) return;
+    if(destructor && mjs_is_foreign(destructor->value)) {
+        mjs_custom_obj_destructor_t destructor_fn = mjs_get_ptr(mjs, destructor->value);
+        if(destructor_fn) destructor_fn(mjs, obj_val);
+    }
+
+    free(obj->index);
+    obj->index = NULL;
+}
+
+#define MJS_PROPERTY_INDEX_MIN_CAPACITY 16
+#define MJS_PROPERTY_INDEX_DELETED ((struct mjs_property*)1)
+
+static uint32_t mjs_property_hash(const char* name, size_t len) {
+    /* FNV-1a */
+    uint32_t hash = 2166136261UL;
+    while(len--) {
+        hash = (hash ^ (uint8_t)*name++) * 16777619UL;
+    }
+    return hash;
+}
+
+static uint32_t mjs_property_name_hash(struct mjs* mjs, struct mjs_property* p) {
+    size_t len;
+    const char* name = mjs_get_string(mjs, &p->name, &len);
+    return mjs_property_hash(name, len);
+}
+
+static void
+    mjs_property_index_insert(struct mjs* mjs, struct mjs_object* o, struct mjs_property* p) {
+    struct mjs_property_index* index = o->index;
+    size_t mask = index->capacity - 1;
+    size_t i = mjs_property_name_hash(mjs, p) & mask;
+
+    while(index->slots[i] != NULL && index->slots[i] != MJS_PROPERTY_INDEX_DELETED) {
+        i = (i + 1) & mask;
+    }
+
+    if(index->slots[i] == NULL) index->used++;
+    index->slots[i] = p;
+}
+
+/*
+ * (Re)creates the index, sized for the properties the object has now, and
+ * drops deleted slots
+ */
+static void mjs_property_index_rebuild(struct mjs* mjs, struct mjs_object* o, size_t count) {
+    size_t capacity = MJS_PROPERTY_INDEX_MIN_CAPACITY;
+    struct mjs_property* p;
+
+    /* Keep the load factor under 3/4 with some space to grow */
+    while((count + 1) * 2 > capacity) {
+        capacity *= 2;
+    }
+
+    free(o->index);
+    o->index = calloc(1, sizeof(struct mjs_property_index) + capacity * sizeof(p));
+    o->index->capacity = capacity;
+
+    for(p = o->properties; p != NULL; p = p->next) {
+        mjs_property_index_insert(mjs, o, p);
+    }
+}
+
+/*
+ * Adds the newest property, the head of the list, to the index. Creates the
+ * index once the object outgrows MJS_OBJECT_INDEX_THRESHOLD.
+ */
+static void mjs_property_index_add(struct mjs* mjs, struct mjs_object* o) {
+    struct mjs_property* p;
+    size_t count = 0;
 
-    mjs_custom_obj_destructor_t destructor_fn = mjs_get_ptr(mjs, destructor->value);
-    if(destructor_fn) destructor_fn(mjs, obj_val);
+    if(o->index != NULL && (o->index->used + 1) * 4 <= o->index->capacity * 3) {
+        mjs_property_index_insert(mjs, o, o->properties);
+        return;
+    }
+
+    for(p = o->properties; p != NULL; p = p->next) {
+        count++;
+    }
+    if(o->index != NULL || count > MJS_OBJECT_INDEX_THRESHOLD) {
+        mjs_property_index_rebuild(mjs, o, count);
+    }
+}
+
+static void
+    mjs_property_index_remove(struct mjs* mjs, struct mjs_object* o, struct mjs_property* p) {
+    struct mjs_property_index* index = o->index;
+    size_t mask = index->capacity - 1;
+    size_t i = mjs_property_name_hash(mjs, p) & mask;
+
+    while(index->slots[i] != NULL) {
+        if(index->slots[i] == p) {
+            index->slots[i] = MJS_PROPERTY_INDEX_DELETED;
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static struct mjs_property* mjs_property_index_find(
+    struct mjs* mjs,
+    struct mjs_object* o,
+    mjs_val_t short_name,
+    const char* name,
+    size_t len) {
+    struct mjs_property_index* index = o->index;
+    size_t mask = index->capacity - 1;
+    size_t i = mjs_property_hash(name, len) & mask;
+    struct mjs_property* p;
+
+    while((p = index->slots[i]) != NULL) {
+        if(p != MJS_PROPERTY_INDEX_DELETED) {
+            if(len <= 5 ? (p->name == short_name) : (mjs_strcmp(mjs, &p->name, name, len) == 0)) {
+                return p;
+            }
+        }
+        i = (i + 1) & mask;
+    }
+
+    return NULL;
 }
 
 MJS_PRIVATE struct mjs_object* get_object_struct(mjs_val_t v) {
@@ -52,6 +168,7 @@ mjs_val_t mjs_mk_object(struct mjs* mjs) {
     }
     (void)mjs;
     o->properties = NULL;
+    o->index = NULL;
     return mjs_object_to_value(o);
 }
 
@@ -75,6 +192,13 @@ MJS_PRIVATE struct mjs_property*
 
     o = get_object_struct(obj);
 
+    if(o->index != NULL) {
+        mjs_val_t ss;
+        if(len == (size_t)~0) len = strlen(name);
+        ss = (len <= 5) ? mjs_mk_string(mjs, name, len, 1) : MJS_UNDEFINED;
+        return mjs_property_index_find(mjs, o, ss, name, len);
+    }
+
     if(len <= 5) {
         mjs_val_t ss = mjs_mk_string(mjs, name, len, 1);
         for(p = o->properties; p != NULL; p = p->next) {
@@ -213,9 +337,11 @@ MJS_PRIVATE mjs_err_t mjs_set_internal(
         o = get_object_struct(obj);
         p->next = o->properties;
         o->properties = p;
+        mjs_property_index_add(mjs, o);
     }
 
     p->value = val;
+    gc_write_barrier(mjs, val);
 
 clean:
     if(need_free) {
@@ -246,12 +372,17 @@ int mjs_del(struct mjs* mjs, mjs_val_t obj, const char* name, size_t len) {
         size_t n;
         const char* s = mjs_get_string(mjs, &prop->name, &n);
         if(n == len && strncmp(s, name, len) == 0) {
+            struct mjs_object* o = get_object_struct(obj);
             if(prev) {
                 prev->next = prop->next;
             } else {
-                get_object_struct(obj)->properties = prop->next;
+                o->properties = prop->next;
+            }
+            if(o->index != NULL) {
+                mjs_property_index_remove(mjs, o, prop);
             }
             mjs_destroy_property(&prop);
+            mjs_icache_flush(mjs);
             return 0;
         }
     }
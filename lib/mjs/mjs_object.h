@@ -21,8 +21,19 @@ struct mjs_property {
     mjs_val_t value; /* Property value */
 };
 
+/*
+ * Open addressing hash index of object properties, by name. The list in
+ * struct mjs_object::properties stays the primary storage and keeps the order.
+ */
+struct mjs_property_index {
+    size_t capacity; /* Power of two */
+    size_t used; /* Properties and deleted slots */
+    struct mjs_property* slots[];
+};
+
 struct mjs_object {
     struct mjs_property* properties;
+    struct mjs_property_index* index; /* NULL for small objects */
 };
 
 MJS_PRIVATE struct mjs_object* get_object_struct(mjs_val_t v);
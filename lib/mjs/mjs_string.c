@@ -85,6 +85,7 @@ mjs_val_t mjs_mk_string(struct mjs* mjs, const char* p, size_t len, int copy) {
         } else {
             if(gc_strings_is_gc_needed(mjs)) {
                 mjs->need_gc = 1;
+                mjs->need_gc_strings = 1;
             }
 
             /*
@@ -0,0 +1,138 @@
+#include "crypto1_bitsliced.h"
+
+#include <lib/nfc/helpers/nfc_util.h>
+#include <lib/bit_lib/bit_lib.h>
+#include <furi.h>
+
+// Bitsliced Crypto1: every uint32_t carries the same register bit of 32 independent ciphers.
+// The LFSR is unrolled into a sequence of bits, so that shifting the register costs nothing:
+// before step t odd bit k is seq[t + 47 - 2k] and even bit k is seq[t + 46 - 2k].
+
+#define CRYPTO1_BITSLICED_STATE_BITS            (48U)
+#define CRYPTO1_BITSLICED_NONCE_BITS            (32U)
+#define CRYPTO1_BITSLICED_PARITY_BITS_LAST_STEP (25U)
+
+#define BEBIT(x, n)  FURI_BIT(x, (n) ^ 24)
+#define LANE_MASK(b) ((b) ? UINT32_MAX : 0U)
+
+// Filter sub-functions, equivalent to the nibble tables used by crypto1_filter()
+#define FILTER_A(a, b, c, d)    ((((a) | (b)) ^ ((a) & (d))) ^ ((c) & (((a) ^ (b)) | (d))))
+#define FILTER_B(a, b, c, d)    ((((a) & (b)) | (c)) ^ (((a) ^ (b)) & ((c) | (d))))
+#define FILTER_C(a, b, c, d, e) \
+    (((a) | (((b) | (e)) & ((d) ^ (e)))) ^ (((a) ^ ((b) & (d))) & (((c) ^ (d)) | ((b) & (e)))))
+
+// s points to odd bit 0 of the current state, odd bit k is s[-2k]
+#define ODD(s, k)  ((s)[-2 * (k)])
+// even bit k is s[-1 - 2k]
+#define EVEN(s, k) ((s)[-1 - 2 * (k)])
+
+static inline uint32_t crypto1_bitsliced_filter(const uint32_t* s) {
+    uint32_t f0 = FILTER_B(ODD(s, 3), ODD(s, 2), ODD(s, 1), ODD(s, 0));
+    uint32_t f1 = FILTER_A(ODD(s, 7), ODD(s, 6), ODD(s, 5), ODD(s, 4));
+    uint32_t f2 = FILTER_B(ODD(s, 11), ODD(s, 10), ODD(s, 9), ODD(s, 8));
+    uint32_t f3 = FILTER_B(ODD(s, 15), ODD(s, 14), ODD(s, 13), ODD(s, 12));
+    uint32_t f4 = FILTER_A(ODD(s, 19), ODD(s, 18), ODD(s, 17), ODD(s, 16));
+
+    return FILTER_C(f4, f3, f2, f1, f0);
+}
+
+static inline uint32_t crypto1_bitsliced_feedback(const uint32_t* s) {
+    // Taps of LF_POLY_ODD (0x29CE5C) and LF_POLY_EVEN (0x870804)
+    return ODD(s, 2) ^ ODD(s, 3) ^ ODD(s, 4) ^ ODD(s, 6) ^ ODD(s, 9) ^ ODD(s, 10) ^ ODD(s, 11) ^
+           ODD(s, 14) ^ ODD(s, 15) ^ ODD(s, 16) ^ ODD(s, 19) ^ ODD(s, 21) ^ EVEN(s, 2) ^
+           EVEN(s, 11) ^ EVEN(s, 16) ^ EVEN(s, 17) ^ EVEN(s, 18) ^ EVEN(s, 23);
+}
+
+void crypto1_bitsliced_init(
+    Crypto1Bitsliced* crypto1,
+    const MfClassicKey* keys,
+    size_t keys_count) {
+    furi_assert(crypto1);
+    furi_assert(keys);
+    furi_assert(keys_count <= CRYPTO1_BITSLICED_LANES);
+
+    memset(crypto1, 0, sizeof(Crypto1Bitsliced));
+
+    Crypto1 crypto_temp;
+    for(size_t lane = 0; lane < keys_count; lane++) {
+        crypto1_init(&crypto_temp, bit_lib_bytes_to_num_be(keys[lane].data, sizeof(MfClassicKey)));
+        for(size_t i = 0; i < COUNT_OF(crypto1->odd); i++) {
+            crypto1->odd[i] |= (uint32_t)FURI_BIT(crypto_temp.odd, i) << lane;
+            crypto1->even[i] |= (uint32_t)FURI_BIT(crypto_temp.even, i) << lane;
+        }
+    }
+}
+
+static inline uint32_t crypto1_bitsliced_parity_mismatch(
+    const uint32_t* keystream,
+    uint8_t byte_num,
+    uint32_t nt_enc,
+    uint8_t nt_par_enc) {
+    // Parity of byte N is encrypted with the keystream bit of the first bit of byte N + 1
+    uint8_t nt_enc_byte = (nt_enc >> (24 - 8 * byte_num)) & 0xFF;
+    uint8_t par_bit = (nt_par_enc >> (3 - byte_num)) & 1;
+    uint32_t mismatch = LANE_MASK(nfc_util_even_parity8(nt_enc_byte) ^ par_bit);
+
+    for(size_t i = 8U * byte_num; i < 8U * byte_num + 9U; i++) {
+        mismatch ^= keystream[i];
+    }
+
+    return mismatch;
+}
+
+static bool
+    crypto1_bitsliced_lane_is_weak(const uint32_t* keystream, uint8_t lane, uint32_t nt_enc) {
+    uint32_t ks = 0;
+    for(size_t i = 0; i < CRYPTO1_BITSLICED_NONCE_BITS; i++) {
+        ks |= ((keystream[i] >> lane) & 1U) << (24 ^ i);
+    }
+
+    return crypto1_is_weak_prng_nonce(nt_enc ^ ks);
+}
+
+uint32_t crypto1_bitsliced_check_nt_enc(
+    const Crypto1Bitsliced* crypto1,
+    uint32_t lanes,
+    uint32_t cuid,
+    uint32_t nt_enc,
+    uint8_t nt_par_enc,
+    bool is_weak) {
+    furi_assert(crypto1);
+
+    uint32_t seq[CRYPTO1_BITSLICED_STATE_BITS + CRYPTO1_BITSLICED_NONCE_BITS];
+    uint32_t keystream[CRYPTO1_BITSLICED_NONCE_BITS];
+
+    for(size_t i = 0; i < COUNT_OF(crypto1->odd); i++) {
+        seq[CRYPTO1_BITSLICED_STATE_BITS - 1 - 2 * i] = crypto1->odd[i];
+        seq[CRYPTO1_BITSLICED_STATE_BITS - 2 - 2 * i] = crypto1->even[i];
+    }
+
+    uint32_t in = nt_enc ^ cuid;
+    size_t steps = is_weak ? CRYPTO1_BITSLICED_NONCE_BITS :
+                             CRYPTO1_BITSLICED_PARITY_BITS_LAST_STEP;
+    for(size_t step = 0; (step < steps) && lanes; step++) {
+        const uint32_t* s = &seq[step + CRYPTO1_BITSLICED_STATE_BITS - 1];
+        uint32_t out = crypto1_bitsliced_filter(s);
+        // Nested authentication: encrypted nonce is fed back, so the plain nonce enters the LFSR
+        seq[step + CRYPTO1_BITSLICED_STATE_BITS] =
+            crypto1_bitsliced_feedback(s) ^ LANE_MASK(BEBIT(in, step)) ^ out;
+        keystream[step] = out;
+
+        // As soon as the parity bit of a byte can be decrypted, drop inconsistent lanes
+        if((step % 8 == 0) && (step > 0)) {
+            lanes &=
+                ~crypto1_bitsliced_parity_mismatch(keystream, step / 8 - 1, nt_enc, nt_par_enc);
+        }
+    }
+
+    if(is_weak) {
+        for(uint8_t lane = 0; lane < CRYPTO1_BITSLICED_LANES; lane++) {
+            if(!FURI_BIT(lanes, lane)) continue;
+            if(!crypto1_bitsliced_lane_is_weak(keystream, lane, nt_enc)) {
+                lanes &= ~(1U << lane);
+            }
+        }
+    }
+
+    return lanes;
+}
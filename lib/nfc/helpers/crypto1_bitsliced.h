@@ -0,0 +1,61 @@
+#pragma once
+
+#include "crypto1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRYPTO1_BITSLICED_LANES (32U)
+#define CRYPTO1_BITSLICED_LANES_ALL (UINT32_MAX)
+
+/**
+ * @brief Crypto1 state of up to CRYPTO1_BITSLICED_LANES keys evaluated in parallel.
+ *
+ * Every word holds one register bit, bit n of the word belongs to key (lane) n.
+ */
+typedef struct {
+    uint32_t odd[24];
+    uint32_t even[24];
+} Crypto1Bitsliced;
+
+/**
+ * @brief Load up to CRYPTO1_BITSLICED_LANES keys into bitsliced state.
+ *
+ * Lanes beyond keys_count are left zeroed and must be masked out by the caller.
+ *
+ * @param[out] crypto1 pointer to the bitsliced state to be initialized.
+ * @param[in] keys pointer to the array of keys.
+ * @param[in] keys_count number of keys in the array.
+ */
+void crypto1_bitsliced_init(
+    Crypto1Bitsliced* crypto1,
+    const MfClassicKey* keys,
+    size_t keys_count);
+
+/**
+ * @brief Check which keys are consistent with an encrypted nested nonce.
+ *
+ * Runs the same computation as crypto1_decrypt_nt_enc() followed by
+ * crypto1_nonce_matches_encrypted_parity_bits() for all lanes at once,
+ * leaving the key state untouched. Stops early once no lane survives.
+ *
+ * @param[in] crypto1 pointer to the bitsliced key state.
+ * @param[in] lanes mask of lanes to check.
+ * @param[in] cuid card UID used for authentication.
+ * @param[in] nt_enc encrypted tag nonce.
+ * @param[in] nt_par_enc encrypted parity bits of the tag nonce.
+ * @param[in] is_weak additionally require the decrypted nonce to come from the weak PRNG.
+ * @returns mask of lanes whose keys are consistent with the nonce.
+ */
+uint32_t crypto1_bitsliced_check_nt_enc(
+    const Crypto1Bitsliced* crypto1,
+    uint32_t lanes,
+    uint32_t cuid,
+    uint32_t nt_enc,
+    uint8_t nt_par_enc,
+    bool is_weak);
+
+#ifdef __cplusplus
+}
+#endif
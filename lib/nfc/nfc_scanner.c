@@ -2,11 +2,18 @@
 #include "nfc_poller.h"
 
 #include <nfc/protocols/nfc_poller_defs.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 
 #include <furi/furi.h>
 
 #define TAG "NfcScanner"
 
+#define NFC_SCANNER_UID_CACHE_SIZE (4U)
+#define NFC_SCANNER_PRIOR_MAX      (255U)
+
+// SAK bits of cards that answer MIFARE Classic authentication
+#define NFC_SCANNER_SAK_MF_CLASSIC_MASK (0x19U)
+
 typedef enum {
     NfcScannerStateIdle,
     NfcScannerStateTryBasePollers,
@@ -17,6 +24,18 @@ typedef enum {
     NfcScannerStateNum,
 } NfcScannerState;
 
+typedef enum {
+    NfcScannerHintUnknown,
+    NfcScannerHintAbsent,
+    NfcScannerHintPresent,
+} NfcScannerHint;
+
+typedef struct {
+    Iso14443_3aData iso14443_3a_data;
+    size_t protocols_num;
+    NfcProtocol protocols[NfcProtocolNum];
+} NfcScannerUidCacheEntry;
+
 typedef enum {
     NfcScannerSessionStateIdle,
     NfcScannerSessionStateActive,
@@ -51,9 +70,21 @@ struct NfcScanner {
 
     NfcProtocol current_protocol;
 
+    NfcScannerMode mode;
+    bool anticollision_data_valid;
+    Iso14443_3aData anticollision_data;
+    bool uid_cache_bypass;
+    bool uid_cache_verify;
+    bool results_recorded;
+
     FuriThread* scan_worker;
 };
 
+// Shared by all scanner instances, so that the knowledge survives between scans
+static uint8_t nfc_scanner_protocol_prior[NfcProtocolNum];
+static size_t nfc_scanner_uid_cache_next;
+static NfcScannerUidCacheEntry nfc_scanner_uid_cache[NFC_SCANNER_UID_CACHE_SIZE];
+
 static void nfc_scanner_reset(NfcScanner* instance) {
     instance->base_protocols_idx = 0;
     instance->base_protocols_num = 0;
@@ -65,6 +96,128 @@ static void nfc_scanner_reset(NfcScanner* instance) {
     instance->detected_base_protocols_num = 0;
 
     instance->current_protocol = 0;
+
+    instance->anticollision_data_valid = false;
+    instance->uid_cache_verify = false;
+    instance->results_recorded = false;
+}
+
+static void nfc_scanner_sort_by_prior(NfcProtocol* protocols, size_t protocols_num) {
+    // Insertion sort: the list is short and protocols with equal priors keep the default order
+    for(size_t i = 1; i < protocols_num; i++) {
+        NfcProtocol protocol = protocols[i];
+        size_t j = i;
+        for(; j > 0; j--) {
+            if(nfc_scanner_protocol_prior[protocols[j - 1]] >=
+               nfc_scanner_protocol_prior[protocol]) {
+                break;
+            }
+            protocols[j] = protocols[j - 1];
+        }
+        protocols[j] = protocol;
+    }
+}
+
+static void nfc_scanner_update_prior(const NfcScanner* instance) {
+    for(size_t i = 0; i < NfcProtocolNum; i++) {
+        nfc_scanner_protocol_prior[i] -= nfc_scanner_protocol_prior[i] / 4;
+    }
+    for(size_t i = 0; i < instance->detected_protocols_num; i++) {
+        uint8_t* prior = &nfc_scanner_protocol_prior[instance->detected_protocols[i]];
+        *prior += (NFC_SCANNER_PRIOR_MAX - *prior) / 2;
+    }
+}
+
+static NfcScannerHint
+    nfc_scanner_get_anticollision_hint(const NfcScanner* instance, NfcProtocol protocol) {
+    NfcScannerHint hint = NfcScannerHintUnknown;
+
+    if(instance->anticollision_data_valid) {
+        const Iso14443_3aData* data = &instance->anticollision_data;
+
+        if(protocol == NfcProtocolIso14443_4a) {
+            // ISO14443-4A detection relies on the SAK only
+            hint = iso14443_3a_supports_iso14443_4(data) ? NfcScannerHintPresent :
+                                                           NfcScannerHintAbsent;
+        } else if(protocol == NfcProtocolMfUltralight) {
+            hint = (data->sak == 0) ? NfcScannerHintUnknown : NfcScannerHintAbsent;
+        } else if(protocol == NfcProtocolMfClassic) {
+            hint = (data->sak & NFC_SCANNER_SAK_MF_CLASSIC_MASK) ? NfcScannerHintUnknown :
+                                                                   NfcScannerHintAbsent;
+        }
+    }
+
+    return hint;
+}
+
+static NfcScannerUidCacheEntry* nfc_scanner_uid_cache_find(const Iso14443_3aData* data) {
+    NfcScannerUidCacheEntry* entry = NULL;
+
+    for(size_t i = 0; i < NFC_SCANNER_UID_CACHE_SIZE; i++) {
+        if(nfc_scanner_uid_cache[i].protocols_num == 0) continue;
+        if(iso14443_3a_is_equal(&nfc_scanner_uid_cache[i].iso14443_3a_data, data)) {
+            entry = &nfc_scanner_uid_cache[i];
+            break;
+        }
+    }
+
+    return entry;
+}
+
+static void nfc_scanner_uid_cache_store(const NfcScanner* instance) {
+    size_t probed_num = 0;
+    for(size_t i = 0; i < instance->detected_protocols_num; i++) {
+        NfcProtocol protocol = instance->detected_protocols[i];
+        if(nfc_protocol_get_parent(protocol) == NfcProtocolInvalid) continue;
+        if(nfc_scanner_get_anticollision_hint(instance, protocol) == NfcScannerHintUnknown) {
+            probed_num++;
+        }
+    }
+
+    // A card whose probes all failed may have left the field, do not remember that
+    if(probed_num > 0) {
+        NfcScannerUidCacheEntry* entry = nfc_scanner_uid_cache_find(&instance->anticollision_data);
+        if(entry == NULL) {
+            entry = &nfc_scanner_uid_cache[nfc_scanner_uid_cache_next];
+            nfc_scanner_uid_cache_next =
+                (nfc_scanner_uid_cache_next + 1) % NFC_SCANNER_UID_CACHE_SIZE;
+        }
+
+        entry->iso14443_3a_data = instance->anticollision_data;
+        entry->protocols_num = instance->detected_protocols_num;
+        memcpy(
+            entry->protocols,
+            instance->detected_protocols,
+            instance->detected_protocols_num * sizeof(NfcProtocol));
+    }
+}
+
+static void nfc_scanner_uid_cache_apply(NfcScanner* instance) {
+    const NfcScannerUidCacheEntry* entry =
+        nfc_scanner_uid_cache_find(&instance->anticollision_data);
+
+    if(entry) {
+        // Only the protocols found on this card last time are probed to confirm the result
+        size_t children_protocols_num = 0;
+        for(size_t i = 0; i < instance->children_protocols_num; i++) {
+            for(size_t j = 0; j < entry->protocols_num; j++) {
+                if(instance->children_protocols[i] == entry->protocols[j]) {
+                    instance->children_protocols[children_protocols_num] =
+                        instance->children_protocols[i];
+                    children_protocols_num++;
+                    break;
+                }
+            }
+        }
+
+        FURI_LOG_D(
+            TAG,
+            "UID cache hit, probing %zu of %zu",
+            children_protocols_num,
+            instance->children_protocols_num);
+        instance->children_protocols_num = children_protocols_num;
+        instance->uid_cache_verify = true;
+    }
 }
 
 typedef void (*NfcScannerStateHandler)(NfcScanner* instance);
@@ -79,6 +232,10 @@ void nfc_scanner_state_handler_idle(NfcScanner* instance) {
     }
     FURI_LOG_D(TAG, "Found %zu base protocols", instance->base_protocols_num);
 
+    if(instance->mode == NfcScannerModeFast) {
+        nfc_scanner_sort_by_prior(instance->base_protocols, instance->base_protocols_num);
+    }
+
     instance->first_detected_protocol = NfcProtocolInvalid;
     instance->state = NfcScannerStateTryBasePollers;
 }
@@ -94,6 +251,10 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
 
         NfcPoller* poller = nfc_poller_alloc(instance->nfc, instance->current_protocol);
         bool protocol_detected = nfc_poller_detect(poller);
+        if(protocol_detected && (instance->current_protocol == NfcProtocolIso14443_3a)) {
+            instance->anticollision_data = *(const Iso14443_3aData*)nfc_poller_get_data(poller);
+            instance->anticollision_data_valid = true;
+        }
         nfc_poller_free(poller);
 
         if(protocol_detected) {
@@ -105,6 +266,12 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
                 instance->current_protocol;
             instance->detected_base_protocols_num++;
 
+            if(instance->mode == NfcScannerModeFast) {
+                // Cards answering several technologies are rare, go for the children right away
+                instance->state = NfcScannerStateFindChildrenProtocols;
+                break;
+            }
+
             if(instance->first_detected_protocol == NfcProtocolInvalid) {
                 instance->first_detected_protocol = instance->current_protocol;
                 instance->current_protocol = NfcProtocolInvalid;
@@ -119,13 +286,29 @@ void nfc_scanner_state_handler_try_base_pollers(NfcScanner* instance) {
 void nfc_scanner_state_handler_find_children_protocols(NfcScanner* instance) {
     for(size_t i = 0; i < NfcProtocolNum; i++) {
         for(size_t j = 0; j < instance->detected_base_protocols_num; j++) {
-            if(nfc_protocol_has_parent(i, instance->detected_base_protocols[j])) {
+            if(!nfc_protocol_has_parent(i, instance->detected_base_protocols[j])) continue;
+
+            // The anticollision response already rules out or confirms some protocols
+            NfcScannerHint hint = NfcScannerHintUnknown;
+            if(instance->mode == NfcScannerModeFast) {
+                hint = nfc_scanner_get_anticollision_hint(instance, i);
+            }
+
+            if(hint == NfcScannerHintPresent) {
+                instance->detected_protocols[instance->detected_protocols_num] = i;
+                instance->detected_protocols_num++;
+            } else if(hint == NfcScannerHintUnknown) {
                 instance->children_protocols[instance->children_protocols_num] = i;
                 instance->children_protocols_num++;
             }
         }
     }
 
+    if((instance->mode == NfcScannerModeFast) && instance->anticollision_data_valid &&
+       !instance->uid_cache_bypass) {
+        nfc_scanner_uid_cache_apply(instance);
+    }
+
     if(instance->children_protocols_num > 0) {
         instance->state = NfcScannerStateDetectChildrenProtocols;
     } else {
@@ -147,6 +330,13 @@ void nfc_scanner_state_handler_detect_children_protocols(NfcScanner* instance) {
         instance->detected_protocols[instance->detected_protocols_num] =
             instance->current_protocol;
         instance->detected_protocols_num++;
+    } else if(instance->uid_cache_verify) {
+        // The card differs from the remembered one, start over with the full probe set
+        FURI_LOG_D(TAG, "UID cache mismatch");
+        nfc_scanner_reset(instance);
+        instance->uid_cache_bypass = true;
+        instance->state = NfcScannerStateIdle;
+        return;
     }
 
     instance->children_protocols_idx++;
@@ -177,6 +367,14 @@ static void nfc_scanner_filter_detected_protocols(NfcScanner* instance) {
 }
 
 void nfc_scanner_state_handler_complete(NfcScanner* instance) {
+    if(!instance->results_recorded) {
+        nfc_scanner_update_prior(instance);
+        if((instance->mode == NfcScannerModeFast) && instance->anticollision_data_valid) {
+            nfc_scanner_uid_cache_store(instance);
+        }
+        instance->results_recorded = true;
+    }
+
     if(instance->detected_protocols_num > 1) {
         nfc_scanner_filter_detected_protocols(instance);
     }
@@ -242,6 +440,7 @@ void nfc_scanner_start(NfcScanner* instance, NfcScannerCallback callback, void*
     instance->callback = callback;
     instance->context = context;
     instance->session_state = NfcScannerSessionStateActive;
+    instance->uid_cache_bypass = false;
 
     instance->scan_worker = furi_thread_alloc();
     furi_thread_set_name(instance->scan_worker, "NfcScanWorker");
@@ -252,6 +451,14 @@ void nfc_scanner_start(NfcScanner* instance, NfcScannerCallback callback, void*
     furi_thread_start(instance->scan_worker);
 }
 
+void nfc_scanner_set_mode(NfcScanner* instance, NfcScannerMode mode) {
+    furi_check(instance);
+    furi_check(mode < NfcScannerModeNum);
+    furi_check(instance->scan_worker == NULL);
+
+    instance->mode = mode;
+}
+
 void nfc_scanner_stop(NfcScanner* instance) {
     furi_check(instance);
     furi_check(instance->scan_worker);
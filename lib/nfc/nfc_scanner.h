@@ -11,6 +11,10 @@
  *
  * If no supported cards are in the vicinity, the scanning process will continue
  * until stopped explicitly.
+ *
+ * In the fast mode (see nfc_scanner_set_mode()) the scanner trades some of the greediness
+ * for speed: it stops at the first detected base protocol, skips child protocols ruled out
+ * by the anticollision response and remembers the protocols found on recently seen UIDs.
  */
 #pragma once
 
@@ -33,6 +37,16 @@ typedef enum {
     NfcScannerEventTypeDetected, /**< One or more protocols have been detected. */
 } NfcScannerEventType;
 
+/**
+ * @brief Scanning strategy.
+ */
+typedef enum {
+    NfcScannerModeGreedy, /**< Probe every protocol one after another (default). */
+    NfcScannerModeFast, /**< Probe the likely protocols first and reuse earlier results. */
+
+    NfcScannerModeNum, /**< Special value representing the number of available modes. */
+} NfcScannerMode;
+
 /**
  * @brief Event data passed to the user callback.
  */
@@ -85,6 +99,16 @@ void nfc_scanner_free(NfcScanner* instance);
  */
 void nfc_scanner_start(NfcScanner* instance, NfcScannerCallback callback, void* context);
 
+/**
+ * @brief Set the scanning strategy of an NfcScanner.
+ *
+ * Must be called while the scanner is stopped.
+ *
+ * @param[in,out] instance pointer to the instance to be configured.
+ * @param[in] mode scanning strategy to be used on the next start.
+ */
+void nfc_scanner_set_mode(NfcScanner* instance, NfcScannerMode mode);
+
 /**
  * @brief Stop an NfcScanner.
  *
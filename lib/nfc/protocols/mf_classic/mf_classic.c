@@ -2,11 +2,14 @@
 
 #include <furi/furi.h>
 #include <toolbox/hex.h>
+#include <toolbox/strint.h>
 
 #include <lib/bit_lib/bit_lib.h>
 
 #define MF_CLASSIC_PROTOCOL_NAME "Mifare Classic"
 
+#define MF_CLASSIC_BLOCK_KEY_PREFIX "Block "
+
 typedef struct {
     uint8_t sectors_total;
     uint16_t blocks_total;
@@ -147,6 +150,53 @@ static void mf_classic_parse_block(FuriString* block_str, MfClassicData* data, u
     }
 }
 
+static bool mf_classic_get_block_num_by_key(const FuriString* key, uint32_t* block_num) {
+    const size_t prefix_len = strlen(MF_CLASSIC_BLOCK_KEY_PREFIX);
+    char* end = NULL;
+
+    return furi_string_start_with_str(key, MF_CLASSIC_BLOCK_KEY_PREFIX) &&
+           (strint_to_uint32(&furi_string_get_cstr(key)[prefix_len], &end, block_num, 10) ==
+            StrintParseNoError) &&
+           (*end == '\0');
+}
+
+static bool mf_classic_load_blocks(MfClassicData* data, FlipperFormat* ff, uint16_t blocks_total) {
+    FuriString* key = furi_string_alloc();
+    FuriString* block_str = furi_string_alloc();
+    bool blocks_loaded = true;
+    bool in_order = true;
+
+    for(uint16_t i = 0; i < blocks_total; i++) {
+        bool block_found = false;
+
+        // Saved blocks follow each other, so walk the file line by line instead of seeking
+        while(in_order && flipper_format_read_next_string(ff, key, block_str)) {
+            uint32_t block_num = 0;
+            if(!mf_classic_get_block_num_by_key(key, &block_num)) continue;
+            block_found = (block_num == i);
+            break;
+        }
+
+        if(!block_found) {
+            // Out of order file, fall back to searching every block by key
+            in_order = false;
+            furi_string_printf(key, "%s%u", MF_CLASSIC_BLOCK_KEY_PREFIX, i);
+            if(!flipper_format_rewind(ff) ||
+               !flipper_format_read_string(ff, furi_string_get_cstr(key), block_str)) {
+                blocks_loaded = false;
+                break;
+            }
+        }
+
+        mf_classic_parse_block(block_str, data, i);
+    }
+
+    furi_string_free(block_str);
+    furi_string_free(key);
+
+    return blocks_loaded;
+}
+
 bool mf_classic_load(MfClassicData* data, FlipperFormat* ff, uint32_t version) {
     furi_check(data);
     furi_check(ff);
@@ -184,19 +234,8 @@ bool mf_classic_load(MfClassicData* data, FlipperFormat* ff, uint32_t version) {
         }
 
         // Read Mifare Classic blocks
-        bool block_read = true;
-        FuriString* block_str = furi_string_alloc();
         uint16_t blocks_total = mf_classic_get_total_block_num(data->type);
-        for(size_t i = 0; i < blocks_total; i++) {
-            furi_string_printf(temp_str, "Block %d", i);
-            if(!flipper_format_read_string(ff, furi_string_get_cstr(temp_str), block_str)) {
-                block_read = false;
-                break;
-            }
-            mf_classic_parse_block(block_str, data, i);
-        }
-        furi_string_free(block_str);
-        if(!block_read) break;
+        if(!mf_classic_load_blocks(data, ff, blocks_total)) break;
 
         // Set keys and blocks as unknown for backward compatibility
         if(old_format) {
@@ -213,6 +252,24 @@ bool mf_classic_load(MfClassicData* data, FlipperFormat* ff, uint32_t version) {
     return parsed;
 }
 
+static void mf_classic_cat_block_bytes(
+    FuriString* block_str,
+    const uint8_t* bytes,
+    size_t bytes_num,
+    bool is_known) {
+    static const char hex_chars[] = "0123456789ABCDEF";
+
+    for(size_t i = 0; i < bytes_num; i++) {
+        if(is_known) {
+            furi_string_push_back(block_str, hex_chars[bytes[i] >> 4]);
+            furi_string_push_back(block_str, hex_chars[bytes[i] & 0x0f]);
+        } else {
+            furi_string_cat_str(block_str, "??");
+        }
+        furi_string_push_back(block_str, ' ');
+    }
+}
+
 static void
     mf_classic_set_block_str(FuriString* block_str, const MfClassicData* data, uint8_t block_num) {
     furi_string_reset(block_str);
@@ -221,38 +278,30 @@ static void
         uint8_t sector_num = mf_classic_get_sector_by_block(block_num);
         MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(data, sector_num);
         // Write key A
-        for(size_t i = 0; i < sizeof(sec_tr->key_a); i++) {
-            if(mf_classic_is_key_found(data, sector_num, MfClassicKeyTypeA)) {
-                furi_string_cat_printf(block_str, "%02X ", sec_tr->key_a.data[i]);
-            } else {
-                furi_string_cat_printf(block_str, "?? ");
-            }
-        }
+        mf_classic_cat_block_bytes(
+            block_str,
+            sec_tr->key_a.data,
+            sizeof(sec_tr->key_a),
+            mf_classic_is_key_found(data, sector_num, MfClassicKeyTypeA));
         // Write Access bytes
-        for(size_t i = 0; i < MF_CLASSIC_ACCESS_BYTES_SIZE; i++) {
-            if(mf_classic_is_block_read(data, block_num)) {
-                furi_string_cat_printf(block_str, "%02X ", sec_tr->access_bits.data[i]);
-            } else {
-                furi_string_cat_printf(block_str, "?? ");
-            }
-        }
+        mf_classic_cat_block_bytes(
+            block_str,
+            sec_tr->access_bits.data,
+            MF_CLASSIC_ACCESS_BYTES_SIZE,
+            mf_classic_is_block_read(data, block_num));
         // Write key B
-        for(size_t i = 0; i < sizeof(sec_tr->key_b); i++) {
-            if(mf_classic_is_key_found(data, sector_num, MfClassicKeyTypeB)) {
-                furi_string_cat_printf(block_str, "%02X ", sec_tr->key_b.data[i]);
-            } else {
-                furi_string_cat_printf(block_str, "?? ");
-            }
-        }
+        mf_classic_cat_block_bytes(
+            block_str,
+            sec_tr->key_b.data,
+            sizeof(sec_tr->key_b),
+            mf_classic_is_key_found(data, sector_num, MfClassicKeyTypeB));
     } else {
         // Write data block
-        for(size_t i = 0; i < MF_CLASSIC_BLOCK_SIZE; i++) {
-            if(mf_classic_is_block_read(data, block_num)) {
-                furi_string_cat_printf(block_str, "%02X ", data->block[block_num].data[i]);
-            } else {
-                furi_string_cat_printf(block_str, "?? ");
-            }
-        }
+        mf_classic_cat_block_bytes(
+            block_str,
+            data->block[block_num].data,
+            MF_CLASSIC_BLOCK_SIZE,
+            mf_classic_is_block_read(data, block_num));
     }
     furi_string_trim(block_str);
 }
@@ -282,7 +331,7 @@ bool mf_classic_save(const MfClassicData* data, FlipperFormat* ff) {
         FuriString* block_str = furi_string_alloc();
         bool block_saved = true;
         for(size_t i = 0; i < blocks_total; i++) {
-            furi_string_printf(temp_str, "Block %d", i);
+            furi_string_printf(temp_str, "%s%zu", MF_CLASSIC_BLOCK_KEY_PREFIX, i);
             mf_classic_set_block_str(block_str, data, i);
             if(!flipper_format_write_string(ff, furi_string_get_cstr(temp_str), block_str)) {
                 block_saved = false;
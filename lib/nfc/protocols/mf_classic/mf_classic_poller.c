@@ -6,7 +6,6 @@
 
 #define TAG "MfClassicPoller"
 
-// TODO FL-3926: Buffer writes for Hardnested, set state to Log when finished and sum property matches
 // TODO FL-3926: Store target key in CUID dictionary
 // TODO FL-3926: Dead code for malloc returning NULL?
 // TODO FL-3926: Auth1 static encrypted exists (rare)
@@ -26,6 +25,8 @@ const uint16_t valid_sums[] =
 
 typedef NfcCommand (*MfClassicPollerReadHandler)(MfClassicPoller* instance);
 
+static void mf_classic_poller_nested_log_flush(MfClassicPoller* instance);
+
 MfClassicPoller* mf_classic_poller_alloc(Iso14443_3aPoller* iso14443_3a_poller) {
     furi_assert(iso14443_3a_poller);
 
@@ -78,11 +79,10 @@ void mf_classic_poller_free(MfClassicPoller* instance) {
         dict_attack_ctx->mf_classic_user_dict = NULL;
     }
 
-    // Free the nested nonce array if it exists
-    if(dict_attack_ctx->nested_nonce.nonces) {
-        free(dict_attack_ctx->nested_nonce.nonces);
-        dict_attack_ctx->nested_nonce.nonces = NULL;
-        dict_attack_ctx->nested_nonce.count = 0;
+    // Free the nested nonce array if it exists, nonces collected so far are logged first
+    mf_classic_poller_nested_log_flush(instance);
+    if(instance->nested_nonce.nonces) {
+        free(instance->nested_nonce.nonces);
     }
 
     free(instance);
@@ -158,6 +158,8 @@ NfcCommand mf_classic_poller_handler_start(MfClassicPoller* instance) {
     NfcCommand command = NfcCommandContinue;
 
     instance->sectors_total = mf_classic_get_total_sectors_num(instance->data->type);
+    // Nonce storage lives outside of the mode context and is reused across re-detects
+    mf_classic_poller_nested_log_flush(instance);
     memset(&instance->mode_ctx, 0, sizeof(MfClassicPollerModeContext));
 
     instance->mfc_event.type = MfClassicPollerEventTypeRequestMode;
@@ -1041,15 +1043,17 @@ static bool add_nested_nonce(
     uint32_t nt_enc,
     uint8_t par,
     uint16_t dist) {
-    MfClassicNestedNonce* new_nonces;
-    if(array->count == 0) {
-        new_nonces = malloc(sizeof(MfClassicNestedNonce));
-    } else {
-        new_nonces = realloc(array->nonces, (array->count + 1) * sizeof(MfClassicNestedNonce));
+    if(array->count == array->capacity) {
+        // Grow geometrically, so that long collections don't realloc per nonce
+        size_t new_capacity = (array->capacity == 0) ? MF_CLASSIC_NESTED_NONCE_CAPACITY_MIN :
+                                                       (array->capacity * 2);
+        MfClassicNestedNonce* new_nonces =
+            realloc(array->nonces, new_capacity * sizeof(MfClassicNestedNonce));
+        if(new_nonces == NULL) return false;
+        array->nonces = new_nonces;
+        array->capacity = new_capacity;
     }
-    if(new_nonces == NULL) return false;
 
-    array->nonces = new_nonces;
     array->nonces[array->count].cuid = cuid;
     array->nonces[array->count].key_idx = key_idx;
     array->nonces[array->count].nt = nt;
@@ -1060,13 +1064,18 @@ static bool add_nested_nonce(
     return true;
 }
 
+// Helper function to drop collected nonces, the storage is reused by the next collection
+static void reset_nested_nonces(MfClassicNestedNonceArray* array) {
+    array->count = 0;
+}
+
 NfcCommand mf_classic_poller_handler_nested_analyze_prng(MfClassicPoller* instance) {
     NfcCommand command = NfcCommandContinue;
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
     uint8_t hard_nt_count = 0;
 
-    for(uint8_t i = 0; i < dict_attack_ctx->nested_nonce.count; i++) {
-        MfClassicNestedNonce* nonce = &dict_attack_ctx->nested_nonce.nonces[i];
+    for(uint8_t i = 0; i < instance->nested_nonce.count; i++) {
+        MfClassicNestedNonce* nonce = &instance->nested_nonce.nonces[i];
         if(!crypto1_is_weak_prng_nonce(nonce->nt)) hard_nt_count++;
     }
 
@@ -1096,7 +1105,7 @@ NfcCommand mf_classic_poller_handler_nested_collect_nt(MfClassicPoller* instance
         FURI_LOG_T(TAG, "nt: %02x%02x%02x%02x", nt.data[0], nt.data[1], nt.data[2], nt.data[3]);
         uint32_t nt_data = bit_lib_bytes_to_num_be(nt.data, sizeof(MfClassicNt));
         if(!add_nested_nonce(
-               &dict_attack_ctx->nested_nonce,
+               &instance->nested_nonce,
                iso14443_3a_get_cuid(instance->data->iso14443_3a_data),
                0,
                nt_data,
@@ -1422,8 +1431,8 @@ NfcCommand mf_classic_poller_handler_nested_collect_nt_enc(MfClassicPoller* inst
         uint16_t dist = 0;
         if(is_weak && !(dict_attack_ctx->static_encrypted)) {
             // Ensure this isn't the same nonce as the previous collection
-            if((dict_attack_ctx->nested_nonce.count == 1) &&
-               (dict_attack_ctx->nested_nonce.nonces[0].nt_enc == nt_enc)) {
+            if((instance->nested_nonce.count == 1) &&
+               (instance->nested_nonce.nonces[0].nt_enc == nt_enc)) {
                 FURI_LOG_D(TAG, "Duplicate nonce, dismissing collection attempt");
                 break;
             }
@@ -1472,7 +1481,7 @@ NfcCommand mf_classic_poller_handler_nested_collect_nt_enc(MfClassicPoller* inst
 
         // Add the nonce to the array
         if(add_nested_nonce(
-               &dict_attack_ctx->nested_nonce,
+               &instance->nested_nonce,
                cuid,
                dict_attack_ctx->nested_target_key,
                found_nt,
@@ -1510,6 +1519,35 @@ NfcCommand mf_classic_poller_handler_nested_collect_nt_enc(MfClassicPoller* inst
     return command;
 }
 
+// Check a batch of dictionary keys against all collected nonces offline, in parallel
+static bool search_keys_batch_for_nonce_key(
+    const MfClassicKey* keys,
+    size_t keys_count,
+    MfClassicNestedNonceArray* nonce_array,
+    bool is_weak,
+    MfClassicKey* found_key) {
+    Crypto1Bitsliced crypto_batch;
+    crypto1_bitsliced_init(&crypto_batch, keys, keys_count);
+
+    uint32_t lanes = (keys_count == CRYPTO1_BITSLICED_LANES) ? CRYPTO1_BITSLICED_LANES_ALL :
+                                                               ((1U << keys_count) - 1);
+    for(size_t i = 0; (i < nonce_array->count) && lanes; i++) {
+        // Verify nonce matches encrypted parity bits for all nonces
+        lanes = crypto1_bitsliced_check_nt_enc(
+            &crypto_batch,
+            lanes,
+            nonce_array->nonces[i].cuid,
+            nonce_array->nonces[i].nt_enc,
+            nonce_array->nonces[i].par,
+            is_weak);
+    }
+    if(lanes == 0) return false;
+
+    // Keep dictionary order: the first surviving key is tried first
+    *found_key = keys[__builtin_ctz(lanes)];
+    return true;
+}
+
 static MfClassicKey* search_dicts_for_nonce_key(
     MfClassicPollerDictAttackContext* dict_attack_ctx,
     MfClassicNestedNonceArray* nonce_array,
@@ -1517,11 +1555,14 @@ static MfClassicKey* search_dicts_for_nonce_key(
     KeysDict* user_dict,
     bool is_weak) {
     MfClassicKey stack_key;
+    MfClassicKey keys_batch[CRYPTO1_BITSLICED_LANES];
+    size_t keys_batch_count = 0;
     KeysDict* dicts[] = {user_dict, system_dict};
     bool is_resumed = dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttackResume;
     bool found_resume_point = false;
+    bool full_match = false;
 
-    for(int i = 0; i < 2; i++) {
+    for(int i = 0; (i < 2) && !full_match; i++) {
         if(!dicts[i]) continue;
         keys_dict_rewind(dicts[i]);
         while(keys_dict_get_next_key(dicts[i], stack_key.data, sizeof(MfClassicKey))) {
@@ -1533,29 +1574,26 @@ static MfClassicKey* search_dicts_for_nonce_key(
                          sizeof(MfClassicKey)) == 0);
                 continue;
             }
-            bool full_match = true;
-            for(uint8_t j = 0; j < nonce_array->count; j++) {
-                // Verify nonce matches encrypted parity bits for all nonces
-                uint32_t nt_enc_plain = crypto1_decrypt_nt_enc(
-                    nonce_array->nonces[j].cuid, nonce_array->nonces[j].nt_enc, stack_key);
-                if(is_weak) {
-                    full_match &= crypto1_is_weak_prng_nonce(nt_enc_plain);
-                    if(!full_match) break;
-                }
-                full_match &= crypto1_nonce_matches_encrypted_parity_bits(
-                    nt_enc_plain,
-                    nt_enc_plain ^ nonce_array->nonces[j].nt_enc,
-                    nonce_array->nonces[j].par);
-                if(!full_match) break;
-            }
-            if(full_match) {
-                MfClassicKey* new_candidate = malloc(sizeof(MfClassicKey));
-                if(new_candidate == NULL) return NULL; // malloc failed
-                memcpy(new_candidate, &stack_key, sizeof(MfClassicKey));
-                return new_candidate;
-            }
+            keys_batch[keys_batch_count++] = stack_key;
+            if(keys_batch_count < CRYPTO1_BITSLICED_LANES) continue;
+
+            full_match = search_keys_batch_for_nonce_key(
+                keys_batch, keys_batch_count, nonce_array, is_weak, &stack_key);
+            keys_batch_count = 0;
+            if(full_match) break;
         }
     }
+    if(!full_match && (keys_batch_count > 0)) {
+        full_match = search_keys_batch_for_nonce_key(
+            keys_batch, keys_batch_count, nonce_array, is_weak, &stack_key);
+    }
+
+    if(full_match) {
+        MfClassicKey* new_candidate = malloc(sizeof(MfClassicKey));
+        if(new_candidate == NULL) return NULL; // malloc failed
+        memcpy(new_candidate, &stack_key, sizeof(MfClassicKey));
+        return new_candidate;
+    }
 
     return NULL;
 }
@@ -1587,8 +1625,8 @@ NfcCommand mf_classic_poller_handler_nested_dict_attack(MfClassicPoller* instanc
         uint8_t target_block = mf_classic_get_sector_trailer_num_by_sector(target_sector);
         uint8_t parity = 0;
 
-        if(((is_weak) && (dict_attack_ctx->nested_nonce.count == 0)) ||
-           ((!is_weak) && (dict_attack_ctx->nested_nonce.count < 8))) {
+        if(((is_weak) && (instance->nested_nonce.count == 0)) ||
+           ((!is_weak) && (instance->nested_nonce.count < 8))) {
             // Step 1: Perform full authentication once
             error = mf_classic_poller_auth(
                 instance,
@@ -1630,7 +1668,7 @@ NfcCommand mf_classic_poller_handler_nested_dict_attack(MfClassicPoller* instanc
             }
 
             bool success = add_nested_nonce(
-                &dict_attack_ctx->nested_nonce,
+                &instance->nested_nonce,
                 cuid,
                 dict_attack_ctx->nested_target_key,
                 0,
@@ -1646,12 +1684,12 @@ NfcCommand mf_classic_poller_handler_nested_dict_attack(MfClassicPoller* instanc
             dict_attack_ctx->auth_passed = true;
         }
         // If we have sufficient nonces, search the dictionaries for the key
-        if((is_weak && (dict_attack_ctx->nested_nonce.count == 1)) ||
-           (is_last_iter_for_hard_key && (dict_attack_ctx->nested_nonce.count == 8))) {
+        if((is_weak && (instance->nested_nonce.count == 1)) ||
+           (is_last_iter_for_hard_key && (instance->nested_nonce.count == 8))) {
             // Identify key candidates
             MfClassicKey* key_candidate = search_dicts_for_nonce_key(
                 dict_attack_ctx,
-                &dict_attack_ctx->nested_nonce,
+                &instance->nested_nonce,
                 dict_attack_ctx->mf_classic_system_dict,
                 dict_attack_ctx->mf_classic_user_dict,
                 is_weak);
@@ -1666,9 +1704,7 @@ NfcCommand mf_classic_poller_handler_nested_dict_attack(MfClassicPoller* instanc
                 free(key_candidate);
                 break;
             } else {
-                free(dict_attack_ctx->nested_nonce.nonces);
-                dict_attack_ctx->nested_nonce.nonces = NULL;
-                dict_attack_ctx->nested_nonce.count = 0;
+                reset_nested_nonces(&instance->nested_nonce);
             }
         }
 
@@ -1687,11 +1723,7 @@ NfcCommand mf_classic_poller_handler_nested_dict_attack(MfClassicPoller* instanc
     return command;
 }
 
-NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
-    furi_assert(instance->mode_ctx.dict_attack_ctx.nested_nonce.count > 0);
-    furi_assert(instance->mode_ctx.dict_attack_ctx.nested_nonce.nonces);
-
-    NfcCommand command = NfcCommandContinue;
+static bool mf_classic_poller_nested_log_write(MfClassicPoller* instance) {
     bool params_saved = false;
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -1701,17 +1733,17 @@ NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
     bool static_encrypted = dict_attack_ctx->static_encrypted;
 
     do {
-        if(weak_prng && (!(static_encrypted)) && (dict_attack_ctx->nested_nonce.count != 2)) {
+        if(weak_prng && (!(static_encrypted)) && (instance->nested_nonce.count != 2)) {
             FURI_LOG_E(
                 TAG,
                 "MfClassicPollerStateNestedLog expected 2 nonces, received %zu",
-                dict_attack_ctx->nested_nonce.count);
+                instance->nested_nonce.count);
             break;
         }
 
         uint32_t nonce_pair_count = dict_attack_ctx->prng_type == MfClassicPrngTypeWeak ?
                                         1 :
-                                        dict_attack_ctx->nested_nonce.count;
+                                        instance->nested_nonce.count;
 
         if(!buffered_file_stream_open(
                stream, MF_CLASSIC_NESTED_LOGS_FILE_PATH, FSAM_WRITE, FSOM_OPEN_APPEND))
@@ -1719,7 +1751,7 @@ NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
 
         bool params_write_success = true;
         for(size_t i = 0; i < nonce_pair_count; i++) {
-            MfClassicNestedNonce* nonce = &dict_attack_ctx->nested_nonce.nonces[i];
+            MfClassicNestedNonce* nonce = &instance->nested_nonce.nonces[i];
             // TODO FL-3926: Avoid repeating logic here
             uint8_t nonce_sector = nonce->key_idx / (weak_prng ? 4 : 2);
             MfClassicKeyType nonce_key_type =
@@ -1734,7 +1766,7 @@ NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
             for(uint8_t nt_idx = 0; nt_idx < ((weak_prng && (!(static_encrypted))) ? 2 : 1);
                 nt_idx++) {
                 if(nt_idx == 1) {
-                    nonce = &dict_attack_ctx->nested_nonce.nonces[i + 1];
+                    nonce = &instance->nested_nonce.nonces[i + 1];
                 }
                 furi_string_cat_printf(
                     temp_str,
@@ -1763,18 +1795,42 @@ NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
         params_saved = true;
     } while(false);
 
-    furi_assert(params_saved);
-    free(dict_attack_ctx->nested_nonce.nonces);
-    dict_attack_ctx->nested_nonce.nonces = NULL;
-    dict_attack_ctx->nested_nonce.count = 0;
     furi_string_free(temp_str);
     buffered_file_stream_close(stream);
     stream_free(stream);
     furi_record_close(RECORD_STORAGE);
+    return params_saved;
+}
+
+NfcCommand mf_classic_poller_handler_nested_log(MfClassicPoller* instance) {
+    furi_assert(instance->nested_nonce.count > 0);
+    furi_assert(instance->nested_nonce.nonces);
+
+    NfcCommand command = NfcCommandContinue;
+    bool params_saved = mf_classic_poller_nested_log_write(instance);
+
+    furi_assert(params_saved);
+    reset_nested_nonces(&instance->nested_nonce);
     instance->state = MfClassicPollerStateNestedController;
     return command;
 }
 
+static void mf_classic_poller_nested_log_flush(MfClassicPoller* instance) {
+    if(instance->nested_nonce.count == 0) return;
+
+    // Only Hardnested nonces are logged in chunks, weak PRNG nonces are logged in complete pairs
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+    if(dict_attack_ctx->prng_type == MfClassicPrngTypeHard &&
+       dict_attack_ctx->nested_phase == MfClassicNestedPhaseCollectNtEnc) {
+        FURI_LOG_D(TAG, "Logging %zu pending nonces", instance->nested_nonce.count);
+        if(!mf_classic_poller_nested_log_write(instance)) {
+            FURI_LOG_E(TAG, "Failed to log pending nonces");
+        }
+    }
+
+    reset_nested_nonces(&instance->nested_nonce);
+}
+
 bool mf_classic_nested_is_target_key_found(MfClassicPoller* instance, bool is_dict_attack) {
     MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
     bool is_weak = dict_attack_ctx->prng_type == MfClassicPrngTypeWeak;
@@ -1844,33 +1900,21 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
     }
     // Identify PRNG type
     if(dict_attack_ctx->nested_phase == MfClassicNestedPhaseAnalyzePRNG) {
-        if(dict_attack_ctx->nested_nonce.count < MF_CLASSIC_NESTED_ANALYZE_NT_COUNT) {
+        if(instance->nested_nonce.count < MF_CLASSIC_NESTED_ANALYZE_NT_COUNT) {
             instance->state = MfClassicPollerStateNestedCollectNt;
             return command;
         } else if(
-            (dict_attack_ctx->nested_nonce.count == MF_CLASSIC_NESTED_ANALYZE_NT_COUNT) &&
+            (instance->nested_nonce.count == MF_CLASSIC_NESTED_ANALYZE_NT_COUNT) &&
             (dict_attack_ctx->prng_type == MfClassicPrngTypeUnknown)) {
             instance->state = MfClassicPollerStateNestedAnalyzePRNG;
             return command;
         } else if(dict_attack_ctx->prng_type == MfClassicPrngTypeNoTag) {
             FURI_LOG_E(TAG, "No tag detected");
-            // Free nonce array
-            // TODO FL-3926: Consider using .count here
-            if(dict_attack_ctx->nested_nonce.nonces) {
-                free(dict_attack_ctx->nested_nonce.nonces);
-                dict_attack_ctx->nested_nonce.nonces = NULL;
-                dict_attack_ctx->nested_nonce.count = 0;
-            }
+            reset_nested_nonces(&instance->nested_nonce);
             instance->state = MfClassicPollerStateFail;
             return command;
         }
-        if(dict_attack_ctx->nested_nonce.nonces) {
-            // Free nonce array
-            // TODO FL-3926: Consider using .count here
-            free(dict_attack_ctx->nested_nonce.nonces);
-            dict_attack_ctx->nested_nonce.nonces = NULL;
-            dict_attack_ctx->nested_nonce.count = 0;
-        }
+        reset_nested_nonces(&instance->nested_nonce);
         dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttack;
         initial_dict_attack_iter = true;
     }
@@ -1881,19 +1925,13 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                                        (instance->sectors_total * 16);
     if(dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttackVerify) {
         if(!(mf_classic_nested_is_target_key_found(instance, true)) &&
-           (dict_attack_ctx->nested_nonce.count > 0)) {
+           (instance->nested_nonce.count > 0)) {
             dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttackResume;
             instance->state = MfClassicPollerStateNestedDictAttack;
             return command;
         } else {
             dict_attack_ctx->auth_passed = true;
-            if(dict_attack_ctx->nested_nonce.count > 0) {
-                // Free nonce array
-                furi_assert(dict_attack_ctx->nested_nonce.nonces);
-                free(dict_attack_ctx->nested_nonce.nonces);
-                dict_attack_ctx->nested_nonce.nonces = NULL;
-                dict_attack_ctx->nested_nonce.count = 0;
-            }
+            reset_nested_nonces(&instance->nested_nonce);
             dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttack;
         }
     }
@@ -1921,8 +1959,8 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                         sizeof(MfClassicKey)) :
                     NULL;
         }
-        if((is_weak && (dict_attack_ctx->nested_nonce.count == 1)) ||
-           (is_last_iter_for_hard_key && (dict_attack_ctx->nested_nonce.count == 8))) {
+        if((is_weak && (instance->nested_nonce.count == 1)) ||
+           (is_last_iter_for_hard_key && (instance->nested_nonce.count == 8))) {
             // Key verify and reuse
             dict_attack_ctx->nested_phase = MfClassicNestedPhaseDictAttackVerify;
             dict_attack_ctx->auth_passed = false;
@@ -2001,10 +2039,14 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
     }
     // Collect and log nonces
     if(dict_attack_ctx->nested_phase == MfClassicNestedPhaseCollectNtEnc) {
-        if(((is_weak) && (dict_attack_ctx->nested_nonce.count == 2)) ||
+        if(((is_weak) && (instance->nested_nonce.count == 2)) ||
            ((is_weak) && (dict_attack_ctx->backdoor == MfClassicBackdoorAuth3) &&
-            (dict_attack_ctx->nested_nonce.count == 1)) ||
-           ((!(is_weak)) && (dict_attack_ctx->nested_nonce.count > 0))) {
+            (instance->nested_nonce.count == 1)) ||
+           ((!(is_weak)) &&
+            (instance->nested_nonce.count >= MF_CLASSIC_NESTED_HARD_LOG_CHUNK_SIZE)) ||
+           ((!(is_weak)) && (instance->nested_nonce.count > 0) &&
+            (dict_attack_ctx->msb_count == (UINT8_MAX + 1)))) {
+            // Hardnested nonces are buffered and logged in chunks
             instance->state = MfClassicPollerStateNestedLog;
             return command;
         }
@@ -2058,12 +2100,8 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                 (dict_attack_ctx->attempt_count >= MF_CLASSIC_NESTED_HARD_RETRY_MAXIMUM))) {
                 // Unpredictable, skip
                 FURI_LOG_W(TAG, "Failed to collect nonce, skipping key");
-                if(dict_attack_ctx->nested_nonce.nonces) {
-                    free(dict_attack_ctx->nested_nonce.nonces);
-                    dict_attack_ctx->nested_nonce.nonces = NULL;
-                    dict_attack_ctx->nested_nonce.count = 0;
-                }
                 if(is_weak) {
+                    reset_nested_nonces(&instance->nested_nonce);
                     dict_attack_ctx->nested_target_key += 2;
                     dict_attack_ctx->current_key_checked = false;
                 } else {
@@ -2074,6 +2112,11 @@ NfcCommand mf_classic_poller_handler_nested_controller(MfClassicPoller* instance
                     dict_attack_ctx->current_key_checked = false;
                 }
                 dict_attack_ctx->attempt_count = 0;
+                if(instance->nested_nonce.count > 0) {
+                    // Log the Hardnested nonces still buffered for the skipped key
+                    instance->state = MfClassicPollerStateNestedLog;
+                    return command;
+                }
             }
 
             FURI_LOG_D(
@@ -5,6 +5,7 @@
 #include <bit_lib/bit_lib.h>
 #include <nfc/helpers/iso14443_crc.h>
 #include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/crypto1_bitsliced.h>
 #include <stream/stream.h>
 #include <stream/buffered_file_stream.h>
 #include <toolbox/keys_dict.h>
@@ -22,6 +23,8 @@ extern "C" {
 #define MF_CLASSIC_NESTED_RETRY_MAXIMUM         (60)
 #define MF_CLASSIC_NESTED_HARD_RETRY_MAXIMUM    (3)
 #define MF_CLASSIC_NESTED_CALIBRATION_COUNT     (21)
+#define MF_CLASSIC_NESTED_NONCE_CAPACITY_MIN    (8)
+#define MF_CLASSIC_NESTED_HARD_LOG_CHUNK_SIZE   (64)
 #define MF_CLASSIC_NESTED_LOGS_FILE_NAME        ".nested.log"
 #define MF_CLASSIC_NESTED_SYSTEM_DICT_FILE_NAME "mf_classic_dict_nested.nfc"
 #define MF_CLASSIC_NESTED_USER_DICT_FILE_NAME   "mf_classic_dict_user_nested.nfc"
@@ -68,6 +71,7 @@ typedef struct {
 typedef struct {
     MfClassicNestedNonce* nonces;
     size_t count;
+    size_t capacity; // Grows geometrically, kept allocated across resets
 } MfClassicNestedNonceArray;
 
 typedef enum {
@@ -140,7 +144,6 @@ typedef struct {
     bool current_key_checked;
     uint8_t nested_known_key_sector;
     uint16_t nested_target_key;
-    MfClassicNestedNonceArray nested_nonce;
     MfClassicPrngType prng_type;
     bool static_encrypted;
     uint32_t static_encrypted_nonce;
@@ -182,6 +185,7 @@ struct MfClassicPoller {
     MfClassicType current_type_check;
     uint8_t sectors_total;
     MfClassicPollerModeContext mode_ctx;
+    MfClassicNestedNonceArray nested_nonce;
 
     Crypto1* crypto;
     BitBuffer* tx_plain_buffer;
@@ -2,6 +2,8 @@
 
 #include <bit_lib/bit_lib.h>
 #include <furi.h>
+#include <toolbox/hex.h>
+#include <toolbox/strint.h>
 
 #define MF_ULTRALIGHT_PROTOCOL_NAME "NTAG/Ultralight"
 
@@ -239,6 +241,66 @@ bool mf_ultralight_verify(MfUltralightData* data, const FuriString* device_type)
     return verified;
 }
 
+static bool mf_ultralight_get_page_num_by_key(const FuriString* key, uint32_t* page_num) {
+    const size_t prefix_len = strlen(MF_ULTRALIGHT_PAGE_KEY " ");
+    char* end = NULL;
+
+    return furi_string_start_with_str(key, MF_ULTRALIGHT_PAGE_KEY " ") &&
+           (strint_to_uint32(&furi_string_get_cstr(key)[prefix_len], &end, page_num, 10) ==
+            StrintParseNoError) &&
+           (*end == '\0');
+}
+
+static bool mf_ultralight_parse_page(const FuriString* page_str, MfUltralightPage* page) {
+    bool page_parsed = (furi_string_size(page_str) >= sizeof(MfUltralightPage) * 3 - 1);
+
+    for(size_t i = 0; page_parsed && (i < sizeof(MfUltralightPage)); i++) {
+        page_parsed = hex_char_to_uint8(
+            furi_string_get_char(page_str, 3 * i),
+            furi_string_get_char(page_str, 3 * i + 1),
+            &page->data[i]);
+    }
+
+    return page_parsed;
+}
+
+static bool
+    mf_ultralight_load_pages(MfUltralightData* data, FlipperFormat* ff, uint32_t pages_total) {
+    FuriString* key = furi_string_alloc();
+    FuriString* page_str = furi_string_alloc();
+    bool pages_loaded = true;
+    bool in_order = true;
+
+    for(uint32_t i = 0; i < pages_total; i++) {
+        bool page_found = false;
+
+        // Saved pages follow each other, so walk the file line by line instead of seeking
+        while(in_order && flipper_format_read_next_string(ff, key, page_str)) {
+            uint32_t page_num = 0;
+            if(!mf_ultralight_get_page_num_by_key(key, &page_num)) continue;
+            page_found = (page_num == i) && mf_ultralight_parse_page(page_str, &data->page[i]);
+            break;
+        }
+
+        if(!page_found) {
+            // Out of order or unusually formatted file, fall back to searching every page by key
+            in_order = false;
+            furi_string_printf(key, "%s %lu", MF_ULTRALIGHT_PAGE_KEY, i);
+            if(!flipper_format_rewind(ff) ||
+               !flipper_format_read_hex(
+                   ff, furi_string_get_cstr(key), data->page[i].data, sizeof(MfUltralightPage))) {
+                pages_loaded = false;
+                break;
+            }
+        }
+    }
+
+    furi_string_free(page_str);
+    furi_string_free(key);
+
+    return pages_loaded;
+}
+
 bool mf_ultralight_load(MfUltralightData* data, FlipperFormat* ff, uint32_t version) {
     furi_check(data);
     furi_check(ff);
@@ -311,19 +373,7 @@ bool mf_ultralight_load(MfUltralightData* data, FlipperFormat* ff, uint32_t vers
         if((pages_read > MF_ULTRALIGHT_MAX_PAGE_NUM) || (pages_total > MF_ULTRALIGHT_MAX_PAGE_NUM))
             break;
 
-        bool pages_parsed = true;
-        for(size_t i = 0; i < pages_total; i++) {
-            furi_string_printf(temp_str, "%s %d", MF_ULTRALIGHT_PAGE_KEY, i);
-            if(!flipper_format_read_hex(
-                   ff,
-                   furi_string_get_cstr(temp_str),
-                   data->page[i].data,
-                   sizeof(MfUltralightPage))) {
-                pages_parsed = false;
-                break;
-            }
-        }
-        if(!pages_parsed) break;
+        if(!mf_ultralight_load_pages(data, ff, pages_total)) break;
 
         // Read authentication counter
         if(!flipper_format_read_uint32(
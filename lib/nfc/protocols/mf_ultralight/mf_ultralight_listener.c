@@ -2,6 +2,7 @@
 #include "mf_ultralight_listener_defs.h"
 
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a_listener_i.h>
+#include <nfc/helpers/iso14443_crc.h>
 
 #include <furi.h>
 #include <furi_hal.h>
@@ -40,7 +41,7 @@ static void mf_ultralight_listener_send_short_resp(MfUltralightListener* instanc
     iso14443_3a_listener_tx(instance->iso14443_3a_listener, instance->tx_buffer);
 }
 
-static void mf_ultralight_listener_perform_read(
+static void mf_ultralight_listener_read_pages(
     MfUltralightPage* pages,
     MfUltralightListener* instance,
     uint16_t start_page,
@@ -68,9 +69,108 @@ static void mf_ultralight_listener_perform_read(
             mf_ultralight_mirror_read_handler(page, pages[i].data, instance);
         }
     }
+}
+
+static void mf_ultralight_listener_perform_read(
+    MfUltralightPage* pages,
+    MfUltralightListener* instance,
+    uint16_t start_page,
+    uint8_t page_cnt,
+    bool do_i2c_page_check) {
+    mf_ultralight_listener_read_pages(pages, instance, start_page, page_cnt, do_i2c_page_check);
     mf_ultralight_single_counter_try_increase(instance);
 }
 
+static bool mf_ultralight_listener_read_cache_usable(MfUltralightListener* instance) {
+    // Mirrored UID and counter bytes change between reads, such responses are built on demand
+    bool mirror_configured =
+        mf_ultralight_support_feature(instance->features, MfUltralightFeatureSupportAsciiMirror) &&
+        (instance->config != NULL) &&
+        (instance->config->mirror.mirror_conf != MfUltralightMirrorNone);
+
+    return (instance->read_cache.responses != NULL) && !mirror_configured;
+}
+
+static void mf_ultralight_listener_read_cache_fill(
+    MfUltralightListener* instance,
+    uint16_t start_page,
+    uint8_t* response) {
+    MfUltralightPage pages[4] = {};
+    mf_ultralight_listener_read_pages(pages, instance, start_page, 4, false);
+
+    bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
+    iso14443_crc_append(Iso14443CrcTypeA, instance->tx_buffer);
+    bit_buffer_write_bytes(instance->tx_buffer, response, MF_ULTRALIGHT_LISTENER_READ_RESP_SIZE);
+}
+
+static const uint8_t*
+    mf_ultralight_listener_read_cache_get(MfUltralightListener* instance, uint16_t start_page) {
+    MfUltralightReadCache* cache = &instance->read_cache;
+    const uint8_t* response = NULL;
+
+    do {
+        if(!mf_ultralight_listener_read_cache_usable(instance)) break;
+        if(start_page >= instance->data->pages_total) break;
+
+        // Access checks and page rollover depend on the authentication state
+        if(cache->auth_state != instance->auth_state) {
+            memset(cache->valid, 0, sizeof(cache->valid));
+            cache->auth_state = instance->auth_state;
+        }
+
+        uint8_t* entry = &cache->responses[start_page * MF_ULTRALIGHT_LISTENER_READ_RESP_SIZE];
+        if(!FURI_BIT(cache->valid[start_page / 32], start_page % 32)) {
+            mf_ultralight_listener_read_cache_fill(instance, start_page, entry);
+            FURI_BIT_SET(cache->valid[start_page / 32], start_page % 32);
+        }
+        response = entry;
+    } while(false);
+
+    return response;
+}
+
+static void
+    mf_ultralight_listener_read_cache_invalidate(MfUltralightListener* instance, uint16_t page) {
+    MfUltralightReadCache* cache = &instance->read_cache;
+    uint16_t pages_total = instance->data->pages_total;
+    uint16_t config_page = mf_ultralight_get_config_page_num(instance->data->type);
+
+    // Pages 0-3 are returned in place of restricted pages, config pages change access rights
+    bool affects_all = (page < 4) || ((config_page != 0) && (page >= config_page)) ||
+                       (mf_ultralight_support_feature(
+                            instance->features, MfUltralightFeatureSupportAuthenticate) &&
+                        (page >= 42));
+
+    if(affects_all) {
+        memset(cache->valid, 0, sizeof(cache->valid));
+    } else {
+        // A page is part of the responses to READ of itself and 3 preceding pages
+        for(uint16_t i = 0; i < 4; i++) {
+            uint16_t start_page = (page + pages_total - i) % pages_total;
+            FURI_BIT_CLEAR(cache->valid[start_page / 32], start_page % 32);
+        }
+    }
+}
+
+static void mf_ultralight_listener_read_cache_alloc(MfUltralightListener* instance) {
+    MfUltralightReadCache* cache = &instance->read_cache;
+    uint16_t pages_total = instance->data->pages_total;
+
+    // I2C tags map requested pages through sectors, they keep the generic read path
+    if(!mf_ultralight_is_i2c_tag(instance->data->type) && (pages_total > 0)) {
+        cache->responses = malloc(pages_total * MF_ULTRALIGHT_LISTENER_READ_RESP_SIZE);
+        cache->auth_state = instance->auth_state;
+
+        for(uint16_t page = 0; page < pages_total; page++) {
+            if(!mf_ultralight_listener_check_access(
+                   instance, page, MfUltralightListenerAccessTypeRead)) {
+                continue;
+            }
+            if(mf_ultralight_listener_read_cache_get(instance, page) == NULL) break;
+        }
+    }
+}
+
 static MfUltralightCommand mf_ultralight_listener_perform_write(
     MfUltralightListener* instance,
     const uint8_t* const rx_data,
@@ -93,6 +193,10 @@ static MfUltralightCommand mf_ultralight_listener_perform_write(
         memcpy(instance->data->page[page].data, rx_data, sizeof(MfUltralightPage));
     }
 
+    if(command == MfUltralightCommandProcessedACK && instance->read_cache.responses) {
+        mf_ultralight_listener_read_cache_invalidate(instance, start_page);
+    }
+
     return command;
 }
 
@@ -118,12 +222,20 @@ static MfUltralightCommand
             break;
         }
 
-        MfUltralightPage pages[4] = {};
-        mf_ultralight_listener_perform_read(pages, instance, start_page, 4, do_i2c_check);
+        const uint8_t* response = mf_ultralight_listener_read_cache_get(instance, start_page);
+        if(response) {
+            bit_buffer_copy_bytes(
+                instance->tx_buffer, response, MF_ULTRALIGHT_LISTENER_READ_RESP_SIZE);
+            iso14443_3a_listener_tx(instance->iso14443_3a_listener, instance->tx_buffer);
+            mf_ultralight_single_counter_try_increase(instance);
+        } else {
+            MfUltralightPage pages[4] = {};
+            mf_ultralight_listener_perform_read(pages, instance, start_page, 4, do_i2c_check);
 
-        bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
-        iso14443_3a_listener_send_standard_frame(
-            instance->iso14443_3a_listener, instance->tx_buffer);
+            bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
+            iso14443_3a_listener_send_standard_frame(
+                instance->iso14443_3a_listener, instance->tx_buffer);
+        }
         command = MfUltralightCommandProcessed;
 
     } while(false);
@@ -750,6 +862,7 @@ MfUltralightListener* mf_ultralight_listener_alloc(
     mf_ultralight_composite_command_reset(instance);
     instance->sector = 0;
     instance->tx_buffer = bit_buffer_alloc(MF_ULTRALIGHT_LISTENER_MAX_TX_BUFF_SIZE);
+    mf_ultralight_listener_read_cache_alloc(instance);
 
     instance->mfu_event.data = &instance->mfu_event_data;
     instance->generic_event.protocol = NfcProtocolMfUltralight;
@@ -765,6 +878,7 @@ void mf_ultralight_listener_free(MfUltralightListener* instance) {
     furi_assert(instance->data);
     furi_assert(instance->tx_buffer);
 
+    if(instance->read_cache.responses) free(instance->read_cache.responses);
     bit_buffer_free(instance->tx_buffer);
     furi_string_free(instance->mirror.ascii_mirror_data);
     mbedtls_des3_free(&instance->des_context);
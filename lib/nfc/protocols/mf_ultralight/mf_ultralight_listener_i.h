@@ -50,6 +50,14 @@ typedef struct {
 typedef uint16_t MfUltralightStaticLockData;
 typedef uint32_t MfUltralightDynamicLockData;
 
+#define MF_ULTRALIGHT_LISTENER_READ_RESP_SIZE (4 * sizeof(MfUltralightPage) + 2)
+
+typedef struct {
+    uint8_t* responses; // Ready-to-send READ response with CRC for every start page
+    uint32_t valid[(MF_ULTRALIGHT_MAX_PAGE_NUM + 31) / 32];
+    MfUltralightListenerAuthState auth_state;
+} MfUltralightReadCache;
+
 struct MfUltralightListener {
     Iso14443_3aListener* iso14443_3a_listener;
     MfUltralightListenerAuthState auth_state;
@@ -67,6 +75,7 @@ struct MfUltralightListener {
     uint8_t sector;
     bool single_counter_increased;
     MfUltralightMirrorMode mirror;
+    MfUltralightReadCache read_cache;
     MfUltralightListenerCompositeCommandContext composite_cmd;
     mbedtls_des3_context des_context;
     uint8_t rndB[MF_ULTRALIGHT_C_AUTH_RND_BLOCK_SIZE];
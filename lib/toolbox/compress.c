@@ -493,6 +493,12 @@ static bool compress_decode_stream_chunk(
             can_read_more = read_size > 0;
         }
 
+        /* Input is exhausted and decoder has nothing left to output */
+        if(!can_read_more && !sd->decode_buffer_position) {
+            failed = true;
+            break;
+        }
+
         while(sd->decode_buffer_position && can_sink_more) {
             size_t sink_size = 0;
             sink_res = heatshrink_decoder_sink(
@@ -571,3 +577,496 @@ bool compress_stream_decoder_rewind(CompressStreamDecoder* instance) {
 
     return true;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct CompressStreamEncoder {
+    heatshrink_encoder* encoder;
+    size_t encode_buffer_size;
+    uint8_t* encode_buffer;
+    CompressIoCallback write_cb;
+    void* write_context;
+};
+
+CompressStreamEncoder* compress_stream_encoder_alloc(
+    CompressType type,
+    const void* config,
+    CompressIoCallback write_cb,
+    void* write_context) {
+    furi_check(type == CompressTypeHeatshrink);
+    furi_check(config);
+    furi_check(write_cb);
+
+    const CompressConfigHeatshrink* hs_config = (const CompressConfigHeatshrink*)config;
+    CompressStreamEncoder* instance = malloc(sizeof(CompressStreamEncoder));
+    instance->encoder = heatshrink_encoder_alloc(hs_config->window_sz2, hs_config->lookahead_sz2);
+    instance->encode_buffer_size = hs_config->input_buffer_sz;
+    instance->encode_buffer = malloc(hs_config->input_buffer_sz);
+    instance->write_cb = write_cb;
+    instance->write_context = write_context;
+
+    return instance;
+}
+
+void compress_stream_encoder_free(CompressStreamEncoder* instance) {
+    furi_check(instance);
+    heatshrink_encoder_free(instance->encoder);
+    free(instance->encode_buffer);
+    free(instance);
+}
+
+static bool compress_stream_encoder_drain(CompressStreamEncoder* instance) {
+    HSE_poll_res poll_res;
+
+    do {
+        size_t poll_size = 0;
+        poll_res = heatshrink_encoder_poll(
+            instance->encoder, instance->encode_buffer, instance->encode_buffer_size, &poll_size);
+        if(poll_res < 0) {
+            return false;
+        }
+
+        if(poll_size &&
+           instance->write_cb(instance->write_context, instance->encode_buffer, poll_size) !=
+               (int32_t)poll_size) {
+            return false;
+        }
+    } while(poll_res == HSER_POLL_MORE);
+
+    return true;
+}
+
+bool compress_stream_encoder_write(
+    CompressStreamEncoder* instance,
+    const uint8_t* data_in,
+    size_t data_in_size) {
+    furi_check(instance);
+    furi_check(data_in || !data_in_size);
+
+    while(data_in_size) {
+        size_t sink_size = 0;
+        HSE_sink_res sink_res = heatshrink_encoder_sink(
+            instance->encoder, (uint8_t*)data_in, data_in_size, &sink_size);
+        if(sink_res != HSER_SINK_OK) {
+            return false;
+        }
+        data_in += sink_size;
+        data_in_size -= sink_size;
+
+        if(!compress_stream_encoder_drain(instance)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool compress_stream_encoder_finish(CompressStreamEncoder* instance) {
+    furi_check(instance);
+
+    bool success = true;
+    HSE_finish_res finish_res;
+
+    do {
+        finish_res = heatshrink_encoder_finish(instance->encoder);
+        if(finish_res < 0 || !compress_stream_encoder_drain(instance)) {
+            success = false;
+            break;
+        }
+    } while(finish_res != HSER_FINISH_DONE);
+
+    heatshrink_encoder_reset(instance->encoder);
+
+    return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/* HSBK 'heatshrink blocks' container magic */
+#define COMPRESS_BLOCK_MAGIC   (0x4B425348UL)
+#define COMPRESS_BLOCK_VERSION (1u)
+
+/** Defines decoder input buffer size for block containers */
+#define COMPRESS_BLOCK_INPUT_BUFF_SIZE (512u)
+
+#define COMPRESS_BLOCK_NONE (SIZE_MAX)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t window_sz2;
+    uint8_t lookahead_sz2;
+    uint8_t reserved;
+    uint32_t block_size;
+    uint32_t data_size;
+    uint32_t index_offset; // Index of block offsets, one uint32_t per block, follows the blocks
+} FURI_PACKED CompressBlockHeader;
+
+_Static_assert(sizeof(CompressBlockHeader) == 20, "Incorrect CompressBlockHeader size");
+
+struct CompressBlockEncoder {
+    CompressStreamEncoder* encoder;
+    CompressBlockHeader header;
+    size_t block_fill;
+    size_t output_position;
+    uint32_t* index;
+    size_t index_count;
+    size_t index_capacity;
+    bool is_started;
+    CompressIoCallback write_cb;
+    CompressSeekCallback seek_cb;
+    void* context;
+};
+
+static int32_t compress_block_encoder_output(void* context, uint8_t* buffer, size_t size) {
+    CompressBlockEncoder* instance = context;
+    int32_t written = instance->write_cb(instance->context, buffer, size);
+    if(written > 0) {
+        instance->output_position += written;
+    }
+    return written;
+}
+
+CompressBlockEncoder* compress_block_encoder_alloc(
+    CompressType type,
+    const void* config,
+    size_t block_size,
+    CompressIoCallback write_cb,
+    CompressSeekCallback seek_cb,
+    void* context) {
+    furi_check(type == CompressTypeHeatshrink);
+    furi_check(config);
+    furi_check(block_size);
+    furi_check(write_cb);
+    furi_check(seek_cb);
+
+    const CompressConfigHeatshrink* hs_config = (const CompressConfigHeatshrink*)config;
+    CompressBlockEncoder* instance = malloc(sizeof(CompressBlockEncoder));
+    instance->encoder = compress_stream_encoder_alloc(
+        type, config, compress_block_encoder_output, instance);
+    instance->header.magic = COMPRESS_BLOCK_MAGIC;
+    instance->header.version = COMPRESS_BLOCK_VERSION;
+    instance->header.window_sz2 = hs_config->window_sz2;
+    instance->header.lookahead_sz2 = hs_config->lookahead_sz2;
+    instance->header.block_size = block_size;
+    instance->write_cb = write_cb;
+    instance->seek_cb = seek_cb;
+    instance->context = context;
+
+    return instance;
+}
+
+void compress_block_encoder_free(CompressBlockEncoder* instance) {
+    furi_check(instance);
+    compress_stream_encoder_free(instance->encoder);
+    free(instance->index);
+    free(instance);
+}
+
+static bool compress_block_encoder_start(CompressBlockEncoder* instance) {
+    if(instance->is_started) return true;
+    instance->is_started = true;
+
+    /* Header is rewritten with actual sizes once the index is in place */
+    return compress_block_encoder_output(
+               instance, (uint8_t*)&instance->header, sizeof(CompressBlockHeader)) ==
+           (int32_t)sizeof(CompressBlockHeader);
+}
+
+bool compress_block_encoder_write(
+    CompressBlockEncoder* instance,
+    const uint8_t* data_in,
+    size_t data_in_size) {
+    furi_check(instance);
+    furi_check(data_in || !data_in_size);
+
+    if(!compress_block_encoder_start(instance)) {
+        return false;
+    }
+
+    while(data_in_size) {
+        if(instance->block_fill == 0) {
+            if(instance->index_count == instance->index_capacity) {
+                instance->index_capacity =
+                    instance->index_capacity ? instance->index_capacity * 2 : 16;
+                instance->index = realloc( //-V701
+                    instance->index,
+                    instance->index_capacity * sizeof(uint32_t));
+            }
+            instance->index[instance->index_count++] = instance->output_position;
+        }
+
+        size_t chunk_size = instance->header.block_size - instance->block_fill;
+        if(chunk_size > data_in_size) {
+            chunk_size = data_in_size;
+        }
+
+        if(!compress_stream_encoder_write(instance->encoder, data_in, chunk_size)) {
+            return false;
+        }
+        data_in += chunk_size;
+        data_in_size -= chunk_size;
+        instance->block_fill += chunk_size;
+        instance->header.data_size += chunk_size;
+
+        /* Each block is a complete heatshrink stream, decodable on its own */
+        if(instance->block_fill == instance->header.block_size) {
+            instance->block_fill = 0;
+            if(!compress_stream_encoder_finish(instance->encoder)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool compress_block_encoder_finish(CompressBlockEncoder* instance) {
+    furi_check(instance);
+
+    if(!compress_block_encoder_start(instance)) {
+        return false;
+    }
+
+    if(instance->block_fill) {
+        instance->block_fill = 0;
+        if(!compress_stream_encoder_finish(instance->encoder)) {
+            return false;
+        }
+    }
+
+    instance->header.index_offset = instance->output_position;
+    size_t index_size = instance->index_count * sizeof(uint32_t);
+    if(index_size && compress_block_encoder_output(
+                         instance, (uint8_t*)instance->index, index_size) != (int32_t)index_size) {
+        return false;
+    }
+
+    return instance->seek_cb(instance->context, 0) &&
+           instance->write_cb(
+               instance->context, (uint8_t*)&instance->header, sizeof(CompressBlockHeader)) ==
+               (int32_t)sizeof(CompressBlockHeader);
+}
+
+struct CompressBlockDecoder {
+    CompressConfigHeatshrink config;
+    CompressStreamDecoder* decoder;
+    CompressBlockHeader header;
+    uint32_t* index;
+    size_t block_count;
+    size_t block; // Block the decoder is positioned in
+    size_t input_remaining; // Compressed bytes of the block not yet passed to the decoder
+    size_t position;
+    CompressIoCallback read_cb;
+    CompressSeekCallback seek_cb;
+    void* context;
+};
+
+/* Keeps the stream decoder from reading into the next block */
+static int32_t compress_block_decoder_input(void* context, uint8_t* buffer, size_t size) {
+    CompressBlockDecoder* instance = context;
+
+    if(size > instance->input_remaining) {
+        size = instance->input_remaining;
+    }
+    if(size == 0) {
+        return 0;
+    }
+
+    int32_t read_size = instance->read_cb(instance->context, buffer, size);
+    if(read_size > 0) {
+        instance->input_remaining -= read_size;
+    }
+    return read_size;
+}
+
+CompressBlockDecoder* compress_block_decoder_alloc(
+    CompressIoCallback read_cb,
+    CompressSeekCallback seek_cb,
+    void* context) {
+    furi_check(read_cb);
+    furi_check(seek_cb);
+
+    CompressBlockDecoder* instance = malloc(sizeof(CompressBlockDecoder));
+    instance->block = COMPRESS_BLOCK_NONE;
+    instance->read_cb = read_cb;
+    instance->seek_cb = seek_cb;
+    instance->context = context;
+
+    return instance;
+}
+
+void compress_block_decoder_free(CompressBlockDecoder* instance) {
+    furi_check(instance);
+    if(instance->decoder) {
+        compress_stream_decoder_free(instance->decoder);
+    }
+    free(instance->index);
+    free(instance);
+}
+
+bool compress_block_decoder_open(CompressBlockDecoder* instance, size_t input_size) {
+    furi_check(instance);
+    furi_check(instance->decoder == NULL);
+
+    CompressBlockHeader* header = &instance->header;
+    bool success = false;
+
+    do {
+        if(!instance->seek_cb(instance->context, 0)) break;
+        if(instance->read_cb(instance->context, (uint8_t*)header, sizeof(CompressBlockHeader)) !=
+           (int32_t)sizeof(CompressBlockHeader))
+            break;
+        if(header->magic != COMPRESS_BLOCK_MAGIC || header->version != COMPRESS_BLOCK_VERSION)
+            break;
+        if(header->block_size == 0 || header->index_offset < sizeof(CompressBlockHeader) ||
+           header->index_offset > input_size)
+            break;
+
+        // Rounded up without data_size + block_size - 1, which may overflow
+        instance->block_count = header->data_size / header->block_size +
+                                (header->data_size % header->block_size ? 1 : 0);
+        // Index must fit in the input, before anything is allocated for it
+        if(instance->block_count > (input_size - header->index_offset) / sizeof(uint32_t)) {
+            instance->block_count = 0;
+            break;
+        }
+        size_t index_size = instance->block_count * sizeof(uint32_t);
+        if(index_size) {
+            instance->index = malloc(index_size);
+            if(!instance->seek_cb(instance->context, header->index_offset)) break;
+            if(instance->read_cb(instance->context, (uint8_t*)instance->index, index_size) !=
+               (int32_t)index_size)
+                break;
+        }
+
+        size_t block = 0;
+        for(; block < instance->block_count; block++) {
+            uint32_t block_end = (block + 1 < instance->block_count) ? instance->index[block + 1] :
+                                                                       header->index_offset;
+            if(instance->index[block] < sizeof(CompressBlockHeader) ||
+               instance->index[block] > block_end)
+                break;
+        }
+        if(block != instance->block_count) break;
+
+        success = true;
+    } while(false);
+
+    if(success) {
+        instance->config.window_sz2 = header->window_sz2;
+        instance->config.lookahead_sz2 = header->lookahead_sz2;
+        instance->config.input_buffer_sz = COMPRESS_BLOCK_INPUT_BUFF_SIZE;
+        instance->decoder = compress_stream_decoder_alloc(
+            CompressTypeHeatshrink,
+            &instance->config,
+            compress_block_decoder_input,
+            instance);
+    } else {
+        FURI_LOG_E(TAG, "Invalid block container");
+        free(instance->index);
+        instance->index = NULL;
+        instance->block_count = 0;
+        memset(header, 0, sizeof(CompressBlockHeader));
+    }
+
+    return success;
+}
+
+static bool compress_block_decoder_load(CompressBlockDecoder* instance, size_t block) {
+    uint32_t block_end = (block + 1 < instance->block_count) ? instance->index[block + 1] :
+                                                               instance->header.index_offset;
+
+    instance->block = COMPRESS_BLOCK_NONE;
+    if(!instance->seek_cb(instance->context, instance->index[block])) {
+        return false;
+    }
+    instance->input_remaining = block_end - instance->index[block];
+    compress_stream_decoder_rewind(instance->decoder);
+    instance->block = block;
+
+    return true;
+}
+
+bool compress_block_decoder_seek(CompressBlockDecoder* instance, size_t position) {
+    furi_check(instance);
+
+    if(instance->decoder == NULL || position > instance->header.data_size) {
+        return false;
+    }
+
+    size_t block = position / instance->header.block_size;
+    size_t block_position = position - block * instance->header.block_size;
+    instance->position = position;
+
+    if(block >= instance->block_count) {
+        return true;
+    }
+
+    /* Moving forward within the current block continues decoding, anything else starts over */
+    if(block != instance->block ||
+       block_position < compress_stream_decoder_tell(instance->decoder)) {
+        if(!compress_block_decoder_load(instance, block)) {
+            return false;
+        }
+    }
+
+    if(!compress_stream_decoder_seek(instance->decoder, block_position)) {
+        instance->block = COMPRESS_BLOCK_NONE;
+        return false;
+    }
+
+    return true;
+}
+
+bool compress_block_decoder_read(
+    CompressBlockDecoder* instance,
+    uint8_t* data_out,
+    size_t data_out_size) {
+    furi_check(instance);
+    furi_check(data_out || !data_out_size);
+
+    if(instance->decoder == NULL ||
+       data_out_size > instance->header.data_size - instance->position) {
+        return false;
+    }
+
+    while(data_out_size) {
+        size_t block = instance->position / instance->header.block_size;
+        size_t block_start = block * instance->header.block_size;
+
+        if(block != instance->block) {
+            size_t block_position = instance->position - block_start;
+            if(!compress_block_decoder_load(instance, block) ||
+               !compress_stream_decoder_seek(instance->decoder, block_position)) {
+                instance->block = COMPRESS_BLOCK_NONE;
+                return false;
+            }
+        }
+
+        size_t chunk_size = block_start + instance->header.block_size - instance->position;
+        if(chunk_size > data_out_size) {
+            chunk_size = data_out_size;
+        }
+
+        if(!compress_stream_decoder_read(instance->decoder, data_out, chunk_size)) {
+            instance->block = COMPRESS_BLOCK_NONE;
+            return false;
+        }
+        data_out += chunk_size;
+        data_out_size -= chunk_size;
+        instance->position += chunk_size;
+    }
+
+    return true;
+}
+
+size_t compress_block_decoder_tell(CompressBlockDecoder* instance) {
+    furi_check(instance);
+    return instance->position;
+}
+
+size_t compress_block_decoder_size(CompressBlockDecoder* instance) {
+    furi_check(instance);
+    return instance->header.data_size;
+}
@@ -214,6 +214,189 @@ size_t compress_stream_decoder_tell(CompressStreamDecoder* instance);
  */
 bool compress_stream_decoder_rewind(CompressStreamDecoder* instance);
 
+//////////////////////////////////////////////////////////////////////////
+
+/** CompressStreamEncoder control structure */
+typedef struct CompressStreamEncoder CompressStreamEncoder;
+
+/** Allocate stream encoder
+ *
+ * @param      type           Compression type
+ * @param[in]  config         Configuration for compression, specific to type
+ * @param      write_cb       The write callback for output (compressed) data
+ * @param      write_context  The write context
+ *
+ * @return     CompressStreamEncoder instance
+ */
+CompressStreamEncoder* compress_stream_encoder_alloc(
+    CompressType type,
+    const void* config,
+    CompressIoCallback write_cb,
+    void* write_context);
+
+/** Free stream encoder
+ *
+ * @param      instance  The CompressStreamEncoder instance
+ */
+void compress_stream_encoder_free(CompressStreamEncoder* instance);
+
+/** Compress data chunk and pass the output to the write callback
+ *
+ * @param      instance      The CompressStreamEncoder instance
+ * @param      data_in       The data in
+ * @param[in]  data_in_size  The data in size
+ *
+ * @note       Does not produce a header, just compressed data stream.
+ * @return     true on success
+ */
+bool compress_stream_encoder_write(
+    CompressStreamEncoder* instance,
+    const uint8_t* data_in,
+    size_t data_in_size);
+
+/** Flush the rest of compressed data to the write callback and reset the encoder
+ *
+ * @param      instance  The CompressStreamEncoder instance
+ *
+ * @return     true on success
+ */
+bool compress_stream_encoder_finish(CompressStreamEncoder* instance);
+
+//////////////////////////////////////////////////////////////////////////
+
+/** Seek callback for block compressed containers
+ *
+ * @param context   user context
+ * @param position  absolute position in the container
+ *
+ * @return true on success
+ */
+typedef bool (*CompressSeekCallback)(void* context, size_t position);
+
+/** CompressBlockEncoder control structure
+ *
+ * Produces a container of independently compressed blocks followed by a block
+ * index, so that CompressBlockDecoder can seek anywhere by decoding at most one
+ * block.
+ */
+typedef struct CompressBlockEncoder CompressBlockEncoder;
+
+/** Allocate block encoder
+ *
+ * @param      type        Compression type
+ * @param[in]  config      Configuration for compression, specific to type
+ * @param[in]  block_size  Size of uncompressed data in each block
+ * @param      write_cb    The write callback for output (container) data
+ * @param      seek_cb     The seek callback for output, used to write the
+ *                         header once the index is known
+ * @param      context     The write and seek context
+ *
+ * @return     CompressBlockEncoder instance
+ */
+CompressBlockEncoder* compress_block_encoder_alloc(
+    CompressType type,
+    const void* config,
+    size_t block_size,
+    CompressIoCallback write_cb,
+    CompressSeekCallback seek_cb,
+    void* context);
+
+/** Free block encoder
+ *
+ * @param      instance  The CompressBlockEncoder instance
+ */
+void compress_block_encoder_free(CompressBlockEncoder* instance);
+
+/** Compress data chunk into the container
+ *
+ * @param      instance      The CompressBlockEncoder instance
+ * @param      data_in       The data in
+ * @param[in]  data_in_size  The data in size
+ *
+ * @return     true on success
+ */
+bool compress_block_encoder_write(
+    CompressBlockEncoder* instance,
+    const uint8_t* data_in,
+    size_t data_in_size);
+
+/** Flush the last block, write the block index and the container header
+ *
+ * @param      instance  The CompressBlockEncoder instance
+ *
+ * @return     true on success
+ */
+bool compress_block_encoder_finish(CompressBlockEncoder* instance);
+
+/** CompressBlockDecoder control structure */
+typedef struct CompressBlockDecoder CompressBlockDecoder;
+
+/** Allocate block decoder
+ *
+ * @param      read_cb  The read callback for input (container) data
+ * @param      seek_cb  The seek callback for input
+ * @param      context  The read and seek context
+ *
+ * @return     CompressBlockDecoder instance
+ */
+CompressBlockDecoder* compress_block_decoder_alloc(
+    CompressIoCallback read_cb,
+    CompressSeekCallback seek_cb,
+    void* context);
+
+/** Free block decoder
+ *
+ * @param      instance  The CompressBlockDecoder instance
+ */
+void compress_block_decoder_free(CompressBlockDecoder* instance);
+
+/** Read container header and block index
+ *
+ * @param      instance    The CompressBlockDecoder instance
+ * @param[in]  input_size  The container size, header fields are checked against it
+ *
+ * @return     true on success, false if input is not a valid container
+ */
+bool compress_block_decoder_open(CompressBlockDecoder* instance, size_t input_size);
+
+/** Read uncompressed data chunk from block decoder
+ *
+ * @param      instance       The CompressBlockDecoder instance
+ * @param      data_out       The data out
+ * @param[in]  data_out_size  The data out size
+ *
+ * @return     true on success, false on error or if there is not enough data
+ */
+bool compress_block_decoder_read(
+    CompressBlockDecoder* instance,
+    uint8_t* data_out,
+    size_t data_out_size);
+
+/** Seek to position in uncompressed data, both ways
+ *
+ * @param      instance  The CompressBlockDecoder instance
+ * @param[in]  position  The position
+ *
+ * @return     true on success
+ */
+bool compress_block_decoder_seek(CompressBlockDecoder* instance, size_t position);
+
+/** Get current position in uncompressed data
+ *
+ * @param      instance  The CompressBlockDecoder instance
+ *
+ * @return     current position
+ */
+size_t compress_block_decoder_tell(CompressBlockDecoder* instance);
+
+/** Get size of uncompressed data
+ *
+ * @param      instance  The CompressBlockDecoder instance
+ *
+ * @return     uncompressed data size, 0 if container is not open
+ */
+size_t compress_block_decoder_size(CompressBlockDecoder* instance);
+
 #ifdef __cplusplus
 }
 #endif
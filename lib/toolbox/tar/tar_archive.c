@@ -14,6 +14,13 @@
 #define FILE_OPEN_NTRIES      10
 #define FILE_OPEN_RETRY_DELAY 25
 
+/* Compressed archives are read from SD in larger chunks than tar blocks */
+#define HEATSHRINK_READ_BUFFER_SIZE (2048)
+
+/* Extracted data is written in whole multiples of SD sectors */
+#define UNPACK_BLOCK_SIZE (4096U)
+#define UNPACK_BLOCKS     (2U)
+
 TarOpenMode tar_archive_get_mode_for_path(const char* path) {
     char ext[8];
 
@@ -122,6 +129,64 @@ const struct mtar_ops heatshrink_ops = {
     .close = mtar_heatshrink_file_close,
 };
 
+/* Heatshrink stream backend - compressed, write-only */
+
+#define HEATSHRINK_WRITE_WINDOW_SZ2    (10)
+#define HEATSHRINK_WRITE_LOOKAHEAD_SZ2 (5)
+
+typedef struct {
+    CompressStreamEncoder* encoder;
+    File* stream; // NULL when writing to a callback
+} HeatshrinkWriteStream;
+
+static const CompressConfigHeatshrink heatshrink_write_config = {
+    .window_sz2 = HEATSHRINK_WRITE_WINDOW_SZ2,
+    .lookahead_sz2 = HEATSHRINK_WRITE_LOOKAHEAD_SZ2,
+    .input_buffer_sz = FILE_BLOCK_SIZE,
+};
+
+static int mtar_heatshrink_stream_write(void* stream, const void* data, unsigned size) {
+    HeatshrinkWriteStream* hs_stream = stream;
+    bool write_success = compress_stream_encoder_write(hs_stream->encoder, data, size);
+    return write_success ? (int)size : MTAR_EWRITEFAIL;
+}
+
+static int mtar_heatshrink_stream_read(void* stream, void* data, unsigned size) {
+    UNUSED(stream);
+    UNUSED(data);
+    UNUSED(size);
+    return MTAR_EREADFAIL;
+}
+
+static int mtar_heatshrink_stream_seek(void* stream, unsigned offset) {
+    UNUSED(stream);
+    UNUSED(offset);
+    return MTAR_ESEEKFAIL;
+}
+
+static int mtar_heatshrink_stream_close(void* stream) {
+    HeatshrinkWriteStream* hs_stream = stream;
+    int result = MTAR_ESUCCESS;
+    if(hs_stream) {
+        if(!compress_stream_encoder_finish(hs_stream->encoder)) {
+            result = MTAR_EWRITEFAIL;
+        }
+        compress_stream_encoder_free(hs_stream->encoder);
+        if(hs_stream->stream) {
+            storage_file_close(hs_stream->stream);
+        }
+        free(hs_stream);
+    }
+    return result;
+}
+
+const struct mtar_ops heatshrink_write_ops = {
+    .read = mtar_heatshrink_stream_read,
+    .write = mtar_heatshrink_stream_write,
+    .seek = mtar_heatshrink_stream_seek,
+    .close = mtar_heatshrink_stream_close,
+};
+
 //////////////////////////////////////////////////////////////////////////
 
 TarArchive* tar_archive_alloc(Storage* storage) {
@@ -138,6 +203,45 @@ static int32_t file_read_cb(void* context, uint8_t* buffer, size_t buffer_size)
     return storage_file_read(file, buffer, buffer_size);
 }
 
+static int32_t file_write_cb(void* context, uint8_t* buffer, size_t buffer_size) {
+    File* file = context;
+    return storage_file_write(file, buffer, buffer_size);
+}
+
+static bool tar_archive_open_heatshrink_writer(
+    TarArchive* archive,
+    File* stream,
+    CompressIoCallback write_cb,
+    void* write_context) {
+    HeatshrinkStreamHeader header = {
+        .magic = HEATSHRINK_MAGIC,
+        .version = 1,
+        .window_sz2 = HEATSHRINK_WRITE_WINDOW_SZ2,
+        .lookahead_sz2 = HEATSHRINK_WRITE_LOOKAHEAD_SZ2,
+    };
+    if(write_cb(write_context, (uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+
+    HeatshrinkWriteStream* hs_stream = malloc(sizeof(HeatshrinkWriteStream));
+    hs_stream->stream = stream;
+    hs_stream->encoder = compress_stream_encoder_alloc(
+        CompressTypeHeatshrink, &heatshrink_write_config, write_cb, write_context);
+    mtar_init(&archive->tar, MTAR_WRITE, &heatshrink_write_ops, hs_stream);
+
+    return true;
+}
+
+bool tar_archive_open_write_stream(
+    TarArchive* archive,
+    CompressIoCallback write_cb,
+    void* write_context) {
+    furi_check(archive);
+    furi_check(write_cb);
+
+    return tar_archive_open_heatshrink_writer(archive, NULL, write_cb, write_context);
+}
+
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
     furi_check(archive);
     FS_AccessMode access_mode;
@@ -162,6 +266,12 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         open_mode = FSOM_OPEN_EXISTING;
         compressed = true;
         break;
+    case TarOpenModeWriteHeatshrink:
+        mtar_access = MTAR_WRITE;
+        access_mode = FSAM_WRITE;
+        open_mode = FSOM_CREATE_ALWAYS;
+        compressed = true;
+        break;
     default:
         return false;
     }
@@ -171,7 +281,12 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         return false;
     }
 
-    if(compressed) {
+    if(compressed && mtar_access == MTAR_WRITE) {
+        if(!tar_archive_open_heatshrink_writer(archive, stream, file_write_cb, stream)) {
+            storage_file_close(stream);
+            return false;
+        }
+    } else if(compressed) {
         /* Read and validate stream header */
         HeatshrinkStreamHeader header;
         if(storage_file_read(stream, &header, sizeof(HeatshrinkStreamHeader)) !=
@@ -185,7 +300,7 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         hs_stream->stream = stream;
         hs_stream->heatshrink_config.window_sz2 = header.window_sz2;
         hs_stream->heatshrink_config.lookahead_sz2 = header.lookahead_sz2;
-        hs_stream->heatshrink_config.input_buffer_sz = FILE_BLOCK_SIZE;
+        hs_stream->heatshrink_config.input_buffer_sz = HEATSHRINK_READ_BUFFER_SIZE;
         hs_stream->decoder = compress_stream_decoder_alloc(
             CompressTypeHeatshrink, &hs_stream->heatshrink_config, file_read_cb, stream);
         mtar_init(&archive->tar, mtar_access, &heatshrink_ops, hs_stream);
@@ -196,6 +311,15 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
     return true;
 }
 
+bool tar_archive_close(TarArchive* archive) {
+    furi_check(archive);
+    bool success = true;
+    if(mtar_is_open(&archive->tar)) {
+        success = (mtar_close(&archive->tar) == MTAR_ESUCCESS);
+    }
+    return success;
+}
+
 void tar_archive_free(TarArchive* archive) {
     furi_check(archive);
     if(mtar_is_open(&archive->tar)) {
@@ -286,30 +410,206 @@ bool tar_archive_file_finalize(TarArchive* archive) {
     return mtar_end_data(&archive->tar) == MTAR_ESUCCESS;
 }
 
+/* Extraction pipeline: the caller thread reads and decompresses the archive,
+ * the writer thread writes extracted files, blocks are passed between them */
+
+typedef enum {
+    TarUnpackBlockTypeOpen,
+    TarUnpackBlockTypeData,
+    TarUnpackBlockTypeClose,
+    TarUnpackBlockTypeStop,
+} TarUnpackBlockType;
+
+typedef struct {
+    TarUnpackBlockType type;
+    FuriString* path;
+    uint8_t* data;
+    size_t size;
+} TarUnpackBlock;
+
+typedef struct {
+    File* file;
+    FuriThread* thread;
+    FuriMessageQueue* free_blocks;
+    FuriMessageQueue* filled_blocks;
+    TarUnpackBlock blocks[UNPACK_BLOCKS];
+    bool is_failed; // Set by the writer thread, read by others only while all blocks are free
+} TarUnpackWriter;
+
 typedef struct {
     TarArchive* archive;
     const char* work_dir;
     TarArchiveNameConverter converter;
+    TarUnpackWriter* writer;
 } TarArchiveDirectoryOpParams;
 
-static bool archive_extract_current_file(TarArchive* archive, const char* dst_path) {
+static bool archive_open_output_file(File* out_file, const char* dst_path) {
+    uint8_t n_tries = FILE_OPEN_NTRIES;
+    while(n_tries-- > 0) {
+        if(storage_file_open(out_file, dst_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            return true;
+        }
+        FURI_LOG_W(TAG, "Failed to open '%s', reties: %d", dst_path, n_tries);
+        storage_file_close(out_file);
+        furi_delay_ms(FILE_OPEN_RETRY_DELAY);
+    }
+    return false;
+}
+
+static int32_t tar_unpack_writer_worker(void* context) {
+    TarUnpackWriter* writer = context;
+    bool is_running = true;
+
+    while(is_running) {
+        TarUnpackBlock* block;
+        furi_check(
+            furi_message_queue_get(writer->filled_blocks, &block, FuriWaitForever) ==
+            FuriStatusOk);
+
+        if(block->type == TarUnpackBlockTypeOpen) {
+            if(!writer->is_failed &&
+               !archive_open_output_file(writer->file, furi_string_get_cstr(block->path))) {
+                writer->is_failed = true;
+            }
+        } else if(block->type == TarUnpackBlockTypeData) {
+            if(!writer->is_failed &&
+               storage_file_write(writer->file, block->data, block->size) != block->size) {
+                FURI_LOG_E(TAG, "Failed to write %zu bytes", block->size);
+                writer->is_failed = true;
+            }
+        } else if(block->type == TarUnpackBlockTypeClose) {
+            storage_file_close(writer->file);
+        } else {
+            is_running = false;
+        }
+
+        furi_message_queue_put(writer->free_blocks, &block, 0);
+    }
+
+    return 0;
+}
+
+static TarUnpackWriter* tar_unpack_writer_alloc(Storage* storage) {
+    TarUnpackWriter* writer = malloc(sizeof(TarUnpackWriter));
+    writer->file = storage_file_alloc(storage);
+    writer->free_blocks = furi_message_queue_alloc(UNPACK_BLOCKS, sizeof(TarUnpackBlock*));
+    writer->filled_blocks = furi_message_queue_alloc(UNPACK_BLOCKS, sizeof(TarUnpackBlock*));
+
+    for(size_t i = 0; i < UNPACK_BLOCKS; i++) {
+        TarUnpackBlock* block = &writer->blocks[i];
+        block->path = furi_string_alloc();
+        block->data = malloc(UNPACK_BLOCK_SIZE);
+        furi_message_queue_put(writer->free_blocks, &block, 0);
+    }
+
+    writer->thread =
+        furi_thread_alloc_ex("TarUnpackWriter", 2048, tar_unpack_writer_worker, writer);
+    furi_thread_start(writer->thread);
+
+    return writer;
+}
+
+static TarUnpackBlock* tar_unpack_writer_get_block(TarUnpackWriter* writer) {
+    TarUnpackBlock* block;
+    furi_check(
+        furi_message_queue_get(writer->free_blocks, &block, FuriWaitForever) == FuriStatusOk);
+    return block;
+}
+
+static void tar_unpack_writer_put_block(
+    TarUnpackWriter* writer,
+    TarUnpackBlock* block,
+    TarUnpackBlockType type) {
+    block->type = type;
+    furi_check(
+        furi_message_queue_put(writer->filled_blocks, &block, FuriWaitForever) == FuriStatusOk);
+}
+
+/* Waits for pending writes and returns false if any of them failed.
+ * Once every block is back in the free queue the writer is idle, and the queue
+ * hands over its result. */
+static bool tar_unpack_writer_sync(TarUnpackWriter* writer) {
+    TarUnpackBlock* blocks[UNPACK_BLOCKS];
+    for(size_t i = 0; i < UNPACK_BLOCKS; i++) {
+        blocks[i] = tar_unpack_writer_get_block(writer);
+    }
+
+    bool success = !writer->is_failed;
+
+    for(size_t i = 0; i < UNPACK_BLOCKS; i++) {
+        furi_check(furi_message_queue_put(writer->free_blocks, &blocks[i], 0) == FuriStatusOk);
+    }
+
+    return success;
+}
+
+/* Waits for pending writes and returns false if any of them failed */
+static bool tar_unpack_writer_free(TarUnpackWriter* writer) {
+    TarUnpackBlock* block = tar_unpack_writer_get_block(writer);
+    tar_unpack_writer_put_block(writer, block, TarUnpackBlockTypeStop);
+
+    // Joining the thread makes its last result visible
+    furi_thread_join(writer->thread);
+    furi_thread_free(writer->thread);
+
+    bool success = !writer->is_failed;
+
+    for(size_t i = 0; i < UNPACK_BLOCKS; i++) {
+        furi_string_free(writer->blocks[i].path);
+        free(writer->blocks[i].data);
+    }
+    furi_message_queue_free(writer->filled_blocks);
+    furi_message_queue_free(writer->free_blocks);
+    storage_file_free(writer->file);
+    free(writer);
+
+    return success;
+}
+
+static bool archive_extract_current_file_pipelined(
+    TarArchive* archive,
+    TarUnpackWriter* writer,
+    const char* dst_path) {
     mtar_t* tar = &archive->tar;
-    File* out_file = storage_file_alloc(archive->storage);
-    uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
+
+    TarUnpackBlock* block = tar_unpack_writer_get_block(writer);
+    furi_string_set(block->path, dst_path);
+    tar_unpack_writer_put_block(writer, block, TarUnpackBlockTypeOpen);
 
     bool success = true;
-    uint8_t n_tries = FILE_OPEN_NTRIES;
-    do {
-        while(n_tries-- > 0) {
-            if(storage_file_open(out_file, dst_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+    while(success && !mtar_eof_data(tar)) {
+        block = tar_unpack_writer_get_block(writer);
+        block->size = 0;
+
+        /* Decompress straight into the block while the writer is busy with the previous one */
+        while(block->size < UNPACK_BLOCK_SIZE && !mtar_eof_data(tar)) {
+            int32_t readcnt =
+                mtar_read_data(tar, &block->data[block->size], UNPACK_BLOCK_SIZE - block->size);
+            if(readcnt <= 0) {
+                success = false;
                 break;
             }
-            FURI_LOG_W(TAG, "Failed to open '%s', reties: %d", dst_path, n_tries);
-            storage_file_close(out_file);
-            furi_delay_ms(FILE_OPEN_RETRY_DELAY);
+            block->size += readcnt;
         }
 
-        if(!storage_file_is_open(out_file)) {
+        tar_unpack_writer_put_block(writer, block, TarUnpackBlockTypeData);
+    }
+
+    block = tar_unpack_writer_get_block(writer);
+    tar_unpack_writer_put_block(writer, block, TarUnpackBlockTypeClose);
+
+    /* Write errors are reported for this file, before the next one starts */
+    return tar_unpack_writer_sync(writer) && success;
+}
+
+static bool archive_extract_current_file(TarArchive* archive, const char* dst_path) {
+    mtar_t* tar = &archive->tar;
+    File* out_file = storage_file_alloc(archive->storage);
+    uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
+
+    bool success = true;
+    do {
+        if(!archive_open_output_file(out_file, dst_path)) {
             success = false;
             break;
         }
@@ -375,8 +675,8 @@ static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header,
     full_extracted_fname = furi_string_alloc();
     path_concat(op_params->work_dir, furi_string_get_cstr(converted_fname), full_extracted_fname);
 
-    bool success =
-        archive_extract_current_file(archive, furi_string_get_cstr(full_extracted_fname));
+    bool success = archive_extract_current_file_pipelined(
+        archive, op_params->writer, furi_string_get_cstr(full_extracted_fname));
 
     furi_string_free(converted_fname);
     furi_string_free(full_extracted_fname);
@@ -392,11 +692,16 @@ bool tar_archive_unpack_to(
         .archive = archive,
         .work_dir = destination,
         .converter = converter,
+        .writer = tar_unpack_writer_alloc(archive->storage),
     };
 
     FURI_LOG_I(TAG, "Restoring '%s'", destination);
 
-    return mtar_foreach(&archive->tar, archive_extract_foreach_cb, &param) == MTAR_ESUCCESS;
+    bool success = mtar_foreach(&archive->tar, archive_extract_foreach_cb, &param) ==
+                   MTAR_ESUCCESS;
+    success = tar_unpack_writer_free(param.writer) && success;
+
+    return success;
 }
 
 bool tar_archive_add_file(
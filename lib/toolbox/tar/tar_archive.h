@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <storage/storage.h>
+#include <toolbox/compress.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,6 +20,8 @@ typedef enum {
     TarOpenModeWrite = 'w',
     /* read-only heatshrink compressed tar */
     TarOpenModeReadHeatshrink = 'h',
+    /* write-only heatshrink compressed tar */
+    TarOpenModeWriteHeatshrink = 'H',
 } TarOpenMode;
 
 /** Get expected open mode for archive at the path.
@@ -48,6 +51,30 @@ TarArchive* tar_archive_alloc(Storage* storage);
  */
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode);
 
+/** Open tar archive for writing heatshrink compressed data to a callback
+ * Output is the same as of a file written with TarOpenModeWriteHeatshrink
+ *
+ * @param       archive       Tar archive object
+ * @param       write_cb      Callback for compressed data
+ * @param       write_context Callback context
+ *
+ * @return true if successful
+ */
+bool tar_archive_open_write_stream(
+    TarArchive* archive,
+    CompressIoCallback write_cb,
+    void* write_context);
+
+/** Close tar archive
+ * Writers flush buffered data, heatshrink writers also the compressor state.
+ * Archive is closed by tar_archive_free if this is not called.
+ *
+ * @param archive Tar archive object
+ *
+ * @return true if all data was written successfully
+ */
+bool tar_archive_close(TarArchive* archive);
+
 /** Tar archive destructor
  *
  * @param archive Tar archive object
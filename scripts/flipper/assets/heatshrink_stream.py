@@ -1,5 +1,7 @@
 import struct
 
+import heatshrink2
+
 
 class HeatshrinkDataStreamHeader:
     MAGIC = 0x53445348
@@ -24,3 +26,76 @@ class HeatshrinkDataStreamHeader:
         if version != HeatshrinkDataStreamHeader.VERSION:
             raise ValueError("Invalid version")
         return HeatshrinkDataStreamHeader(window_size, lookahead_size)
+
+
+class HeatshrinkBlockStreamHeader:
+    MAGIC = 0x4B425348
+    VERSION = 1
+    SIZE = 20
+
+    def __init__(
+        self, window_size, lookahead_size, block_size, data_size=0, index_offset=0
+    ):
+        self.window_size = window_size
+        self.lookahead_size = lookahead_size
+        self.block_size = block_size
+        self.data_size = data_size
+        self.index_offset = index_offset
+
+    def pack(self):
+        return struct.pack(
+            "<IBBBBIII",
+            self.MAGIC,
+            self.VERSION,
+            self.window_size,
+            self.lookahead_size,
+            0,
+            self.block_size,
+            self.data_size,
+            self.index_offset,
+        )
+
+    @staticmethod
+    def unpack(data):
+        if len(data) != HeatshrinkBlockStreamHeader.SIZE:
+            raise ValueError("Invalid header length")
+        (
+            magic,
+            version,
+            window_size,
+            lookahead_size,
+            _,
+            block_size,
+            data_size,
+            index_offset,
+        ) = struct.unpack("<IBBBBIII", data)
+        if magic != HeatshrinkBlockStreamHeader.MAGIC:
+            raise ValueError("Invalid magic number")
+        if version != HeatshrinkBlockStreamHeader.VERSION:
+            raise ValueError("Invalid version")
+        return HeatshrinkBlockStreamHeader(
+            window_size, lookahead_size, block_size, data_size, index_offset
+        )
+
+
+def compress_blocks(data, block_size, window_size, lookahead_size):
+    """Compress data into independently decodable blocks followed by a block index,
+    as read by CompressBlockDecoder"""
+    blocks = bytearray()
+    index = []
+    for offset in range(0, len(data), block_size):
+        index.append(HeatshrinkBlockStreamHeader.SIZE + len(blocks))
+        blocks += heatshrink2.compress(
+            data[offset : offset + block_size],
+            window_sz2=window_size,
+            lookahead_sz2=lookahead_size,
+        )
+
+    header = HeatshrinkBlockStreamHeader(
+        window_size,
+        lookahead_size,
+        block_size,
+        len(data),
+        HeatshrinkBlockStreamHeader.SIZE + len(blocks),
+    )
+    return header.pack() + blocks + struct.pack(f"<{len(index)}I", *index)
@@ -2,7 +2,10 @@
 
 import heatshrink2 as hs
 from flipper.app import App
-from flipper.assets.heatshrink_stream import HeatshrinkDataStreamHeader
+from flipper.assets.heatshrink_stream import (
+    HeatshrinkDataStreamHeader,
+    compress_blocks,
+)
 from flipper.assets.tarball import compress_tree_tarball
 
 
@@ -28,6 +31,14 @@ class HSWrapper(App):
             type=int,
             default=self.DEFAULT_LOOKAHEAD,
         )
+        self.parser_compress.add_argument(
+            "-b",
+            "--block-size",
+            help="compress into independently decodable blocks of this size, "
+            "for random access on device",
+            type=int,
+            default=0,
+        )
         self.parser_compress.add_argument("file", help="file to compress")
         self.parser_compress.add_argument(
             "-o", "--output", help="output file", required=True
@@ -72,14 +83,20 @@ class HSWrapper(App):
         with open(args.file, "rb") as f:
             data = f.read()
 
-        compressed = hs.compress(
-            data, window_sz2=args.window, lookahead_sz2=args.lookahead
-        )
-
-        with open(args.output, "wb") as f:
-            header = HeatshrinkDataStreamHeader(args.window, args.lookahead)
-            f.write(header.pack())
-            f.write(compressed)
+        if args.block_size:
+            compressed = compress_blocks(
+                data, args.block_size, args.window, args.lookahead
+            )
+            with open(args.output, "wb") as f:
+                f.write(compressed)
+        else:
+            compressed = hs.compress(
+                data, window_sz2=args.window, lookahead_sz2=args.lookahead
+            )
+            with open(args.output, "wb") as f:
+                header = HeatshrinkDataStreamHeader(args.window, args.lookahead)
+                f.write(header.pack())
+                f.write(compressed)
 
         self.logger.info(
             f"Compressed {len(data)} bytes to {len(compressed)} bytes, "
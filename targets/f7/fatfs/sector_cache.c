@@ -4,53 +4,281 @@
 #include <stdio.h>
 #include <string.h>
 #include <furi.h>
-#include <furi_hal_memory.h>
 
 #define SECTOR_SIZE 512
-#define N_SECTORS   8
+
+#define SECTOR_CACHE_BUCKETS_BITS  (6U)
+#define SECTOR_CACHE_BUCKETS       (1U << SECTOR_CACHE_BUCKETS_BITS)
+#define SECTOR_CACHE_NONE          (0xFFU)
 
 typedef struct {
-    uint32_t itr;
-    uint32_t sectors[N_SECTORS];
-    uint8_t sector_data[N_SECTORS][SECTOR_SIZE];
-} SectorCache;
+    uint32_t sector; // 0 - slot is free, sector 0 is never cached
+    uint8_t prev; // Neighbour closer to the most recently used end
+    uint8_t next; // Neighbour closer to the least recently used end, or the next free slot
+    uint8_t bucket_next;
+    bool pinned;
+} SectorCacheSlot;
+
+struct SectorCache {
+    size_t capacity;
+    uint8_t head; // Most recently used
+    uint8_t tail; // Least recently used
+    uint8_t free;
+    size_t pinned_count;
+
+    uint32_t pin_start;
+    uint32_t pin_end;
+
+    uint32_t next_expected;
+    uint32_t sequential_misses;
+
+    SectorCacheStats stats;
+
+    uint8_t buckets[SECTOR_CACHE_BUCKETS];
+    SectorCacheSlot slots[SECTOR_CACHE_SECTORS_MAX];
+
+    uint8_t* readahead_buffer;
+    uint8_t* sector_data;
+};
+
+static inline size_t sector_cache_bucket(uint32_t n_sector) {
+    return (uint32_t)(n_sector * 2654435761U) >> (32 - SECTOR_CACHE_BUCKETS_BITS);
+}
+
+static inline uint8_t* sector_cache_slot_data(SectorCache* cache, uint8_t slot) {
+    return &cache->sector_data[slot * SECTOR_SIZE];
+}
+
+static inline bool sector_cache_is_pinned(SectorCache* cache, uint32_t n_sector) {
+    return (n_sector >= cache->pin_start) && (n_sector <= cache->pin_end);
+}
+
+void sector_cache_reset(SectorCache* cache) {
+    furi_check(cache);
+
+    cache->head = SECTOR_CACHE_NONE;
+    cache->tail = SECTOR_CACHE_NONE;
+    cache->pinned_count = 0;
+    cache->next_expected = 0;
+    cache->sequential_misses = 0;
+    memset(&cache->stats, 0, sizeof(SectorCacheStats));
+    memset(cache->buckets, SECTOR_CACHE_NONE, sizeof(cache->buckets));
+
+    cache->free = 0;
+    for(size_t i = 0; i < cache->capacity; i++) {
+        cache->slots[i].sector = 0;
+        cache->slots[i].next = (i + 1 < cache->capacity) ? i + 1 : SECTOR_CACHE_NONE;
+    }
+}
+
+static uint8_t sector_cache_lookup(SectorCache* cache, uint32_t n_sector) {
+    uint8_t slot = cache->buckets[sector_cache_bucket(n_sector)];
+    while(slot != SECTOR_CACHE_NONE && cache->slots[slot].sector != n_sector) {
+        slot = cache->slots[slot].bucket_next;
+    }
+    return slot;
+}
 
-static SectorCache* cache = NULL;
+static void sector_cache_lru_unlink(SectorCache* cache, uint8_t slot) {
+    SectorCacheSlot* entry = &cache->slots[slot];
 
-void sector_cache_init(void) {
-    if(cache == NULL) {
-        cache = memmgr_alloc_from_pool(sizeof(SectorCache));
+    if(entry->prev != SECTOR_CACHE_NONE) {
+        cache->slots[entry->prev].next = entry->next;
+    } else {
+        cache->head = entry->next;
     }
 
-    if(cache != NULL) {
-        memset(cache, 0, sizeof(SectorCache));
+    if(entry->next != SECTOR_CACHE_NONE) {
+        cache->slots[entry->next].prev = entry->prev;
+    } else {
+        cache->tail = entry->prev;
+    }
+}
+
+static void sector_cache_lru_push_head(SectorCache* cache, uint8_t slot) {
+    SectorCacheSlot* entry = &cache->slots[slot];
+
+    entry->prev = SECTOR_CACHE_NONE;
+    entry->next = cache->head;
+    if(cache->head != SECTOR_CACHE_NONE) {
+        cache->slots[cache->head].prev = slot;
+    } else {
+        cache->tail = slot;
     }
+    cache->head = slot;
 }
 
-uint8_t* sector_cache_get(uint32_t n_sector) {
-    if(cache != NULL && n_sector != 0) {
-        for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-            if(cache->sectors[sector_i] == n_sector) {
-                return cache->sector_data[sector_i];
-            }
+static void sector_cache_remove(SectorCache* cache, uint8_t slot) {
+    SectorCacheSlot* entry = &cache->slots[slot];
+
+    uint8_t* link = &cache->buckets[sector_cache_bucket(entry->sector)];
+    while(*link != slot) {
+        link = &cache->slots[*link].bucket_next;
+    }
+    *link = entry->bucket_next;
+
+    sector_cache_lru_unlink(cache, slot);
+    if(entry->pinned) cache->pinned_count--;
+
+    entry->sector = 0;
+    entry->next = cache->free;
+    cache->free = slot;
+}
+
+static uint8_t sector_cache_evict(SectorCache* cache) {
+    // Pinned sectors survive as long as they take no more than half of the cache
+    bool spare_pinned = cache->pinned_count <= cache->capacity / 2;
+
+    uint8_t victim = cache->tail;
+    if(spare_pinned) {
+        while(victim != SECTOR_CACHE_NONE && cache->slots[victim].pinned) {
+            victim = cache->slots[victim].prev;
         }
+        if(victim == SECTOR_CACHE_NONE) victim = cache->tail;
     }
-    return NULL;
+
+    sector_cache_remove(cache, victim);
+    cache->stats.evictions++;
+
+    return victim;
 }
 
-void sector_cache_put(uint32_t n_sector, uint8_t* data) {
-    if(cache == NULL) return;
-    cache->sectors[cache->itr % N_SECTORS] = n_sector;
-    memcpy(cache->sector_data[cache->itr % N_SECTORS], data, SECTOR_SIZE);
-    cache->itr++;
+size_t sector_cache_get_memory_size(size_t capacity, size_t readahead) {
+    return sizeof(SectorCache) + (capacity + readahead) * SECTOR_SIZE;
 }
 
-void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
-    if(cache == NULL) return;
-    for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-        if((cache->sectors[sector_i] >= start_sector) &&
-           (cache->sectors[sector_i] <= end_sector)) {
-            cache->sectors[sector_i] = 0;
+SectorCache* sector_cache_init(void* memory, size_t capacity, size_t readahead) {
+    furi_check(memory);
+    furi_check(capacity > 0 && capacity <= SECTOR_CACHE_SECTORS_MAX);
+    furi_check(readahead == 0 || readahead == SECTOR_CACHE_READAHEAD_MAX);
+
+    SectorCache* cache = memory;
+    memset(cache, 0, sizeof(SectorCache));
+    cache->capacity = capacity;
+    cache->sector_data = (uint8_t*)cache + sizeof(SectorCache);
+    if(readahead) {
+        cache->readahead_buffer = cache->sector_data + capacity * SECTOR_SIZE;
+    }
+    sector_cache_reset(cache);
+
+    return cache;
+}
+
+uint8_t* sector_cache_get(SectorCache* cache, uint32_t n_sector) {
+    furi_check(cache);
+    if(n_sector == 0) return NULL;
+
+    uint8_t slot = sector_cache_lookup(cache, n_sector);
+    if(slot == SECTOR_CACHE_NONE) {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    if(slot != cache->head) {
+        sector_cache_lru_unlink(cache, slot);
+        sector_cache_lru_push_head(cache, slot);
+    }
+    cache->stats.hits++;
+
+    return sector_cache_slot_data(cache, slot);
+}
+
+void sector_cache_put(SectorCache* cache, uint32_t n_sector, uint8_t* data) {
+    furi_check(cache);
+    if(n_sector == 0) return;
+
+    uint8_t slot = sector_cache_lookup(cache, n_sector);
+    if(slot != SECTOR_CACHE_NONE) {
+        sector_cache_lru_unlink(cache, slot);
+    } else {
+        if(cache->free != SECTOR_CACHE_NONE) {
+            slot = cache->free;
+            cache->free = cache->slots[slot].next;
+        } else {
+            slot = sector_cache_evict(cache);
+            cache->free = cache->slots[slot].next;
         }
+
+        SectorCacheSlot* entry = &cache->slots[slot];
+        entry->sector = n_sector;
+        entry->pinned = sector_cache_is_pinned(cache, n_sector);
+        if(entry->pinned) cache->pinned_count++;
+
+        size_t bucket = sector_cache_bucket(n_sector);
+        entry->bucket_next = cache->buckets[bucket];
+        cache->buckets[bucket] = slot;
     }
+
+    sector_cache_lru_push_head(cache, slot);
+    memcpy(sector_cache_slot_data(cache, slot), data, SECTOR_SIZE);
+}
+
+void sector_cache_invalidate_range(
+    SectorCache* cache,
+    uint32_t start_sector,
+    uint32_t end_sector) {
+    furi_check(cache);
+
+    for(size_t slot = 0; slot < cache->capacity; slot++) {
+        uint32_t n_sector = cache->slots[slot].sector;
+        if((n_sector != 0) && (n_sector >= start_sector) && (n_sector <= end_sector)) {
+            sector_cache_remove(cache, slot);
+        }
+    }
+}
+
+void sector_cache_pin_range(SectorCache* cache, uint32_t start_sector, uint32_t end_sector) {
+    furi_check(cache);
+
+    cache->pin_start = start_sector;
+    cache->pin_end = end_sector;
+
+    cache->pinned_count = 0;
+    for(size_t slot = 0; slot < cache->capacity; slot++) {
+        SectorCacheSlot* entry = &cache->slots[slot];
+        entry->pinned = (entry->sector != 0) && sector_cache_is_pinned(cache, entry->sector);
+        if(entry->pinned) cache->pinned_count++;
+    }
+}
+
+uint32_t sector_cache_readahead_count(SectorCache* cache, uint32_t n_sector) {
+    furi_check(cache);
+    if(cache->readahead_buffer == NULL) return 1;
+
+    // Two misses in a row on adjacent sectors look like a sequential read
+    if(n_sector == cache->next_expected) {
+        cache->sequential_misses++;
+    } else {
+        cache->sequential_misses = 0;
+    }
+
+    uint32_t count = (cache->sequential_misses > 0) ? SECTOR_CACHE_READAHEAD_MAX : 1;
+    cache->next_expected = n_sector + count;
+
+    return count;
+}
+
+uint8_t* sector_cache_get_readahead_buffer(SectorCache* cache) {
+    furi_check(cache);
+    return cache->readahead_buffer;
+}
+
+void sector_cache_put_readahead(SectorCache* cache, uint32_t n_sector, uint32_t count) {
+    furi_check(cache);
+    furi_check(cache->readahead_buffer);
+    furi_check(count <= SECTOR_CACHE_READAHEAD_MAX);
+
+    for(uint32_t i = 0; i < count; i++) {
+        sector_cache_put(cache, n_sector + i, &cache->readahead_buffer[i * SECTOR_SIZE]);
+    }
+    // Only sectors that actually came from the card count, the requested one isn't ahead
+    if(count > 1) cache->stats.readahead += count - 1;
+}
+
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats) {
+    furi_check(cache);
+    furi_check(stats);
+
+    *stats = cache->stats;
+    stats->capacity = cache->capacity;
 }
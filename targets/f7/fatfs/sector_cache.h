@@ -1,35 +1,113 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define SECTOR_CACHE_SECTORS_MAX   (24U)
+#define SECTOR_CACHE_SECTORS_MIN   (8U)
+#define SECTOR_CACHE_READAHEAD_MAX (4U)
+
+typedef struct SectorCache SectorCache;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t readahead; // Sectors fetched ahead of a sequential read
+    size_t capacity; // Sectors
+} SectorCacheStats;
+
 /**
- * @brief Init sector cache system
+ * @brief Get memory size needed by a sector cache
+ * @param capacity Number of cached sectors, up to SECTOR_CACHE_SECTORS_MAX
+ * @param readahead Read ahead buffer size in sectors, 0 or SECTOR_CACHE_READAHEAD_MAX
+ * @return Size in bytes
  */
-void sector_cache_init(void);
+size_t sector_cache_get_memory_size(size_t capacity, size_t readahead);
+
+/**
+ * @brief Create sector cache in given memory
+ * The memory is owned by the caller and must outlive the cache
+ * @param memory Memory of sector_cache_get_memory_size() bytes
+ * @param capacity Number of cached sectors, up to SECTOR_CACHE_SECTORS_MAX
+ * @param readahead Read ahead buffer size in sectors, 0 or SECTOR_CACHE_READAHEAD_MAX
+ * @return Sector cache instance
+ */
+SectorCache* sector_cache_init(void* memory, size_t capacity, size_t readahead);
+
+/**
+ * @brief Drop all cached sectors and statistics, the pinned range is kept
+ * @param cache Sector cache instance
+ */
+void sector_cache_reset(SectorCache* cache);
 
 /**
  * @brief Get sector data from cache
+ * @param cache Sector cache instance
  * @param n_sector Sector number
  * @return Pointer to sector data or NULL if not found
  */
-uint8_t* sector_cache_get(uint32_t n_sector);
+uint8_t* sector_cache_get(SectorCache* cache, uint32_t n_sector);
 
 /**
  * @brief Put sector data to cache
+ * @param cache Sector cache instance
  * @param n_sector Sector number
  * @param data Pointer to sector data
  */
-void sector_cache_put(uint32_t n_sector, uint8_t* data);
+void sector_cache_put(SectorCache* cache, uint32_t n_sector, uint8_t* data);
+
+/**
+ * @brief Put sectors read ahead to cache
+ * @param cache Sector cache instance
+ * @param n_sector First sector number
+ * @param count Number of sectors in the read ahead buffer
+ */
+void sector_cache_put_readahead(SectorCache* cache, uint32_t n_sector, uint32_t count);
 
 /**
  * @brief Invalidate sector cache for given range
+ * @param cache Sector cache instance
+ * @param start_sector Start sector number
+ * @param end_sector End sector number
+ */
+void sector_cache_invalidate_range(SectorCache* cache, uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Keep sectors of given range in cache in favour of others
+ * Pinned sectors are evicted only when they take more than half of the cache
+ * @param cache Sector cache instance
  * @param start_sector Start sector number
  * @param end_sector End sector number
  */
-void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector);
+void sector_cache_pin_range(SectorCache* cache, uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Get number of sectors to read on a cache miss
+ * Grows when misses follow each other sequentially
+ * @param cache Sector cache instance
+ * @param n_sector Missed sector number
+ * @return Number of sectors starting from n_sector, 1 means no read ahead
+ */
+uint32_t sector_cache_readahead_count(SectorCache* cache, uint32_t n_sector);
+
+/**
+ * @brief Get buffer for read ahead
+ * @param cache Sector cache instance
+ * @return Pointer to a buffer large enough for sector_cache_readahead_count() sectors
+ * or NULL if read ahead is not available
+ */
+uint8_t* sector_cache_get_readahead_buffer(SectorCache* cache);
+
+/**
+ * @brief Get sector cache statistics
+ * @param cache Sector cache instance
+ * @param stats Pointer to the statistics to fill
+ */
+void sector_cache_get_stats(SectorCache* cache, SectorCacheStats* stats);
 
 #ifdef __cplusplus
 }
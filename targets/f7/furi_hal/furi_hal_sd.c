@@ -17,10 +17,13 @@
 #define SD_IDLE_RETRY_COUNT   (100)
 #define SD_TIMEOUT_MS         (1000)
 #define SD_BLOCK_SIZE         (512)
+#define SD_CACHE_SECTORS      SECTOR_CACHE_SECTORS_MIN
+#define SD_CACHE_READAHEAD    SECTOR_CACHE_READAHEAD_MAX
 
 #define FLAG_SET(x, y) (((x) & (y)) == (y))
 
 static bool sd_high_capacity = false;
+static SectorCache* sd_sector_cache = NULL;
 
 typedef enum {
     SdSpiDataResponceOK = 0x05,
@@ -816,8 +819,29 @@ static FuriStatus sd_spi_get_card_state(void) {
     return FuriStatusError;
 }
 
+static void sd_cache_init(void) {
+    if(sd_sector_cache == NULL) {
+        // The pool also holds thread stacks, so the cache takes a fixed share of it
+        size_t readahead = SD_CACHE_READAHEAD;
+        void* memory =
+            memmgr_alloc_from_pool(sector_cache_get_memory_size(SD_CACHE_SECTORS, readahead));
+        if(memory == NULL) {
+            readahead = 0;
+            memory =
+                memmgr_alloc_from_pool(sector_cache_get_memory_size(SD_CACHE_SECTORS, readahead));
+        }
+        if(memory != NULL) {
+            sd_sector_cache = sector_cache_init(memory, SD_CACHE_SECTORS, readahead);
+        }
+    } else {
+        sector_cache_reset(sd_sector_cache);
+    }
+}
+
 static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
-    uint8_t* cached_data = sector_cache_get(address);
+    if(sd_sector_cache == NULL) return false;
+
+    uint8_t* cached_data = sector_cache_get(sd_sector_cache, address);
     if(cached_data) {
         memcpy(data, cached_data, SD_BLOCK_SIZE);
         return true;
@@ -826,15 +850,17 @@ static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
 }
 
 static inline void sd_cache_put(uint32_t address, uint32_t* data) {
-    sector_cache_put(address, (uint8_t*)data);
+    if(sd_sector_cache == NULL) return;
+    sector_cache_put(sd_sector_cache, address, (uint8_t*)data);
 }
 
 static inline void sd_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
-    sector_cache_invalidate_range(start_sector, end_sector);
+    if(sd_sector_cache == NULL) return;
+    sector_cache_invalidate_range(sd_sector_cache, start_sector, end_sector);
 }
 
 static inline void sd_cache_invalidate_all(void) {
-    sector_cache_init();
+    sd_cache_init();
 }
 
 static FuriStatus sd_device_read(uint32_t* buff, uint32_t sector, uint32_t count) {
@@ -954,7 +980,7 @@ FuriStatus furi_hal_sd_init(bool power_reset) {
     furi_hal_spi_release(&furi_hal_spi_bus_handle_sd_slow);
 
     // Init sector cache
-    sector_cache_init();
+    sd_cache_init();
 
     return status;
 }
@@ -971,6 +997,22 @@ FuriStatus furi_hal_sd_get_card_state(void) {
     return status;
 }
 
+static bool sd_cache_read_ahead(uint32_t* buff, uint32_t sector) {
+    if(sd_sector_cache == NULL) return false;
+
+    uint32_t count = sector_cache_readahead_count(sd_sector_cache, sector);
+    uint8_t* readahead_buff = sector_cache_get_readahead_buffer(sd_sector_cache);
+    if(count < 2 || readahead_buff == NULL) return false;
+
+    // Past the end of the card the read fails and the regular single sector read takes over
+    if(sd_device_read((uint32_t*)readahead_buff, sector, count) != FuriStatusOk) return false;
+
+    sector_cache_put_readahead(sd_sector_cache, sector, count);
+    memcpy(buff, readahead_buff, SD_BLOCK_SIZE);
+
+    return true;
+}
+
 FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t count) {
     furi_check(buff);
 
@@ -981,6 +1023,9 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
         if(sd_cache_get(sector, buff)) {
             return FuriStatusOk;
         }
+        if(sd_cache_read_ahead(buff, sector)) {
+            return FuriStatusOk;
+        }
     }
 
     status = sd_device_read(buff, sector, count);
@@ -1040,6 +1085,29 @@ FuriStatus furi_hal_sd_write_blocks(const uint32_t* buff, uint32_t sector, uint3
     return status;
 }
 
+void furi_hal_sd_cache_pin_range(uint32_t start_sector, uint32_t end_sector) {
+    if(sd_sector_cache == NULL) return;
+    sector_cache_pin_range(sd_sector_cache, start_sector, end_sector);
+}
+
+void furi_hal_sd_cache_get_stats(FuriHalSdCacheStats* stats) {
+    furi_check(stats);
+
+    // Counters are updated by the storage thread, copy them without being preempted by it
+    SectorCacheStats cache_stats = {};
+    FURI_CRITICAL_ENTER();
+    if(sd_sector_cache != NULL) {
+        sector_cache_get_stats(sd_sector_cache, &cache_stats);
+    }
+    FURI_CRITICAL_EXIT();
+
+    stats->hits = cache_stats.hits;
+    stats->misses = cache_stats.misses;
+    stats->evictions = cache_stats.evictions;
+    stats->readahead = cache_stats.readahead;
+    stats->capacity = cache_stats.capacity;
+}
+
 FuriStatus furi_hal_sd_info(FuriHalSdInfo* info) {
     furi_check(info);
 
@@ -26,6 +26,14 @@ typedef struct {
     uint16_t manufacturing_year; /*!< manufacturing year */
 } FuriHalSdInfo;
 
+typedef struct {
+    uint32_t hits; /*!< single sector reads served from the cache */
+    uint32_t misses; /*!< single sector reads that went to the card */
+    uint32_t evictions; /*!< sectors dropped to make room for others */
+    uint32_t readahead; /*!< sectors fetched ahead of sequential reads */
+    uint32_t capacity; /*!< cache size in sectors */
+} FuriHalSdCacheStats;
+
 /** 
  * @brief Init SD card presence detection
  */
@@ -81,6 +89,19 @@ FuriStatus furi_hal_sd_info(FuriHalSdInfo* info);
  */
 FuriStatus furi_hal_sd_get_card_state(void);
 
+/**
+ * @brief Keep sectors of given range in the sector cache in favour of others
+ * @param start_sector first sector of the range
+ * @param end_sector last sector of the range
+ */
+void furi_hal_sd_cache_pin_range(uint32_t start_sector, uint32_t end_sector);
+
+/**
+ * @brief Get sector cache statistics
+ * @param stats pointer to the statistics to fill
+ */
+void furi_hal_sd_cache_get_stats(FuriHalSdCacheStats* stats);
+
 #ifdef __cplusplus
 }
 #endif